@@ -20,13 +20,13 @@ clean-local:
 	@rm -f libtool.bak
 
 # Force header generation before any compilation
-$(shared_objects_valkey_glide): include/glide_bindings.h cluster_scan_cursor_arginfo.h valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h logger_arginfo.h src/client_constructor_mock_arginfo.h valkey-glide/ffi/target/release/libglide_ffi.a
+$(shared_objects_valkey_glide): include/glide_bindings.h cluster_scan_cursor_arginfo.h valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h logger_arginfo.h src/client_constructor_mock_arginfo.h src/bench_harness_arginfo.h valkey_glide_stream_consumer_arginfo.h valkey_glide_hash_chunks_arginfo.h valkey_glide_script_arginfo.h valkey_glide_function_arginfo.h valkey-glide/ffi/target/release/libglide_ffi.a
 
 # Ensure protobuf files exist before compiling object files that need them
 src/command_request.lo src/connection_request.lo src/response.lo: include/glide_bindings.h
 
 # Backward compatibility alias
-build-modules-pre: include/glide_bindings.h cluster_scan_cursor_arginfo.h valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h logger_arginfo.h src/client_constructor_mock_arginfo.h valkey-glide/ffi/target/release/libglide_ffi.a
+build-modules-pre: include/glide_bindings.h cluster_scan_cursor_arginfo.h valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h logger_arginfo.h src/client_constructor_mock_arginfo.h src/bench_harness_arginfo.h valkey_glide_stream_consumer_arginfo.h valkey_glide_hash_chunks_arginfo.h valkey_glide_script_arginfo.h valkey_glide_function_arginfo.h valkey-glide/ffi/target/release/libglide_ffi.a
 
 # Debug what files exist
 debug-files:
@@ -68,6 +68,21 @@ logger_arginfo.h: logger.stub.php
 src/client_constructor_mock_arginfo.h: src/client_constructor_mock.stub.php
 	@php -f $(top_srcdir)/build/gen_stub.php src/client_constructor_mock.stub.php || echo "client_constructor_mock arginfo generation failed"
 
+src/bench_harness_arginfo.h: src/bench_harness.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php src/bench_harness.stub.php || echo "bench_harness arginfo generation failed"
+
+valkey_glide_stream_consumer_arginfo.h: valkey_glide_stream_consumer.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_stream_consumer.stub.php || echo "valkey_glide_stream_consumer arginfo generation failed"
+
+valkey_glide_hash_chunks_arginfo.h: valkey_glide_hash_chunks.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_hash_chunks.stub.php || echo "valkey_glide_hash_chunks arginfo generation failed"
+
+valkey_glide_script_arginfo.h: valkey_glide_script.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_script.stub.php || echo "valkey_glide_script arginfo generation failed"
+
+valkey_glide_function_arginfo.h: valkey_glide_function.stub.php
+	@php -f $(top_srcdir)/build/gen_stub.php valkey_glide_function.stub.php || echo "valkey_glide_function arginfo generation failed"
+
 valkey-glide/ffi/target/release/libglide_ffi.a: ensure-submodules
 	@echo "=== BUILDING FFI LIBRARY ==="
 	@if [ ! -f valkey-glide/ffi/target/release/libglide_ffi.a ]; then \
@@ -168,6 +183,47 @@ include/glide_bindings.h: valkey-glide/ffi/target/release/libglide_ffi.a ensure-
 	fi
 	@echo "=== HEADER GENERATION COMPLETE ==="
 
+# Instructions per command, measured with perf stat against a local server. A run with no
+# commands is subtracted to remove startup and connection costs. Compare builds configured
+# with different --with-valkey-glide-log-level values, optionally with
+# VALKEY_GLIDE_BENCH_LOG_LEVEL=debug to measure the runtime-enabled cost as well.
+BENCH_COMMANDS ?= 100000
+BENCH_HOST ?= localhost
+BENCH_PORT ?= 6379
+
+bench-perf:
+	@if ! command -v perf >/dev/null 2>&1; then \
+		echo "❌ ERROR: perf not found"; \
+		exit 1; \
+	fi
+	@if [ ! -f "$(CURDIR)/modules/valkey_glide.so" ]; then \
+		echo "❌ ERROR: Extension not found at $(CURDIR)/modules/valkey_glide.so"; \
+		echo "Please build the extension first with: make"; \
+		exit 1; \
+	fi
+	@for n in 0 $(BENCH_COMMANDS); do \
+		perf stat -x, -e instructions -o .bench-perf-$$n.csv \
+			php -n -d extension=./modules/valkey_glide.so benchmarks/perf_commands.php \
+			$$n $(BENCH_HOST) $(BENCH_PORT) >/dev/null || exit 1; \
+	done; \
+	base=$$(awk -F, '/instructions/ {print $$1}' .bench-perf-0.csv); \
+	total=$$(awk -F, '/instructions/ {print $$1}' .bench-perf-$(BENCH_COMMANDS).csv); \
+	rm -f .bench-perf-*.csv; \
+	echo "Log level compiled in: $$(grep -o 'VALKEY_GLIDE_LOG_COMPILE_LEVEL=[-0-9]*' Makefile | head -1)"; \
+	echo "Instructions per command: $$(( (total - base) / $(BENCH_COMMANDS) ))"
+
+# C micro-benchmarks of argument marshalling, reply conversion and batch buffering. No server
+# is needed; pass BENCH_ARGS (e.g. "--elements=1000 --json") to change the workload.
+BENCH_ARGS ?=
+
+bench:
+	@if [ ! -f "$(CURDIR)/modules/valkey_glide.so" ]; then \
+		echo "❌ ERROR: Extension not found at $(CURDIR)/modules/valkey_glide.so"; \
+		echo "Please build the extension first with: make"; \
+		exit 1; \
+	fi
+	@php -n -d extension=./modules/valkey_glide.so benchmarks/bench.php $(BENCH_ARGS)
+
 # Override generated test target
 test:
 	@echo "Running ValkeyGlide tests..."
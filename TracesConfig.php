@@ -11,6 +11,9 @@ class TracesConfig
 {
     private string $endpoint;
     private int $samplePercentage;
+    /** @var array<string, float> */
+    private array $commandSamplePercentages;
+    private int $slowCommandThresholdUs;
 
     /**
      * Creates a new TracesConfig from a builder.
@@ -21,6 +24,8 @@ class TracesConfig
     {
         $this->endpoint = $builder->getEndpoint();
         $this->samplePercentage = $builder->getSamplePercentage();
+        $this->commandSamplePercentages = $builder->getCommandSamplePercentages();
+        $this->slowCommandThresholdUs = $builder->getSlowCommandThresholdUs();
     }
 
     /**
@@ -52,4 +57,24 @@ class TracesConfig
     {
         return $this->samplePercentage;
     }
+
+    /**
+     * Gets the per-command sample percentages.
+     *
+     * @return array<string, float> Method name => sample percentage (0-100).
+     */
+    public function getCommandSamplePercentages(): array
+    {
+        return $this->commandSamplePercentages;
+    }
+
+    /**
+     * Gets the tail sampling threshold.
+     *
+     * @return int Commands slower than this many microseconds are always traced, 0 if disabled.
+     */
+    public function getSlowCommandThresholdUs(): int
+    {
+        return $this->slowCommandThresholdUs;
+    }
 }
@@ -13,6 +13,9 @@ class TracesConfigBuilder
 {
     private ?string $endpoint = null;
     private int $samplePercentage = 1; // Default value
+    /** @var array<string, float> */
+    private array $commandSamplePercentages = [];
+    private int $slowCommandThresholdUs = 0; // Disabled
 
     /**
      * Sets the endpoint.
@@ -44,6 +47,49 @@ class TracesConfigBuilder
         return $this;
     }
 
+    /**
+     * Sets the sample percentage of one command, overriding samplePercentage() for it.
+     *
+     * Commands are named after the client method that issues them (e.g. "get", "hGetAll",
+     * "ValkeyGlideScript::run"), case-insensitively, so methods sending the same request type
+     * (setex() and set(), eval() and rawCommand()) are sampled separately. Fractional rates
+     * such as 0.1 are allowed.
+     *
+     * @param string $command The command (method) name.
+     * @param float $samplePercentage The sample percentage (0-100).
+     * @return self This builder instance for method chaining.
+     */
+    public function commandSamplePercentage(string $command, float $samplePercentage): self
+    {
+        if ($command === '' || strlen($command) >= 64) {
+            throw new ValkeyGlideException("Command name must be between 1 and 63 characters");
+        }
+        if ($samplePercentage < 0 || $samplePercentage > 100) {
+            throw new ValkeyGlideException("Sample percentage must be between 0 and 100");
+        }
+        $this->commandSamplePercentages[$command] = $samplePercentage;
+        return $this;
+    }
+
+    /**
+     * Sets the tail sampling threshold.
+     *
+     * A command that was not sampled but took longer than the threshold is still reported,
+     * as a "slow <command>" span. The duration is written to the debug log, since spans
+     * cannot carry it.
+     *
+     * @param int $thresholdUs The threshold in microseconds, 0 to disable.
+     * @return self This builder instance for method chaining.
+     */
+    public function slowCommandThresholdUs(int $thresholdUs): self
+    {
+        if ($thresholdUs < 0) {
+            throw new ValkeyGlideException("Slow command threshold cannot be negative");
+        }
+        $this->slowCommandThresholdUs = $thresholdUs;
+        return $this;
+    }
+
     /**
      * Gets the endpoint.
      *
@@ -67,6 +113,26 @@ class TracesConfigBuilder
         return $this->samplePercentage;
     }
 
+    /**
+     * Gets the per-command sample percentages.
+     *
+     * @return array<string, float> Method name => sample percentage (0-100).
+     */
+    public function getCommandSamplePercentages(): array
+    {
+        return $this->commandSamplePercentages;
+    }
+
+    /**
+     * Gets the tail sampling threshold.
+     *
+     * @return int The threshold in microseconds, 0 if disabled.
+     */
+    public function getSlowCommandThresholdUs(): int
+    {
+        return $this->slowCommandThresholdUs;
+    }
+
     /**
      * Builds the TracesConfig.
      *
@@ -0,0 +1,49 @@
+<?php
+
+/**
+ * Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0
+ */
+
+/**
+ * Runs the C micro-benchmarks exposed by ValkeyGlideBench and prints ns/op and allocs/op for
+ * each, or JSON with --json. No server is needed.
+ *
+ * Usage: php bench.php [--iterations=N] [--elements=N] [--valueSize=N] [--depth=N]
+ *                      [--filter=substring] [--json]
+ */
+
+declare(strict_types=1);
+
+$opts = getopt('', ['iterations:', 'elements:', 'valueSize:', 'depth:', 'filter:', 'json']);
+
+$iterations = (int)($opts['iterations'] ?? 100_000);
+$options = [
+    'elements' => (int)($opts['elements'] ?? 10),
+    'value_size' => (int)($opts['valueSize'] ?? 16),
+    'depth' => (int)($opts['depth'] ?? 16),
+];
+$filter = $opts['filter'] ?? '';
+
+$results = [];
+foreach (ValkeyGlideBench::names() as $name) {
+    if ($filter !== '' && !str_contains($name, $filter)) {
+        continue;
+    }
+    $results[] = ValkeyGlideBench::run($name, $iterations, $options) + ['options' => $options];
+}
+
+if (isset($opts['json'])) {
+    echo json_encode($results, JSON_PRETTY_PRINT), PHP_EOL;
+    exit(0);
+}
+
+printf("%-20s %12s %14s %14s\n", 'benchmark', 'ns/op', 'allocs/op', 'bytes/op');
+foreach ($results as $result) {
+    printf(
+        "%-20s %12.1f %14s %14s\n",
+        $result['name'],
+        $result['ns_per_op'],
+        $result['allocs_per_op'] === null ? 'n/a' : sprintf('%.2f', $result['allocs_per_op']),
+        $result['bytes_per_op'] === null ? 'n/a' : sprintf('%.1f', $result['bytes_per_op'])
+    );
+}
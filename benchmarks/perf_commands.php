@@ -0,0 +1,34 @@
+<?php
+
+/**
+ * Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0
+ */
+
+/**
+ * Issues a fixed number of GET commands so `make bench-perf` can divide the instruction
+ * count measured by `perf stat` by the number of commands.
+ *
+ * Usage: php perf_commands.php <commands> [host] [port]
+ *
+ * The runtime log level comes from VALKEY_GLIDE_BENCH_LOG_LEVEL (default "warn"), so builds
+ * configured with different --with-valkey-glide-log-level values can be compared with
+ * logging enabled or disabled at runtime.
+ */
+
+declare(strict_types=1);
+
+$commands = (int)($argv[1] ?? 100_000);
+$host = $argv[2] ?? 'localhost';
+$port = (int)($argv[3] ?? 6379);
+
+valkey_glide_logger_set_config(getenv('VALKEY_GLIDE_BENCH_LOG_LEVEL') ?: 'warn', '/dev/null');
+
+$client = new ValkeyGlide();
+$client->connect(addresses: [['host' => $host, 'port' => $port]]);
+$client->set('bench:perf:key', 'value');
+
+for ($i = 0; $i < $commands; $i++) {
+    $client->get('bench:perf:key');
+}
+
+$client->close();
@@ -0,0 +1,69 @@
+<?php
+
+/**
+ * Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0
+ */
+
+/**
+ * Subscriber side of the pubsub workload profile. Counts the messages published on a channel
+ * and their delivery latency (the publisher prefixes each message with hrtime(true), which is
+ * comparable between processes on the same host), and writes the totals as JSON once the end
+ * message arrives.
+ *
+ * Usage: php pubsub_subscriber.php <client> <host> <port> <tls> <cluster> <channel> <resultFile>
+ */
+
+declare(strict_types=1);
+
+namespace ValkeyGlide\Benchmarks;
+
+// phpcs:disable PSR1.Files.SideEffects
+require_once __DIR__ . '/utils.php';
+require_once __DIR__ . '/workloads.php';
+
+[, $clientName, $host, $port, $useTls, $isCluster, $channel, $resultFile] = $argv;
+
+$client = createClient(
+    ClientType::from($clientName),
+    $host,
+    (int)$port,
+    $useTls === '1',
+    $isCluster === '1'
+);
+
+$received = 0;
+$first = 0;
+$last = 0;
+$latencies = [];
+
+$client->subscribe([$channel], function ($client, $channel, $message) use (
+    &$received,
+    &$first,
+    &$last,
+    &$latencies,
+    $resultFile
+) {
+    $now = hrtime(true);
+
+    if ($message === PROFILE_END_MESSAGE) {
+        file_put_contents($resultFile, json_encode([
+            'received' => $received,
+            'elapsed_ns' => $last - $first,
+            'latencies' => $latencies,
+        ]));
+        $client->unsubscribe([$channel]);
+        return;
+    }
+
+    $sent = (int)strstr($message, ':', true);
+    if ($sent === 0) {
+        return; // Readiness ping
+    }
+    if ($received++ === 0) {
+        $first = $now;
+    }
+    $last = $now;
+    $latencies[] = ($now - $sent) / 1_000_000;
+});
+
+$client->close();
@@ -10,37 +10,11 @@ namespace ValkeyGlide\Benchmarks;
 
 // phpcs:disable PSR1.Files.SideEffects
 require_once __DIR__ . '/utils.php';
-
-use ValkeyGlide;
-use ValkeyGlideCluster;
-use Redis;
-use RedisCluster;
+require_once __DIR__ . '/workloads.php';
 
 // Progress reporting constants
 const PROGRESS_REPORT_INTERVAL = 100_000;  // Report progress every N operations
 
-// Time conversion constants
-const NANOSECONDS_TO_MILLISECONDS = 1_000_000;
-const NANOSECONDS_TO_SECONDS = 1_000_000_000;
-
-function convertNanosecsToSecs(int $nanoseconds): float
-{
-    return $nanoseconds / NANOSECONDS_TO_SECONDS;
-}
-
-function convertNanosecsToMillisecs(int $nanoseconds): float
-{
-    return $nanoseconds / NANOSECONDS_TO_MILLISECONDS;
-}
-
-enum ClientType: string
-{
-    case GLIDE = 'glide';
-    case GLIDE_COMPRESSED = 'glide-compressed';
-    case PHPREDIS = 'phpredis';
-    case ALL = 'all';
-}
-
 function prePopulateDatabase(object $client, int $dataSize): void
 {
     echo "Pre-populating database with " . number_format(SIZE_SET_KEYSPACE) . " keys...\n";
@@ -63,52 +37,18 @@ function prePopulateDatabase(object $client, int $dataSize): void
     echo "Pre-population completed in " . round($elapsed, 2) . " seconds\n\n";
 }
 
-function createClient(
-    ClientType $clientType,
-    string $host,
-    int $port,
-    bool $useTls,
-    bool $isCluster
-): object {
-    if ($clientType === ClientType::GLIDE || $clientType === ClientType::GLIDE_COMPRESSED) {
-        $compression = $clientType === ClientType::GLIDE_COMPRESSED
-            ? ['backend' => ValkeyGlide::COMPRESSION_BACKEND_ZSTD]
-            : null;
-        $advancedConfig = $useTls ? ['tls_config' => ['use_insecure_tls' => true]] : null;
-        if ($isCluster) {
-            return new ValkeyGlideCluster(
-                addresses: [['host' => $host, 'port' => $port]],
-                use_tls: $useTls,
-                advanced_config: $advancedConfig,
-                compression: $compression
-            );
-        } else {
-            $client = new ValkeyGlide();
-            $client->connect(
-                addresses: [['host' => $host, 'port' => $port]],
-                use_tls: $useTls,
-                advanced_config: $advancedConfig,
-                compression: $compression
-            );
-            return $client;
-        }
-    } else {
-        if ($isCluster) {
-            $client = new RedisCluster(null, ["{$host}:{$port}"]);
-            if ($useTls) {
-                $client->setOption(Redis::OPT_SSL_CONTEXT, ['verify_peer' => false]);
-            }
-            return $client;
-        } else {
-            $client = new Redis();
-            if ($useTls) {
-                $client->connect($host, $port);
-                $client->setOption(Redis::OPT_SSL_CONTEXT, ['verify_peer' => false]);
-            } else {
-                $client->connect($host, $port);
-            }
-            return $client;
-        }
+function runAction(object $client, ChosenAction $action, string $value): void
+{
+    switch ($action) {
+        case ChosenAction::GET_EXISTING:
+            $client->get(generateKeySet());
+            break;
+        case ChosenAction::GET_NON_EXISTING:
+            $client->get(generateKeyGet());
+            break;
+        case ChosenAction::SET:
+            $client->set(generateKeySet(), $value);
+            break;
     }
 }
 
@@ -131,19 +71,7 @@ function runBenchmarkOperations(
         $action = chooseAction();
 
         $start = hrtime(true);
-
-        switch ($action) {
-            case ChosenAction::GET_EXISTING:
-                $client->get(generateKeySet());
-                break;
-            case ChosenAction::GET_NON_EXISTING:
-                $client->get(generateKeyGet());
-                break;
-            case ChosenAction::SET:
-                $client->set(generateKeySet(), $value);
-                break;
-        }
-
+        runAction($client, $action, $value);
         $end = hrtime(true);
         $latencyMs = convertNanosecsToMillisecs($end - $start);  // Convert nanoseconds to milliseconds
         $actionLatencies[$action->value][] = $latencyMs;  // Store full precision for accurate statistics
@@ -188,10 +116,14 @@ function runBenchmarkSequential(
     int $port,
     bool $useTls,
     bool $isCluster,
-    ClientType $clientType
+    ClientType $clientType,
+    bool $allocStats = false
 ): array {
-    $client = createClient($clientType, $host, $port, $useTls, $isCluster);
+    $client = createClient($clientType, $host, $port, $useTls, $isCluster, $allocStats);
     $result = runBenchmarkProcess($client, $totalCommands, $dataSize);
+    if ($allocStats && method_exists($client, 'getAllocStats')) {
+        $result['alloc_stats'] = $client->getAllocStats();
+    }
     $client->close();
 
     return $result;
@@ -205,7 +137,8 @@ function runClient(
     string $host,
     int $port,
     bool $useTls,
-    bool $skipPrePopulation = false
+    bool $skipPrePopulation = false,
+    bool $allocStats = false
 ): array {
     $clientName = $clientType->value;
     $now = date('H:i:s');
@@ -224,7 +157,8 @@ function runClient(
         $port,
         $useTls,
         $isCluster,
-        $clientType
+        $clientType,
+        $allocStats
     );
 
     $time = $result['time'];
@@ -248,65 +182,250 @@ function runClient(
         ],
         $getExistingResults,
         $getNonExistingResults,
-        $setResults
+        $setResults,
+        isset($result['alloc_stats']) ? ['alloc_stats' => $result['alloc_stats']] : []
     );
 }
 
-function main(
+/**
+ * Worker side of --concurrency: the mixed workload recorded into one histogram per action.
+ */
+function runWorkerOperations(object $client, int $totalCommands, int $dataSize): array
+{
+    $histograms = [
+        ChosenAction::GET_NON_EXISTING->value => histogramCreate(),
+        ChosenAction::GET_EXISTING->value => histogramCreate(),
+        ChosenAction::SET->value => histogramCreate(),
+    ];
+    $value = generateValue($dataSize);
+
+    for ($i = 0; $i < $totalCommands; $i++) {
+        $action = chooseAction();
+        $start = hrtime(true);
+        runAction($client, $action, $value);
+        histogramRecord($histograms[$action->value], hrtime(true) - $start);
+    }
+
+    return $histograms;
+}
+
+/**
+ * Run $work in a child process and wait for it. Glide clients must not exist in the parent
+ * when it forks, because the forked copy of the Tokio runtime is unusable.
+ */
+function runInChild(callable $work): void
+{
+    $pid = pcntl_fork();
+    if ($pid === -1) {
+        echo "Error: pcntl_fork() failed\n";
+        exit(1);
+    }
+    if ($pid === 0) {
+        $work();
+        exit(0);
+    }
+    pcntl_waitpid($pid, $status);
+}
+
+/**
+ * Fork $workers processes that each connect, wait for every other worker to be connected and
+ * then share $totalCommands between them. Workers send back histograms, not samples.
+ */
+function runBenchmarkConcurrent(
+    int $workers,
     int $totalCommands,
     int $dataSize,
-    ClientType $clientsToRun,
     string $host,
+    int $port,
     bool $useTls,
     bool $isCluster,
+    ClientType $clientType
+): array {
+    $children = [];
+
+    for ($w = 0; $w < $workers; $w++) {
+        [$parentEnd, $childEnd] = stream_socket_pair(STREAM_PF_UNIX, STREAM_SOCK_STREAM, STREAM_IPPROTO_IP);
+        $pid = pcntl_fork();
+        if ($pid === -1) {
+            echo "Error: pcntl_fork() failed after {$w} workers\n";
+            exit(1);
+        }
+        if ($pid === 0) {
+            fclose($parentEnd);
+            mt_srand(); // Every worker would otherwise draw the same action sequence
+            $commands = intdiv($totalCommands, $workers) + ($w < $totalCommands % $workers ? 1 : 0);
+            $client = createClient($clientType, $host, $port, $useTls, $isCluster);
+            fwrite($childEnd, 'R');
+            fread($childEnd, 1);
+            $histograms = runWorkerOperations($client, $commands, $dataSize);
+            $client->close();
+            fwrite($childEnd, json_encode($histograms));
+            fclose($childEnd);
+            exit(0);
+        }
+        fclose($childEnd);
+        $children[$pid] = $parentEnd;
+    }
+
+    // Start every worker at once, after all of them are connected
+    foreach ($children as $socket) {
+        fread($socket, 1);
+    }
+    $start = hrtime(true);
+    foreach ($children as $socket) {
+        fwrite($socket, 'G');
+    }
+
+    $histograms = [
+        ChosenAction::GET_NON_EXISTING->value => histogramCreate(),
+        ChosenAction::GET_EXISTING->value => histogramCreate(),
+        ChosenAction::SET->value => histogramCreate(),
+    ];
+    $operationsCompleted = 0;
+    foreach ($children as $pid => $socket) {
+        $result = json_decode((string)stream_get_contents($socket), true);
+        fclose($socket);
+        pcntl_waitpid($pid, $status);
+        if (!is_array($result)) {
+            echo "  Warning: worker {$pid} exited without results\n";
+            continue;
+        }
+        foreach ($result as $action => $histogram) {
+            histogramMerge($histograms[$action], $histogram);
+            $operationsCompleted += $histogram['count'];
+        }
+    }
+
+    return [
+        'time' => convertNanosecsToSecs(hrtime(true) - $start),
+        'histograms' => $histograms,
+        'operations_completed' => $operationsCompleted,
+    ];
+}
+
+/**
+ * Run the mixed workload at every concurrency level. Scaling efficiency is the throughput
+ * relative to one worker times the number of workers; the marginal efficiency is the same
+ * ratio for the workers added since the previous level.
+ */
+function runClientConcurrent(
+    ClientType $clientType,
+    array $concurrencyLevels,
+    int $totalCommands,
+    int $dataSize,
+    bool $isCluster,
+    string $host,
     int $port,
-    array &$benchResults
-): void {
-    // Run phpredis benchmark
-    if ($clientsToRun === ClientType::ALL || $clientsToRun === ClientType::PHPREDIS) {
-        $result = runClient(
-            ClientType::PHPREDIS,
-            $totalCommands,
-            $dataSize,
-            $isCluster,
-            $host,
-            $port,
-            $useTls,
-            false  // skipPrePopulation = false (DO pre-populate)
-        );
-        $benchResults[] = $result;
+    bool $useTls,
+    bool $skipPrePopulation = false
+): array {
+    $results = [];
+    $baselineTps = null;
+    $previous = null;
+
+    if (!$skipPrePopulation) {
+        runInChild(function () use ($clientType, $host, $port, $useTls, $isCluster, $dataSize) {
+            $client = createClient($clientType, $host, $port, $useTls, $isCluster);
+            prePopulateDatabase($client, $dataSize);
+            $client->close();
+        });
     }
 
-    // Run ValkeyGlide benchmark
-    if ($clientsToRun === ClientType::ALL || $clientsToRun === ClientType::GLIDE) {
-        $skipPrePopulation = $clientsToRun === ClientType::ALL;  // Skip if phpredis already pre-populated
-        $result = runClient(
-            ClientType::GLIDE,
+    foreach ($concurrencyLevels as $workers) {
+        $now = date('H:i:s');
+        echo "Starting {$clientType->value} | workers: {$workers} | iterations: {$totalCommands} | {$now}\n";
+
+        $result = runBenchmarkConcurrent(
+            $workers,
             $totalCommands,
             $dataSize,
-            $isCluster,
             $host,
             $port,
             $useTls,
-            $skipPrePopulation
+            $isCluster,
+            $clientType
+        );
+        $tps = $result['operations_completed'] / $result['time'];
+        $baselineTps ??= $tps / $workers;
+        $efficiency = $tps / ($workers * $baselineTps);
+        $marginal = $previous === null
+            ? $efficiency
+            : ($tps - $previous['tps']) / (($workers - $previous['workers']) * $baselineTps);
+        $previous = ['tps' => $tps, 'workers' => $workers];
+
+        printf(
+            "  TPS: %s | scaling efficiency: %.1f%% | marginal efficiency: %.1f%%\n",
+            number_format((int)$tps),
+            $efficiency * 100,
+            $marginal * 100
         );
-        $benchResults[] = $result;
-    }
 
-    // Run ValkeyGlide with compression benchmark
-    if ($clientsToRun === ClientType::ALL || $clientsToRun === ClientType::GLIDE_COMPRESSED) {
-        $skipPrePopulation = $clientsToRun === ClientType::ALL;  // Skip if already pre-populated
-        $result = runClient(
-            ClientType::GLIDE_COMPRESSED,
-            $totalCommands,
-            $dataSize,
-            $isCluster,
-            $host,
-            $port,
-            $useTls,
-            $skipPrePopulation
+        $histograms = $result['histograms'];
+        $results[] = array_merge(
+            [
+                'client' => $clientType->value,
+                'num_of_tasks' => $workers,
+                'data_size' => $dataSize,
+                'tps' => (int)$tps,
+                'client_count' => $workers,
+                'is_cluster' => $isCluster,
+                'scaling_efficiency' => round($efficiency, 3),
+                'marginal_efficiency' => round($marginal, 3),
+            ],
+            histogramResults('get_existing', $histograms[ChosenAction::GET_EXISTING->value]),
+            histogramResults('get_non_existing', $histograms[ChosenAction::GET_NON_EXISTING->value]),
+            histogramResults('set', $histograms[ChosenAction::SET->value])
         );
-        $benchResults[] = $result;
+    }
+
+    return $results;
+}
+
+function main(
+    int $totalCommands,
+    int $dataSize,
+    ClientType $clientsToRun,
+    string $host,
+    bool $useTls,
+    bool $isCluster,
+    int $port,
+    array &$benchResults,
+    array $concurrencyLevels = [],
+    bool $allocStats = false
+): void {
+    $clientTypes = $clientsToRun === ClientType::ALL
+        ? [ClientType::PHPREDIS, ClientType::GLIDE, ClientType::GLIDE_COMPRESSED]
+        : [$clientsToRun];
+
+    // The first client pre-populates the database, the others reuse it
+    $skipPrePopulation = false;
+    foreach ($clientTypes as $clientType) {
+        if ($concurrencyLevels) {
+            array_push($benchResults, ...runClientConcurrent(
+                $clientType,
+                $concurrencyLevels,
+                $totalCommands,
+                $dataSize,
+                $isCluster,
+                $host,
+                $port,
+                $useTls,
+                $skipPrePopulation
+            ));
+        } else {
+            $benchResults[] = runClient(
+                $clientType,
+                $totalCommands,
+                $dataSize,
+                $isCluster,
+                $host,
+                $port,
+                $useTls,
+                $skipPrePopulation,
+                $allocStats
+            );
+        }
+        $skipPrePopulation = true;
     }
 }
 
@@ -326,6 +445,59 @@ $useTls = $args['tls'];
 $port = $args['port'];
 $isCluster = $args['clusterModeEnabled'];
 
+if ($args['profile'] !== 'mixed') {
+    $profiles = $args['profile'] === 'all'
+        ? WorkloadProfile::cases()
+        : array_map(fn($name) => WorkloadProfile::tryFrom($name), explode(',', $args['profile']));
+    if (in_array(null, $profiles, true)) {
+        $valid = implode(', ', array_map(fn($profile) => $profile->value, WorkloadProfile::cases()));
+        echo "Error: Invalid profile '{$args['profile']}'. Valid options: mixed, all, {$valid}\n";
+        exit(1);
+    }
+    $clientTypes = $clientsToRun === ClientType::ALL
+        ? [ClientType::PHPREDIS, ClientType::GLIDE, ClientType::GLIDE_COMPRESSED]
+        : [$clientsToRun];
+    $connection = [
+        'host' => $host,
+        'port' => $port,
+        'tls' => $useTls,
+        'cluster' => $isCluster,
+        'alloc_stats' => $args['allocStats'],
+    ];
+
+    foreach ($profiles as $profile) {
+        foreach ($clientTypes as $clientType) {
+            array_push($benchResults, ...runProfile(
+                $profile,
+                $clientType,
+                $connection,
+                $dataSize,
+                $args['profileOps'],
+                $args['profileSeconds']
+            ));
+        }
+    }
+
+    processResults($benchResults, $args['resultsFile'], generateProfileMarkdownReport(...));
+    echo "Results written to {$args['resultsFile']}\n";
+    exit(0);
+}
+
+$concurrencyLevels = array_map('intval', $args['concurrency']);
+if ($concurrencyLevels) {
+    if (!function_exists('pcntl_fork')) {
+        echo "Error: --concurrency needs the pcntl extension\n";
+        exit(1);
+    }
+    if (min($concurrencyLevels) < 1) {
+        echo "Error: --concurrency levels must be at least 1\n";
+        exit(1);
+    }
+    // One worker is the baseline for the scaling efficiency
+    $concurrencyLevels = array_unique([1, ...$concurrencyLevels]);
+    sort($concurrencyLevels);
+}
+
 $productOfArguments = [];
 foreach ($iterationsList as $iterations) {
     $iterations = validateIterations((int)$iterations);
@@ -341,7 +513,9 @@ foreach ($productOfArguments as [$dataSize, $totalIterations]) {
         $useTls,
         $isCluster,
         $port,
-        $benchResults
+        $benchResults,
+        $concurrencyLevels,
+        $args['allocStats']
     );
 }
 
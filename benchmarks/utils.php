@@ -8,6 +8,11 @@ declare(strict_types=1);
 
 namespace ValkeyGlide\Benchmarks;
 
+use ValkeyGlide;
+use ValkeyGlideCluster;
+use Redis;
+use RedisCluster;
+
 const DEFAULT_PORT = 6379;
 const DEFAULT_HOST = 'localhost';
 const PROB_GET_EXISTING = 0.64;
@@ -23,6 +28,26 @@ const MAX_ITERATIONS = 5_000_000;     // Maximum iterations cap
 // Default benchmark configuration
 const DEFAULT_DATA_SIZE = 100;           // Default value size in bytes
 const DEFAULT_ITERATIONS = ['100_000', '1_000_000', '5_000_000'];
+const DEFAULT_PROFILE_OPS = 10_000;      // Operations per workload profile size
+const DEFAULT_PROFILE_SECONDS = 10;      // Time limit per workload profile size
+
+// Latency histogram resolution
+const HISTOGRAM_SUB_BUCKET_BITS = 5;
+const HISTOGRAM_SUB_BUCKETS = 1 << HISTOGRAM_SUB_BUCKET_BITS;
+
+// Time conversion constants
+const NANOSECONDS_TO_MILLISECONDS = 1_000_000;
+const NANOSECONDS_TO_SECONDS = 1_000_000_000;
+
+function convertNanosecsToSecs(int $nanoseconds): float
+{
+    return $nanoseconds / NANOSECONDS_TO_SECONDS;
+}
+
+function convertNanosecsToMillisecs(int $nanoseconds): float
+{
+    return $nanoseconds / NANOSECONDS_TO_MILLISECONDS;
+}
 
 enum ChosenAction: int
 {
@@ -31,6 +56,14 @@ enum ChosenAction: int
     case SET = 3;
 }
 
+enum ClientType: string
+{
+    case GLIDE = 'glide';
+    case GLIDE_COMPRESSED = 'glide-compressed';
+    case PHPREDIS = 'phpredis';
+    case ALL = 'all';
+}
+
 function parseArguments(): array
 {
     $options = getopt('', [
@@ -43,6 +76,11 @@ function parseArguments(): array
         'clusterModeEnabled',
         'port::',
         'iterations::',
+        'profile::',
+        'profileOps::',
+        'profileSeconds::',
+        'concurrency::',
+        'allocStats',
     ]);
 
     return [
@@ -54,9 +92,68 @@ function parseArguments(): array
         'clusterModeEnabled' => isset($options['clusterModeEnabled']),
         'port' => (int)($options['port'] ?? DEFAULT_PORT),
         'iterations' => isset($options['iterations']) ? explode(',', $options['iterations']) : DEFAULT_ITERATIONS,
+        'profile' => $options['profile'] ?? 'mixed',
+        'profileOps' => (int)($options['profileOps'] ?? DEFAULT_PROFILE_OPS),
+        'profileSeconds' => (float)($options['profileSeconds'] ?? DEFAULT_PROFILE_SECONDS),
+        'concurrency' => isset($options['concurrency']) ? explode(',', $options['concurrency']) : [],
+        'allocStats' => isset($options['allocStats']),
     ];
 }
 
+function createClient(
+    ClientType $clientType,
+    string $host,
+    int $port,
+    bool $useTls,
+    bool $isCluster,
+    bool $allocStats = false
+): object {
+    if ($clientType === ClientType::GLIDE || $clientType === ClientType::GLIDE_COMPRESSED) {
+        $compression = $clientType === ClientType::GLIDE_COMPRESSED
+            ? ['backend' => ValkeyGlide::COMPRESSION_BACKEND_ZSTD]
+            : null;
+        $advancedConfig = $useTls ? ['tls_config' => ['use_insecure_tls' => true]] : [];
+        if ($allocStats) {
+            $advancedConfig['alloc_stats'] = true;
+        }
+        $advancedConfig = $advancedConfig ?: null;
+        if ($isCluster) {
+            return new ValkeyGlideCluster(
+                addresses: [['host' => $host, 'port' => $port]],
+                use_tls: $useTls,
+                advanced_config: $advancedConfig,
+                compression: $compression
+            );
+        } else {
+            $client = new ValkeyGlide();
+            $client->connect(
+                addresses: [['host' => $host, 'port' => $port]],
+                use_tls: $useTls,
+                advanced_config: $advancedConfig,
+                compression: $compression
+            );
+            return $client;
+        }
+    } else {
+        if ($isCluster) {
+            $client = new RedisCluster(null, ["{$host}:{$port}"]);
+            if ($useTls) {
+                $client->setOption(Redis::OPT_SSL_CONTEXT, ['verify_peer' => false]);
+            }
+            return $client;
+        } else {
+            $client = new Redis();
+            if ($useTls) {
+                $client->connect($host, $port);
+                $client->setOption(Redis::OPT_SSL_CONTEXT, ['verify_peer' => false]);
+            } else {
+                $client->connect($host, $port);
+            }
+            return $client;
+        }
+    }
+}
+
 function generateValue(int $size): string
 {
     return str_repeat('0', $size);
@@ -127,6 +224,98 @@ function latencyResults(string $prefix, array $latencies): array
     ];
 }
 
+/**
+ * Latency histogram with 32 buckets per power of two (about 3% resolution), so workers can
+ * report percentiles without shipping raw samples to the parent process.
+ */
+function histogramCreate(): array
+{
+    return ['counts' => [], 'count' => 0, 'sum' => 0.0, 'sum_sq' => 0.0];
+}
+
+function histogramBucket(int $nanoseconds): int
+{
+    if ($nanoseconds < 2 * HISTOGRAM_SUB_BUCKETS) {
+        return max(0, $nanoseconds);
+    }
+    $shift = (int)floor(log($nanoseconds, 2)) - HISTOGRAM_SUB_BUCKET_BITS;
+    while (($nanoseconds >> $shift) >= 2 * HISTOGRAM_SUB_BUCKETS) {
+        $shift++;
+    }
+    while (($nanoseconds >> $shift) < HISTOGRAM_SUB_BUCKETS) {
+        $shift--;
+    }
+    return $shift * HISTOGRAM_SUB_BUCKETS + ($nanoseconds >> $shift);
+}
+
+/**
+ * Midpoint, in nanoseconds, of the values counted in a bucket.
+ */
+function histogramBucketValue(int $bucket): float
+{
+    if ($bucket < 2 * HISTOGRAM_SUB_BUCKETS) {
+        return (float)$bucket;
+    }
+    $shift = intdiv($bucket, HISTOGRAM_SUB_BUCKETS) - 1;
+    $mantissa = $bucket - $shift * HISTOGRAM_SUB_BUCKETS;
+    return ($mantissa << $shift) + (1 << $shift) / 2;
+}
+
+function histogramRecord(array &$histogram, int $nanoseconds): void
+{
+    $bucket = histogramBucket($nanoseconds);
+    $histogram['counts'][$bucket] = ($histogram['counts'][$bucket] ?? 0) + 1;
+    $histogram['count']++;
+    $histogram['sum'] += $nanoseconds;
+    $histogram['sum_sq'] += $nanoseconds * $nanoseconds;
+}
+
+function histogramMerge(array &$into, array $histogram): void
+{
+    foreach ($histogram['counts'] as $bucket => $count) {
+        $into['counts'][$bucket] = ($into['counts'][$bucket] ?? 0) + $count;
+    }
+    $into['count'] += $histogram['count'];
+    $into['sum'] += $histogram['sum'];
+    $into['sum_sq'] += $histogram['sum_sq'];
+}
+
+function histogramPercentile(array $histogram, float $percentile): float
+{
+    $rank = max(1, (int)ceil(($percentile / 100) * $histogram['count']));
+    $seen = 0;
+
+    ksort($histogram['counts']);
+    foreach ($histogram['counts'] as $bucket => $count) {
+        $seen += $count;
+        if ($seen >= $rank) {
+            return round(histogramBucketValue($bucket) / NANOSECONDS_TO_MILLISECONDS, 4);
+        }
+    }
+    return 0.0;
+}
+
+/**
+ * Same fields as latencyResults(), computed from a histogram
+ */
+function histogramResults(string $prefix, array $histogram): array
+{
+    if ($histogram['count'] === 0) {
+        return latencyResults($prefix, []);
+    }
+
+    $mean = $histogram['sum'] / $histogram['count'];
+    $variance = max(0.0, $histogram['sum_sq'] / $histogram['count'] - $mean * $mean);
+
+    return [
+        "{$prefix}_p50_latency" => histogramPercentile($histogram, 50),
+        "{$prefix}_p90_latency" => histogramPercentile($histogram, 90),
+        "{$prefix}_p99_latency" => histogramPercentile($histogram, 99),
+        "{$prefix}_average_latency" => round($mean / NANOSECONDS_TO_MILLISECONDS, 3),
+        "{$prefix}_std_dev" => round(sqrt($variance) / NANOSECONDS_TO_MILLISECONDS, 3),
+    ];
+}
+
 function validateIterations(int $iterations): int
 {
     if ($iterations < MIN_ITERATIONS) {
@@ -142,14 +331,14 @@ function validateIterations(int $iterations): int
     return $iterations;
 }
 
-function processResults(array $benchResults, string $resultsFile): void
+function processResults(array $benchResults, string $resultsFile, ?callable $markdownReport = null): void
 {
     // Write JSON results
     file_put_contents($resultsFile, json_encode($benchResults, JSON_PRETTY_PRINT));
 
     // Write Markdown results
     $mdFile = str_replace('.json', '.md', $resultsFile);
-    $markdown = generateMarkdownReport($benchResults);
+    $markdown = $markdownReport ? $markdownReport($benchResults) : generateMarkdownReport($benchResults);
     file_put_contents($mdFile, $markdown);
 }
 
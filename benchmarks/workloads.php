@@ -0,0 +1,369 @@
+<?php
+
+/**
+ * Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0
+ */
+
+declare(strict_types=1);
+
+namespace ValkeyGlide\Benchmarks;
+
+use RedisCluster;
+
+// Workload profiles selected with --profile. Each runs once per size in variants().
+const PROFILE_KEY_PREFIX = 'bench:profile:';
+const PROFILE_LOAD_CHUNK = 1_000;        // Fields/members/entries written per setup command
+const PROFILE_STREAM_LENGTH = 10_000;    // Entries the XREADGROUP profile cycles through
+const PROFILE_SUBSCRIBER_TIMEOUT = 10;   // Seconds to wait for subscribers to start and report
+const PROFILE_END_MESSAGE = '__end__';
+const PROFILE_HSCAN_CHUNK = 1_000;       // Fields per HSCAN page read by hgetall_chunked
+
+enum WorkloadProfile: string
+{
+    case PIPELINE = 'pipeline';
+    case HGETALL = 'hgetall';
+    case HGETALL_CHUNKED = 'hgetall_chunked';
+    case ZRANGE = 'zrange';
+    case XREADGROUP = 'xreadgroup';
+    case PUBSUB = 'pubsub';
+    case MGET = 'mget';
+
+    /**
+     * Sizes swept by the profile: commands per pipeline, hash fields, sorted set members,
+     * entries per read, subscribers and keys per MGET.
+     */
+    public function variants(): array
+    {
+        return match ($this) {
+            self::PIPELINE => [1, 10, 100, 1000],
+            self::HGETALL, self::HGETALL_CHUNKED => [10, 1000, 100_000],
+            self::ZRANGE => [10, 1000, 10_000],
+            self::XREADGROUP => [1, 10, 100],
+            self::PUBSUB => [1, 4],
+            self::MGET => [10, 100, 1000],
+        };
+    }
+
+    /**
+     * Load the data the profile reads and return the state its operations need.
+     */
+    public function setUp(object $client, int $size, int $dataSize, array $connection): array
+    {
+        $key = PROFILE_KEY_PREFIX . $this->value . ':' . $size;
+        $value = generateValue($dataSize);
+        $client->del($key);
+
+        switch ($this) {
+            case self::PIPELINE:
+                $keys = [];
+                for ($i = 0; $i < min($size, PROFILE_LOAD_CHUNK); $i++) {
+                    $keys[] = "{$key}:{$i}";
+                }
+                return ['keys' => $keys, 'value' => $value];
+            case self::HGETALL:
+            case self::HGETALL_CHUNKED:
+                for ($i = 0; $i < $size; $i += PROFILE_LOAD_CHUNK) {
+                    $fields = [];
+                    for ($j = $i; $j < min($size, $i + PROFILE_LOAD_CHUNK); $j++) {
+                        $fields["field:{$j}"] = $value;
+                    }
+                    $client->hMset($key, $fields);
+                }
+                return ['key' => $key];
+            case self::ZRANGE:
+                for ($i = 0; $i < $size; $i += PROFILE_LOAD_CHUNK) {
+                    $args = [];
+                    for ($j = $i; $j < min($size, $i + PROFILE_LOAD_CHUNK); $j++) {
+                        $args[] = $j;
+                        $args[] = "member:{$j}";
+                    }
+                    $client->zAdd($key, ...$args);
+                }
+                return ['key' => $key];
+            case self::XREADGROUP:
+                for ($i = 0; $i < PROFILE_STREAM_LENGTH; $i++) {
+                    $client->xAdd($key, '*', ['payload' => $value]);
+                }
+                $client->xGroup('CREATE', $key, 'bench', '0');
+                return ['key' => $key];
+            case self::PUBSUB:
+                return startSubscribers($key, $size, $client, $connection) + ['value' => $value];
+            case self::MGET:
+                $keys = [];
+                for ($i = 0; $i < $size; $i++) {
+                    // No hash tag, so a cluster client has to fan out across slots
+                    $keys[] = "{$key}:{$i}";
+                    $client->set("{$key}:{$i}", $value);
+                }
+                return ['keys' => $keys];
+        }
+    }
+
+    /**
+     * Run one operation and return the number of commands it sent.
+     */
+    public function run(object $client, int $size, array &$state): int
+    {
+        switch ($this) {
+            case self::PIPELINE:
+                $pipe = $client->pipeline();
+                for ($i = 0; $i < $size; $i++) {
+                    $key = $state['keys'][$i % PROFILE_LOAD_CHUNK];
+                    if ($i % 2) {
+                        $pipe->get($key);
+                    } else {
+                        $pipe->set($key, $state['value']);
+                    }
+                }
+                $pipe->exec();
+                return $size;
+            case self::HGETALL:
+                $client->hGetAll($state['key']);
+                return 1;
+            case self::HGETALL_CHUNKED:
+                $pages = 0;
+                foreach ($client->hGetAllChunked($state['key'], PROFILE_HSCAN_CHUNK) as $page) {
+                    $pages++;
+                }
+                return max($pages, 1);
+            case self::ZRANGE:
+                $client->zRange($state['key'], 0, -1, ['withscores' => true]);
+                return 1;
+            case self::XREADGROUP:
+                $reply = $client->xReadGroup('bench', 'consumer', [$state['key'] => '>'], $size);
+                $entries = $reply[$state['key']] ?? [];
+                if (!$entries) {
+                    // Consumed the whole stream; deliver it again from the start
+                    $client->xGroup('SETID', $state['key'], 'bench', '0');
+                    return 2;
+                }
+                $client->xAck($state['key'], 'bench', array_keys($entries));
+                return 2;
+            case self::PUBSUB:
+                $client->publish($state['channel'], hrtime(true) . ':' . $state['value']);
+                return 1;
+            case self::MGET:
+                $client->mget($state['keys']);
+                return 1;
+        }
+    }
+
+    /**
+     * Remove the profile's data. Returns extra result fields (subscriber-side figures).
+     */
+    public function tearDown(object $client, array $state): array
+    {
+        if ($this === self::PUBSUB) {
+            return stopSubscribers($client, $state);
+        }
+        if (isset($state['keys'])) {
+            foreach (array_chunk($state['keys'], PROFILE_LOAD_CHUNK) as $keys) {
+                $client->del($keys);
+            }
+        } elseif (isset($state['key'])) {
+            $client->del($state['key']);
+        }
+        return [];
+    }
+
+    public function supports(object $client): bool
+    {
+        // phpredis has no cluster pipelines, and hGetAllChunked() is a ValkeyGlide extension
+        return match ($this) {
+            self::PIPELINE => !($client instanceof RedisCluster),
+            self::HGETALL_CHUNKED => method_exists($client, 'hGetAllChunked'),
+            default => true,
+        };
+    }
+}
+
+/**
+ * Start $count subscriber processes on $channel and wait until they are subscribed.
+ */
+function startSubscribers(string $channel, int $count, object $client, array $connection): array
+{
+    $procs = [];
+    $resultFiles = [];
+
+    for ($i = 0; $i < $count; $i++) {
+        $resultFile = tempnam(sys_get_temp_dir(), 'bench_sub_');
+        $cmd = [
+            PHP_BINARY,
+            __DIR__ . '/pubsub_subscriber.php',
+            $connection['client'],
+            $connection['host'],
+            (string)$connection['port'],
+            $connection['tls'] ? '1' : '0',
+            $connection['cluster'] ? '1' : '0',
+            $channel,
+            $resultFile,
+        ];
+        $procs[] = proc_open($cmd, [], $pipes);
+        $resultFiles[] = $resultFile;
+    }
+
+    // PUBLISH reports how many subscribers got the message; ping until all of them are there.
+    // Cluster nodes only count their own subscribers, so give up waiting after the timeout.
+    $deadline = time() + PROFILE_SUBSCRIBER_TIMEOUT;
+    while ($client->publish($channel, 'ping') < $count && time() < $deadline) {
+        usleep(10_000);
+    }
+
+    return ['channel' => $channel, 'procs' => $procs, 'result_files' => $resultFiles];
+}
+
+/**
+ * Tell the subscribers to stop and merge what they received.
+ */
+function stopSubscribers(object $client, array $state): array
+{
+    $received = 0;
+    $elapsedNs = 0;
+    $latencies = [];
+
+    $client->publish($state['channel'], PROFILE_END_MESSAGE);
+
+    foreach ($state['procs'] as $i => $proc) {
+        $deadline = time() + PROFILE_SUBSCRIBER_TIMEOUT;
+        while (proc_get_status($proc)['running'] && time() < $deadline) {
+            usleep(10_000);
+        }
+        proc_terminate($proc);
+        proc_close($proc);
+
+        $result = json_decode((string)@file_get_contents($state['result_files'][$i]), true);
+        @unlink($state['result_files'][$i]);
+        if (!is_array($result)) {
+            echo "  Warning: subscriber {$i} did not report\n";
+            continue;
+        }
+        $received += $result['received'];
+        $elapsedNs = max($elapsedNs, $result['elapsed_ns']);
+        array_push($latencies, ...$result['latencies']);
+    }
+
+    return array_merge(
+        [
+            'messages_received' => $received,
+            'delivered_per_sec' => $elapsedNs > 0 ? (int)($received / ($elapsedNs / 1e9)) : 0,
+        ],
+        latencyResults('delivery', $latencies)
+    );
+}
+
+/**
+ * Run every size of a profile against one client type and return one result per size.
+ */
+function runProfile(
+    WorkloadProfile $profile,
+    ClientType $clientType,
+    array $connection,
+    int $dataSize,
+    int $maxOperations,
+    float $maxSeconds
+): array {
+    $results = [];
+    $client = createClient(
+        $clientType,
+        $connection['host'],
+        $connection['port'],
+        $connection['tls'],
+        $connection['cluster'],
+        $connection['alloc_stats'] ?? false
+    );
+    $allocStats = ($connection['alloc_stats'] ?? false) && method_exists($client, 'getAllocStats');
+
+    if (!$profile->supports($client)) {
+        echo "Skipping {$profile->value} for {$clientType->value}: not supported\n";
+        $client->close();
+        return [];
+    }
+
+    foreach ($profile->variants() as $size) {
+        echo "Running {$clientType->value} | profile: {$profile->value} | size: {$size}\n";
+        $state = $profile->setUp($client, $size, $dataSize, ['client' => $clientType->value] + $connection);
+
+        if ($allocStats) {
+            $client->resetAllocStats();
+        }
+        if (function_exists('memory_reset_peak_usage')) {
+            memory_reset_peak_usage();
+        }
+
+        $latencies = [];
+        $commands = 0;
+        $deadline = hrtime(true) + (int)($maxSeconds * NANOSECONDS_TO_SECONDS);
+        $start = hrtime(true);
+        while (count($latencies) < $maxOperations && hrtime(true) < $deadline) {
+            $opStart = hrtime(true);
+            $commands += $profile->run($client, $size, $state);
+            $latencies[] = convertNanosecsToMillisecs(hrtime(true) - $opStart);
+        }
+        $seconds = convertNanosecsToSecs(hrtime(true) - $start);
+        $allocs = $allocStats ? ['alloc_stats' => $client->getAllocStats()] : [];
+
+        $extra = $profile->tearDown($client, $state);
+        $operations = count($latencies);
+
+        $results[] = array_merge(
+            [
+                'client' => $clientType->value,
+                'profile' => $profile->value,
+                'size' => $size,
+                'data_size' => $dataSize,
+                'is_cluster' => $connection['cluster'],
+                'operations' => $operations,
+                'commands' => $commands,
+                'ops_per_sec' => (int)($operations / $seconds),
+                'commands_per_sec' => (int)($commands / $seconds),
+                'peak_memory' => memory_get_peak_usage(),
+            ],
+            latencyResults('op', $latencies),
+            $extra,
+            $allocs,
+            buildInfo()
+        );
+    }
+
+    $client->close();
+    return $results;
+}
+
+/**
+ * Versions the results were produced with, so JSON from different commits can be compared.
+ */
+function buildInfo(): array
+{
+    static $info = null;
+
+    return $info ??= [
+        'php_version' => PHP_VERSION,
+        'extension_version' => phpversion('valkey_glide') ?: null,
+        'git_commit' => trim((string)@shell_exec('git -C ' . escapeshellarg(__DIR__) .
+            ' rev-parse --short HEAD 2>/dev/null')) ?: null,
+    ];
+}
+
+function generateProfileMarkdownReport(array $benchResults): string
+{
+    $md = "# PHP Workload Profile Results\n\n";
+    $md .= "Generated: " . date('Y-m-d H:i:s') . "\n\n";
+    $md .= "| Client | Profile | Size | Ops/s | Commands/s | P50 (ms) | P90 (ms) | P99 (ms) |\n";
+    $md .= "|--------|---------|------|-------|------------|----------|----------|----------|\n";
+
+    foreach ($benchResults as $result) {
+        $md .= sprintf(
+            "| %s | %s | %s | %s | %s | %s | %s | %s |\n",
+            $result['client'],
+            $result['profile'],
+            number_format($result['size']),
+            number_format($result['ops_per_sec']),
+            number_format($result['commands_per_sec']),
+            $result['op_p50_latency'],
+            $result['op_p90_latency'],
+            $result['op_p99_latency']
+        );
+    }
+
+    return $md;
+}
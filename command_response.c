@@ -15,13 +15,19 @@
 
 #include "command_response.h"
 
+#include <ctype.h>
+
 #include "ext/standard/php_var.h"
 #include "include/glide/command_request.pb-c.h"
 #include "include/glide/response.pb-c.h"
 #include "include/glide_bindings.h"
 #include "logger.h"
+#include "valkey_glide_allocstats.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_latency.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_otel.h"
+#include "valkey_glide_slowlog.h"
 
 #define DEBUG_COMMAND_RESPONSE_TO_ZVAL 0
 
@@ -142,6 +148,37 @@ int parse_cluster_route(zval* route_zval, cluster_route_t* route) {
     return 0;
 }
 
+/* Describe a parsed route for the slow log */
+static void describe_cluster_route(const cluster_route_t* route, char* buf, size_t buf_len) {
+    switch (route->type) {
+        case ROUTE_TYPE_HOST_PORT:
+            snprintf(buf,
+                     buf_len,
+                     "%s:%d",
+                     route->data.host_port_route.host,
+                     route->data.host_port_route.port);
+            break;
+        case ROUTE_TYPE_SIMPLE:
+            snprintf(buf,
+                     buf_len,
+                     "%s",
+                     route->data.simple_route_type == COMMAND_REQUEST__SIMPLE_ROUTES__AllPrimaries
+                         ? "allPrimaries"
+                     : route->data.simple_route_type == COMMAND_REQUEST__SIMPLE_ROUTES__AllNodes
+                         ? "allNodes"
+                         : "randomNode");
+            break;
+        default:
+            /* The slot rather than the key, which may be sensitive */
+            snprintf(buf,
+                     buf_len,
+                     "slot:%d",
+                     valkey_glide_key_slot(route->data.key_route.key,
+                                           route->data.key_route.key_len));
+            break;
+    }
+}
+
 /* Create serialized route bytes from a cluster_route_t structure */
 uint8_t* create_route_bytes_from_route(cluster_route_t* route, size_t* route_bytes_len) {
     /* Initialize route structure */
@@ -236,6 +273,37 @@ uint8_t* create_route_bytes_from_route(cluster_route_t* route, size_t* route_byt
     return route_bytes;
 }
 
+/* Bookkeeping shared by every command once its reply is in: latency, tail sampling, the slow
+ * log and the span */
+static void execute_command_finish(enum RequestType       command_type,
+                                   zend_hrtime_t          started,
+                                   uint64_t               span_ptr,
+                                   unsigned long          arg_count,
+                                   const uintptr_t*       args,
+                                   const unsigned long*   args_len,
+                                   const CommandResult*   result,
+                                   const cluster_route_t* route) {
+    valkey_glide_latency_record(command_type, started);
+    valkey_glide_otel_tail_sample(command_type, span_ptr, started);
+    uint64_t slow_ns = valkey_glide_slowlog_check(started);
+    if (UNEXPECTED(slow_ns)) {
+        char route_desc[64];
+        if (route) {
+            describe_cluster_route(route, route_desc, sizeof(route_desc));
+        }
+        valkey_glide_slowlog_record(command_type,
+                                    slow_ns,
+                                    arg_count,
+                                    args,
+                                    args_len,
+                                    result,
+                                    route ? route_desc : NULL);
+    }
+
+    /* Cleanup span */
+    valkey_glide_drop_span(span_ptr);
+}
+
 /* Execute a command and handle common error checking */
 CommandResult* execute_command_with_route(const void*          glide_client,
                                           enum RequestType     command_type,
@@ -298,23 +366,39 @@ CommandResult* execute_command_with_route(const void*          glide_client,
         }
     }
 
+    valkey_glide_alloc_stats_phase(command_type, VALKEY_GLIDE_ALLOC_EXECUTE);
+
     /* Create OTEL span for tracing */
     uint64_t span_ptr = valkey_glide_create_span(command_type);
 
-    /* Execute the command */
-    CommandResult* result = command(glide_client,
-                                    0,               /* channel */
-                                    command_type,    /* command type */
-                                    arg_count,       /* number of arguments */
-                                    args,            /* arguments */
-                                    args_len,        /* argument lengths */
-                                    route_bytes,     /* route bytes */
-                                    route_bytes_len, /* route bytes length */
-                                    span_ptr         /* span pointer */
-    );
-
-    /* Cleanup span */
-    valkey_glide_drop_span(span_ptr);
+    /* Execute the command, yielding the current Fiber when async I/O is enabled */
+    CommandResult*          result;
+    zend_hrtime_t           started   = zend_hrtime();
+    valkey_glide_async_ctx* async_ctx = valkey_glide_async_route(glide_client);
+    if (async_ctx) {
+        result = valkey_glide_async_command(async_ctx,
+                                            command_type,
+                                            arg_count,
+                                            args,
+                                            args_len,
+                                            route_bytes,
+                                            route_bytes_len,
+                                            span_ptr);
+    } else {
+        result = command(glide_client,
+                         0,               /* channel */
+                         command_type,    /* command type */
+                         arg_count,       /* number of arguments */
+                         args,            /* arguments */
+                         args_len,        /* argument lengths */
+                         route_bytes,     /* route bytes */
+                         route_bytes_len, /* route bytes length */
+                         span_ptr         /* span pointer */
+        );
+    }
+    execute_command_finish(
+        command_type, started, span_ptr, arg_count, args, args_len, result, &route);
+    valkey_glide_alloc_stats_phase(command_type, VALKEY_GLIDE_ALLOC_CONVERT);
 
     /* Free route bytes */
     if (route_bytes) {
@@ -351,27 +435,117 @@ CommandResult* execute_command(const void*          glide_client,
         return NULL;
     }
 
+    valkey_glide_alloc_stats_phase(command_type, VALKEY_GLIDE_ALLOC_EXECUTE);
+
     /* Create OTEL span for tracing */
     uint64_t span_ptr = valkey_glide_create_span(command_type);
 
-    /* Execute the command with span support */
-    CommandResult* result = command(glide_client,
-                                    0,            /* channel */
-                                    command_type, /* command type */
-                                    arg_count,    /* number of arguments */
-                                    args,         /* arguments */
-                                    args_len,     /* argument lengths */
-                                    NULL,         /* route bytes */
-                                    0,            /* route bytes length */
-                                    span_ptr      /* span pointer */
-    );
+    /* Execute the command with span support, yielding the current Fiber when async I/O is
+     * enabled */
+    CommandResult*          result;
+    zend_hrtime_t           started   = zend_hrtime();
+    valkey_glide_async_ctx* async_ctx = valkey_glide_async_route(glide_client);
+    if (async_ctx) {
+        result = valkey_glide_async_command(
+            async_ctx, command_type, arg_count, args, args_len, NULL, 0, span_ptr);
+    } else {
+        result = command(glide_client,
+                         0,            /* channel */
+                         command_type, /* command type */
+                         arg_count,    /* number of arguments */
+                         args,         /* arguments */
+                         args_len,     /* argument lengths */
+                         NULL,         /* route bytes */
+                         0,            /* route bytes length */
+                         span_ptr      /* span pointer */
+        );
+    }
+    execute_command_finish(
+        command_type, started, span_ptr, arg_count, args, args_len, result, NULL);
+    valkey_glide_alloc_stats_phase(command_type, VALKEY_GLIDE_ALLOC_CONVERT);
 
-    /* Cleanup span */
-    valkey_glide_drop_span(span_ptr);
+    return result;
+}
+
+/* Send a command ahead of its use. It only goes out without waiting on the async_io
+ * companion; otherwise it runs right away through execute_command() */
+void execute_command_prefetch(const void*            glide_client,
+                              enum RequestType       command_type,
+                              unsigned long          arg_count,
+                              const uintptr_t*       args,
+                              const unsigned long*   args_len,
+                              valkey_glide_prefetch* prefetch) {
+    valkey_glide_async_ctx* async_ctx;
+
+    memset(prefetch, 0, sizeof(*prefetch));
+    prefetch->command_type = command_type;
+    prefetch->in_flight    = true;
+
+    async_ctx = glide_client ? valkey_glide_async_route_prefetch(glide_client) : NULL;
+    if (!async_ctx) {
+        prefetch->ready = execute_command(glide_client, command_type, arg_count, args, args_len);
+        return;
+    }
 
+    valkey_glide_alloc_stats_phase(command_type, VALKEY_GLIDE_ALLOC_EXECUTE);
+    prefetch->span_ptr = valkey_glide_create_span(command_type);
+    prefetch->started  = zend_hrtime();
+    prefetch->pending  = valkey_glide_async_command_submit(async_ctx,
+                                                          command_type,
+                                                          arg_count,
+                                                          args,
+                                                          args_len,
+                                                          prefetch->span_ptr,
+                                                          &prefetch->ready);
+    if (!prefetch->pending) {
+        execute_command_finish(command_type,
+                               prefetch->started,
+                               prefetch->span_ptr,
+                               arg_count,
+                               args,
+                               args_len,
+                               prefetch->ready,
+                               NULL);
+    }
+    valkey_glide_alloc_stats_phase(command_type, VALKEY_GLIDE_ALLOC_CONVERT);
+}
+
+/* Wait for a command sent with execute_command_prefetch() and take its result */
+CommandResult* execute_command_collect(valkey_glide_prefetch* prefetch,
+                                       unsigned long          arg_count,
+                                       const uintptr_t*       args,
+                                       const unsigned long*   args_len) {
+    CommandResult* result = prefetch->ready;
+    zend_hrtime_t  completed;
+
+    if (prefetch->pending) {
+        result = valkey_glide_async_wait_timed(prefetch->pending, &completed);
+
+        /* The reply may have sat there while PHP was busy; time the command up to its
+         * arrival rather than up to now */
+        execute_command_finish(prefetch->command_type,
+                               prefetch->started + (zend_hrtime() - completed),
+                               prefetch->span_ptr,
+                               arg_count,
+                               args,
+                               args_len,
+                               result,
+                               NULL);
+    }
+
+    prefetch->pending   = NULL;
+    prefetch->ready     = NULL;
+    prefetch->in_flight = false;
     return result;
 }
 
+/* Free a CommandResult, whichever client path produced it */
+void valkey_glide_free_command_result(CommandResult* result) {
+    if (!valkey_glide_async_release_result(result)) {
+        free_command_result(result);
+    }
+}
+
 /* Handle a string response */
 int handle_string_response(CommandResult* result, char** output, size_t* output_len) {
     /* Check if the command was successful */
@@ -436,7 +610,7 @@ int handle_string_response(CommandResult* result, char** output, size_t* output_
     }
 
     /* Free the result */
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 
     return ret_val;
 }
@@ -707,113 +881,362 @@ char* double_to_string(double value, size_t* len) {
     }
     return str;
 }
-/* Helper function to convert a CommandResponse to a PHP stream format
- * This is specifically for XRANGE/XREVRANGE commands that return stream entries
- * We need to handle both Array and Map response types
- * The output should be: ["stream_id" => ["field1" => "value1", "field2" => "value2", ...]]
- */
-int command_response_to_stream_zval(CommandResponse* response, zval* output) {
-    // printf("%s:%d - ------------------------------------------------\n", __FILE__, __LINE__);
+/* A flat array reads as pairs if it has an even length and every key is a string or an int */
+static bool script_reply_is_pairs(const CommandResponse* response) {
+    if (response->array_value_len == 0 || response->array_value_len % 2) {
+        return false;
+    }
+    for (long i = 0; i < response->array_value_len; i += 2) {
+        const CommandResponse* key = &response->array_value[i];
+        if (key->response_type != String && key->response_type != Int) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Insert key => value, or append value if the key is neither a string nor an int */
+static void script_reply_add(HashTable* ht, const CommandResponse* key, zval* value) {
+    if (key && key->response_type == String) {
+        zend_symtable_str_update(ht, key->string_value, key->string_value_len, value);
+    } else if (key && key->response_type == Int) {
+        zend_hash_index_update(ht, key->int_value, value);
+    } else {
+        zend_hash_next_index_insert(ht, value);
+    }
+}
+
+static const char* script_skip_digits(const char* p, const char* end) {
+    while (p < end && isdigit((unsigned char) *p)) {
+        p++;
+    }
+    return p;
+}
+
+/* Decode str as an int or a float only when it is spelled the way the server or Lua prints
+ * that number: no sign but a leading '-', no whitespace, no leading zeros. Anything else
+ * ("007", "+1", " 1", "-0", "1e5x") is data that merely looks numeric and stays a string */
+static bool script_reply_numeric(const char* str, size_t len, zval* output) {
+    const char* end = str + len;
+    const char* p   = str;
+    const char* digits;
+    zend_ulong  idx;
+    char        buf[64];
+
+    /* -?(0|[1-9][0-9]*), then optionally a fraction and an exponent */
+    if (p < end && *p == '-') {
+        p++;
+    }
+    digits = p;
+    p      = script_skip_digits(p, end);
+    if (p == digits || (*digits == '0' && p - digits > 1)) {
+        return false;
+    }
+    if (p == end) {
+        /* Same rule as numeric array keys, so "-0" and out of range integers stay strings */
+        if (!ZEND_HANDLE_NUMERIC_STR(str, len, idx)) {
+            return false;
+        }
+        ZVAL_LONG(output, (zend_long) idx);
+        return true;
+    }
+    if (*p == '.') {
+        digits = ++p;
+        p      = script_skip_digits(p, end);
+        if (p == digits) {
+            return false;
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        if (++p < end && (*p == '-' || *p == '+')) {
+            p++;
+        }
+        digits = p;
+        p      = script_skip_digits(p, end);
+        if (p == digits) {
+            return false;
+        }
+    }
+    if (p != end) {
+        return false;
+    }
+
+    /* Bulk strings are not NUL-terminated, and zend_strtod() would read past len; nothing
+     * the server or Lua prints as a float comes near the buffer size */
+    if (len >= sizeof(buf)) {
+        return false;
+    }
+    memcpy(buf, str, len);
+    buf[len] = '\0';
+    ZVAL_DOUBLE(output, zend_strtod(buf, NULL));
+    return true;
+}
+
+int command_response_to_script_zval(CommandResponse* response, zval* output, int decode) {
+    zval value;
+
     if (!response) {
-        // printf("%s:%d - DEBUG: Response is NULL\n", __FILE__, __LINE__);
         ZVAL_NULL(output);
         return 0;
     }
-    array_init(output);
 
-    /* Handle different response types */
-    // printf("%s:%d - DEBUG: Processing command response of type %d\n", __FILE__, __LINE__,
-    // response->response_type);
     switch (response->response_type) {
-        case Map:
-            /* Process map response where keys are stream IDs and values are field-value pairs
-             */
-            for (int i = 0; i < response->array_value_len; i++) {
-                CommandResponse* element = &response->array_value[i];
+        case String:
+            if ((decode & VALKEY_GLIDE_SCRIPT_DECODE_NUMERIC) &&
+                script_reply_numeric(
+                    response->string_value, response->string_value_len, output)) {
+                return 1;
+            }
+            ZVAL_STRINGL_FAST(output, response->string_value, response->string_value_len);
+            return 1;
 
-                /* Skip if we don't have both key and value */
-                if (!element->map_key || !element->map_value) {
-                    continue;
+        case Array:
+            if ((decode & VALKEY_GLIDE_SCRIPT_DECODE_PAIRS) && script_reply_is_pairs(response)) {
+                array_init_size(output, response->array_value_len / 2);
+                for (long i = 0; i < response->array_value_len; i += 2) {
+                    command_response_to_script_zval(&response->array_value[i + 1], &value, decode);
+                    script_reply_add(Z_ARRVAL_P(output), &response->array_value[i], &value);
                 }
+                return 1;
+            }
+            array_init_size(output, response->array_value_len);
+            for (long i = 0; i < response->array_value_len; i++) {
+                command_response_to_script_zval(&response->array_value[i], &value, decode);
+                zend_hash_next_index_insert_new(Z_ARRVAL_P(output), &value);
+            }
+            return 1;
 
-                /* Extract stream ID from key */
-                if (element->map_key->response_type != String) {
-                    continue;
+        case Map:
+            if (decode & VALKEY_GLIDE_SCRIPT_DECODE_MAPS) {
+                array_init_size(output, response->array_value_len);
+                for (long i = 0; i < response->array_value_len; i++) {
+                    CommandResponse* element = &response->array_value[i];
+                    command_response_to_script_zval(element->map_value, &value, decode);
+                    script_reply_add(Z_ARRVAL_P(output), element->map_key, &value);
                 }
+                return 1;
+            }
+            /* Flat key, value list, as command_response_to_zval() does */
+            array_init_size(output, response->array_value_len * 2);
+            for (long i = 0; i < response->array_value_len; i++) {
+                CommandResponse* element = &response->array_value[i];
+                command_response_to_script_zval(element->map_key, &value, decode);
+                zend_hash_next_index_insert_new(Z_ARRVAL_P(output), &value);
+                command_response_to_script_zval(element->map_value, &value, decode);
+                zend_hash_next_index_insert_new(Z_ARRVAL_P(output), &value);
+            }
+            return 1;
 
-                char*  stream_id     = element->map_key->string_value;
-                size_t stream_id_len = element->map_key->string_value_len;
-                // printf("%s:%d - NEW STREAM ID: %.*s\n", __FILE__, __LINE__,
-                // (int)stream_id_len, stream_id);
-
-                /* Create associative array for field-value pairs */
-
-                // printf("%s:%d - DEBUG: Processing stream ID: %.*s,
-                // element->map_value->response_type = %d\n", __FILE__, __LINE__,
-                // (int)stream_id_len, stream_id, element->map_value->response_type);
-                /* Process nested field-value pairs - add safety check */
-                if (element->map_value->response_type == Array) {
-                    zval field_array;
-                    array_init(&field_array);
-                    /* Safe version that checks array bounds */
-                    if (element->map_value->array_value_len > 0) {
-                        // printf("%s:%d - DEBUG: Processing Array response for stream ID: %.*s,
-                        // array_value_len = %ld\n", __FILE__, __LINE__, (int)stream_id_len,
-                        // stream_id, element->map_value->array_value_len);
-                        CommandResponse* field_resp1 = &element->map_value->array_value[0];
-
-                        if (field_resp1->response_type == Array &&
-                            field_resp1->array_value_len == 2) {
-                            zval field, value;
-                            command_response_to_zval(&field_resp1->array_value[0],
-                                                     &field,
-                                                     COMMAND_RESPONSE_NOT_ASSOSIATIVE,
-                                                     false);
-                            command_response_to_zval(&field_resp1->array_value[1],
-                                                     &value,
-                                                     COMMAND_RESPONSE_NOT_ASSOSIATIVE,
-                                                     false);
-
-                            if (Z_TYPE(field) == IS_STRING) {
-                                // printf("%s:%d - DEBUG: Adding field %s with value %s\n",
-                                // __FILE__, __LINE__, Z_STRVAL(field), Z_STRVAL(value));
-                                add_assoc_zval(&field_array, Z_STRVAL(field), &value);
-                                zval_dtor(&field);
-                            } else {
-                                zval_dtor(&field);
-                                zval_dtor(&value);
-                            }
-                        }
-                    }
-                    /* Add the stream entry to the output array */
-                    add_assoc_zval_ex(output, stream_id, stream_id_len, &field_array);
-                } else if (element->map_value->response_type == Map) {
-                    CommandResponse* map = element->map_value;
-                    // printf("%s:%d - DEBUG: Processing Map response for stream ID: %.*s,
-                    // map->array_value_len = %ld\n", __FILE__, __LINE__, (int)stream_id_len,
-                    // stream_id, map->array_value_len); printf("%s:%d - DEBUG: Map response
-                    // type = %d\n", __FILE__, __LINE__, map->response_type);
-                    zval output1;
-                    command_response_to_zval(
-                        map, &output1, COMMAND_RESPONSE_ARRAY_ASSOCIATIVE, false);
-                    add_assoc_zval_ex(output, stream_id, stream_id_len, &output1);
-                } else {
-                    // printf("%s:%d - DEBUG: Unexpected response type for stream fields: %d\n",
-                    // __FILE__, __LINE__, element->map_value->response_type);
-                }
+        case Sets:
+            array_init_size(output, response->sets_value_len);
+            for (long i = 0; i < response->sets_value_len; i++) {
+                command_response_to_script_zval(&response->sets_value[i], &value, decode);
+                zend_hash_next_index_insert_new(Z_ARRVAL_P(output), &value);
             }
-            break;
-        case Null:
-            /* If the response is Null, set output to NULL */
-            // printf("%s:%d - DEBUG: Response is Null\n", __FILE__, __LINE__);
-            break;
+            return 1;
 
         default:
-            zval_dtor(output); /* Clean up the initialized array */
-            ZVAL_NULL(output);
+            return command_response_to_zval(
+                response, output, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+    }
+}
+
+/* Read a numeric reply as a double. Bulk strings are not NUL-terminated, so they are
+ * parsed from a bounded copy. */
+int command_response_to_double(const CommandResponse* response, double* value) {
+    char buf[64];
+
+    switch (response->response_type) {
+        case Float:
+            *value = response->float_value;
+            return 1;
+        case Int:
+            *value = (double) response->int_value;
+            return 1;
+        case String:
+            if (response->string_value_len <= 0 ||
+                response->string_value_len >= (long) sizeof(buf)) {
+                return 0;
+            }
+            memcpy(buf, response->string_value, response->string_value_len);
+            buf[response->string_value_len] = '\0';
+            *value                           = strtod(buf, NULL);
+            return 1;
+        default:
             return 0;
     }
+}
+
+/* Pack an array reply into a string of native-endian doubles, `width` per element.
+ * Elements are either a number (width 1) or an array of `width` numbers; nulls and values
+ * that are not numbers become NAN so positions in the column still line up with the request.
+ * Returns 1 on success, 0 if the reply is not an array (output is then an empty string). */
+int command_response_to_float64_column(CommandResponse* response, zval* output, size_t width) {
+    if (!response || response->response_type != Array || width == 0) {
+        ZVAL_EMPTY_STRING(output);
+        return 0;
+    }
+
+    zend_string* column =
+        zend_string_safe_alloc(response->array_value_len, width * sizeof(double), 0, 0);
+    double* out = (double*) ZSTR_VAL(column);
+
+    for (long i = 0; i < response->array_value_len; i++) {
+        CommandResponse* element = &response->array_value[i];
+        if (width == 1) {
+            if (!command_response_to_double(element, out)) {
+                *out = ZEND_NAN;
+            }
+            out++;
+            continue;
+        }
+
+        bool complete =
+            element->response_type == Array && (size_t) element->array_value_len == width;
+        for (size_t j = 0; j < width; j++, out++) {
+            if (!complete || !command_response_to_double(&element->array_value[j], out)) {
+                *out = ZEND_NAN;
+            }
+        }
+    }
+    ZSTR_VAL(column)[ZSTR_LEN(column)] = '\0';
+
+    ZVAL_NEW_STR(output, column);
+    return 1;
+}
+
+/* Field name for position pos of an entry. Entries of a stream nearly always repeat the
+ * previous entry's field layout, so the name is checked against the string decoded at the same
+ * position last time and shared (with its cached hash) when it matches. */
+static zend_string* stream_field_name(stream_field_names_t* names,
+                                      long                  pos,
+                                      CommandResponse*      field) {
+    if (!names || pos >= STREAM_FIELD_NAMES_MAX) {
+        return zend_string_init_fast(field->string_value, field->string_value_len);
+    }
+
+    zend_string* name = names->names[pos];
+    if (name && ZSTR_LEN(name) == (size_t) field->string_value_len &&
+        memcmp(ZSTR_VAL(name), field->string_value, ZSTR_LEN(name)) == 0) {
+        return zend_string_copy(name);
+    }
+
+    if (name) {
+        zend_string_release(name);
+    }
+    name              = zend_string_init_fast(field->string_value, field->string_value_len);
+    names->names[pos] = zend_string_copy(name);
+    return name;
+}
+
+void stream_field_names_release(stream_field_names_t* names) {
+    for (int i = 0; i < STREAM_FIELD_NAMES_MAX; i++) {
+        if (names->names[i]) {
+            zend_string_release(names->names[i]);
+            names->names[i] = NULL;
+        }
+    }
+}
+
+/* Decode the fields of one stream entry into a [field => value] array. The core sends
+ * them as [field, value] pairs (RESP3), as a flat field, value, ... list (RESP2) or as a
+ * field => value map; all are read straight from the response bytes into a table sized for
+ * the entry. names may be NULL; otherwise field names are shared with the previous entry.
+ * Returns 1 on success, 0 if the entry has no fields (output is then empty). */
+int command_response_to_stream_fields(CommandResponse*      fields,
+                                      zval*                 output,
+                                      stream_field_names_t* names) {
+    if (!fields || (fields->response_type != Array && fields->response_type != Map)) {
+        array_init(output);
+        return 0;
+    }
+
+    bool map   = fields->response_type == Map;
+    bool pairs = !map && fields->array_value_len > 0 &&
+                 fields->array_value[0].response_type == Array;
+    long step  = map || pairs ? 1 : 2;
+    array_init_size(output, (uint32_t) (fields->array_value_len / step));
+
+    for (long i = 0, pos = 0; i + step - 1 < fields->array_value_len; i += step) {
+        CommandResponse *field, *value;
+        if (map) {
+            field = fields->array_value[i].map_key;
+            value = fields->array_value[i].map_value;
+        } else if (pairs) {
+            CommandResponse* pair = &fields->array_value[i];
+            if (pair->response_type != Array || pair->array_value_len != 2) {
+                continue;
+            }
+            field = &pair->array_value[0];
+            value = &pair->array_value[1];
+        } else {
+            field = &fields->array_value[i];
+            value = &fields->array_value[i + 1];
+        }
+        if (!field || !value || field->response_type != String) {
+            continue;
+        }
+
+        zval z_value;
+        if (value->response_type == String) {
+            ZVAL_STRINGL_FAST(&z_value, value->string_value, value->string_value_len);
+        } else {
+            command_response_to_zval(value, &z_value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+        }
+
+        zend_string* name = stream_field_name(names, pos++, field);
+        zend_symtable_update(Z_ARRVAL_P(output), name, &z_value);
+        zend_string_release(name);
+    }
+
+    return 1;
+}
+
+/* Decode stream entries into ["id" => [field => value, ...], ...] for XRANGE/XREVRANGE,
+ * XREADGROUP, XCLAIM and XAUTOCLAIM. The core sends the entries as an id => fields map; an
+ * [[id, fields], ...] array is accepted as well. Entries without fields (deleted while
+ * pending) are skipped. Field names are shared across entries, see stream_field_name().
+ * Returns 1 on success (Null gives an empty array), 0 for any other response type. */
+int command_response_to_stream_zval(CommandResponse* response, zval* output) {
+    if (!response) {
+        ZVAL_NULL(output);
+        return 0;
+    }
+    if (response->response_type == Null) {
+        array_init(output);
+        return 1;
+    }
+    if (response->response_type != Map && response->response_type != Array) {
+        ZVAL_NULL(output);
+        return 0;
+    }
+
+    stream_field_names_t names = {{NULL}};
+    array_init_size(output, (uint32_t) response->array_value_len);
+
+    for (long i = 0; i < response->array_value_len; i++) {
+        CommandResponse* element = &response->array_value[i];
+        CommandResponse *id = NULL, *fields = NULL;
+
+        if (response->response_type == Map) {
+            id     = element->map_key;
+            fields = element->map_value;
+        } else if (element->response_type == Array && element->array_value_len == 2) {
+            id     = &element->array_value[0];
+            fields = &element->array_value[1];
+        }
+        if (!id || id->response_type != String || !fields ||
+            (fields->response_type != Array && fields->response_type != Map)) {
+            continue;
+        }
+
+        zval entry;
+        command_response_to_stream_fields(fields, &entry, &names);
+        zend_symtable_str_update(
+            Z_ARRVAL_P(output), id->string_value, id->string_value_len, &entry);
+    }
 
+    stream_field_names_release(&names);
     return 1;
 }
 
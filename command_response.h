@@ -22,6 +22,7 @@
 #include "common.h"
 #include "include/glide_bindings.h"
 #include "php.h"
+#include "valkey_glide_async.h"
 #include "zend.h"
 #include "zend_API.h"
 
@@ -36,7 +37,7 @@ enum CommandResponseToZvalFlags {
 /*
  * Execute a command and handle common error checking
  * Returns NULL if there was an error, otherwise returns the CommandResult
- * The caller is responsible for freeing the CommandResult using free_command_result()
+ * The caller is responsible for freeing the CommandResult using valkey_glide_free_command_result()
  */
 CommandResult* execute_command(const void*          glide_client,
                                enum RequestType     command_type,
@@ -51,6 +52,44 @@ CommandResult* execute_command_with_route(const void*          glide_client,
                                           const unsigned long* args_len,
                                           zval*                arg_route);
 
+/* A command sent ahead of its use with execute_command_prefetch() */
+typedef struct {
+    valkey_glide_async_request* pending; /* Submitted on the async_io companion */
+    CommandResult*              ready;   /* Reply that is already in */
+    bool                        in_flight;
+    enum RequestType            command_type;
+    uint64_t                    span_ptr;
+    zend_hrtime_t               started;
+} valkey_glide_prefetch;
+
+/*
+ * Send a command without waiting for its reply when the client has an async_io companion,
+ * otherwise run it like execute_command(). The arguments must stay alive until
+ * execute_command_collect(), which has to be called exactly once.
+ */
+void execute_command_prefetch(const void*            glide_client,
+                              enum RequestType       command_type,
+                              unsigned long          arg_count,
+                              const uintptr_t*       args,
+                              const unsigned long*   args_len,
+                              valkey_glide_prefetch* prefetch);
+
+/*
+ * Wait for the reply of execute_command_prefetch() and record the command in the latency
+ * stats, slow log and traces like execute_command() does. Returns NULL on failure; the
+ * result is freed with valkey_glide_free_command_result()
+ */
+CommandResult* execute_command_collect(valkey_glide_prefetch* prefetch,
+                                       unsigned long          arg_count,
+                                       const uintptr_t*       args,
+                                       const unsigned long*   args_len);
+
+/*
+ * Free a CommandResult returned by execute_command*() or a batch, whether it came from
+ * the blocking core call or from the Fiber-aware async path
+ */
+void valkey_glide_free_command_result(CommandResult* result);
+
 /*
  * Handle a string response
  * Returns 1 on success, 0 if the key doesn't exist, -1 on error
@@ -96,10 +135,54 @@ char* long_to_string(long value, size_t* len);
 char* double_to_string(double value, size_t* len);
 
 /*
- * Helper function to convert a CommandResponse to a PHP stream format
- * This is specifically for XRANGE/XREVRANGE commands that return stream entries
- * Returns 1 on success, 0 if null, -1 on error
- * The output parameter is set to a PHP associative array with stream IDs as keys
+ * Convert an EVAL*/FCALL* reply to a PHP value in one pass, applying the
+ * VALKEY_GLIDE_SCRIPT_DECODE_* flags at every level. Other replies decode like
+ * command_response_to_zval() without associative maps.
+ * Returns 1 on success, 0 for a null or missing reply
+ */
+int command_response_to_script_zval(CommandResponse* response, zval* output, int decode);
+
+/*
+ * Read an Int, Float or numeric String response as a double
+ * Returns 1 on success, 0 if the response is not a number
+ */
+int command_response_to_double(const CommandResponse* response, double* value);
+
+/*
+ * Pack an Array response into a binary string of native-endian doubles (unpack('d*')),
+ * `width` values per element. Used for OPT_PACKED_NUMERICS replies; null elements and
+ * non-numeric values are written as NAN.
+ * Returns 1 on success, 0 if the response is not an array
+ */
+int command_response_to_float64_column(CommandResponse* response, zval* output, size_t width);
+
+/* Number of leading field positions whose names stream decoding shares across entries */
+#define STREAM_FIELD_NAMES_MAX 32
+
+/*
+ * Field names of the last decoded stream entry, by position. Entries of one stream usually
+ * repeat the same fields, so sharing the names saves an allocation and a hash per field.
+ * Zero-initialize before use and release with stream_field_names_release().
+ */
+typedef struct {
+    zend_string* names[STREAM_FIELD_NAMES_MAX];
+} stream_field_names_t;
+
+void stream_field_names_release(stream_field_names_t* names);
+
+/*
+ * Decode the fields of one stream entry ([field, value] pairs, a flat RESP2 list or a map)
+ * into a binary-safe [field => value] array. names may be NULL
+ * Returns 1 on success, 0 if the entry has no fields
+ */
+int command_response_to_stream_fields(CommandResponse*      fields,
+                                      zval*                 output,
+                                      stream_field_names_t* names);
+
+/*
+ * Convert stream entries (XRANGE/XREVRANGE, XREADGROUP, XCLAIM, XAUTOCLAIM) to a
+ * binary-safe ["id" => [field => value, ...]] array
+ * Returns 1 on success (Null gives an empty array), 0 for other response types
  */
 int command_response_to_stream_zval(CommandResponse* response, zval* output);
 
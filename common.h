@@ -102,6 +102,9 @@ typedef struct {
 #define VALKEY_GLIDE_EXPONENT_BASE "exponent_base"
 #define VALKEY_GLIDE_JITTER_PERCENT "jitter_percent"
 #define VALKEY_GLIDE_CONNECTION_TIMEOUT "connection_timeout"
+#define VALKEY_GLIDE_ASYNC_IO "async_io"
+#define VALKEY_GLIDE_SLOW_LOG "slow_log"
+#define VALKEY_GLIDE_ALLOC_STATS "alloc_stats"
 
 #define VALKEY_GLIDE_DEFAULT_NUM_OF_RETRIES 5
 #define VALKEY_GLIDE_DEFAULT_FACTOR 100
@@ -156,6 +159,7 @@ typedef struct {
 typedef struct {
     valkey_glide_tls_advanced_configuration_t* tls_config;         /* NULL if not set */
     int                                        connection_timeout; /* In milliseconds. */
+    bool                                       async_io;           /* Yield Fibers on I/O */
 } valkey_glide_advanced_base_client_configuration_t;
 
 typedef struct {
@@ -237,12 +241,16 @@ void valkey_glide_cleanup_client_config(valkey_glide_base_client_configuration_t
 
 typedef int (*z_result_processor_t)(CommandResponse* response, void* output, zval* return_value);
 
+/* Releases a result_ptr whose processor never ran (discarded or failed batch) */
+typedef void (*z_result_cleanup_t)(void* result_ptr);
+
 /* Batch command structure for buffering commands - FFI aligned */
 struct batch_command {
     uint8_t**            args;        /* FFI expects uint8_t** */
     uintptr_t*           arg_lengths; /* FFI expects uintptr_t* */
     void*                result_ptr;  /* Pointer to store result */
     z_result_processor_t process_result;
+    z_result_cleanup_t   free_result; /* NULL when result_ptr is not owned by the batch */
     uintptr_t            arg_count; /* FFI expects uintptr_t */
     enum RequestType     request_type;
 };
@@ -263,7 +271,10 @@ typedef enum {
     VALKEY_GLIDE_OPT_BACKOFF_ALGORITHM   = 12,
     VALKEY_GLIDE_OPT_BACKOFF_BASE        = 13,
     VALKEY_GLIDE_OPT_BACKOFF_CAP         = 14,
-    VALKEY_GLIDE_OPT_PACK_IGNORE_NUMBERS = 15
+    VALKEY_GLIDE_OPT_PACK_IGNORE_NUMBERS = 15,
+    /* Glide-specific options start at 100 to stay clear of PHPRedis values */
+    VALKEY_GLIDE_OPT_COALESCE_READS  = 100, /* Share replies of identical reads within a batch */
+    VALKEY_GLIDE_OPT_PACKED_NUMERICS = 101  /* Return numeric array replies as packed columns */
 } valkey_glide_option_t;
 
 /* Serializer types - matching phpredis (enum redis_serializer values 0-4) */
@@ -273,6 +284,12 @@ typedef enum {
 #define VALKEY_GLIDE_SERIALIZER_MSGPACK 3
 #define VALKEY_GLIDE_SERIALIZER_JSON 4
 
+/* eval()/fcall() reply decoding flags, applied while the reply is converted */
+#define VALKEY_GLIDE_SCRIPT_DECODE_MAPS 1    /* Map replies as key => value */
+#define VALKEY_GLIDE_SCRIPT_DECODE_PAIRS 2   /* Flat [k1, v1, k2, v2] arrays as k1 => v1 */
+#define VALKEY_GLIDE_SCRIPT_DECODE_NUMERIC 4 /* Numeric strings as int or float */
+#define VALKEY_GLIDE_SCRIPT_DECODE_ALL 7
+
 /* SCAN retry options - matching phpredis */
 #define VALKEY_GLIDE_SCAN_NORETRY 0
 #define VALKEY_GLIDE_SCAN_RETRY 1
@@ -305,6 +322,13 @@ typedef struct {
     zend_long opt_serializer; /* Stored value for OPT_SERIALIZER (no-op, default SERIALIZER_NONE) */
     zend_long opt_scan;       /* Stored value for OPT_SCAN (no-op, default SCAN_NORETRY) */
 
+    bool opt_coalesce_reads;  /* OPT_COALESCE_READS: send identical batched reads only once */
+    bool opt_packed_numerics; /* OPT_PACKED_NUMERICS: ZMSCORE/GEOPOS as float64 strings */
+
+    /* ValkeyGlideScript sha1 => where it is known to be loaded, NULL until a script runs;
+     * see valkey_glide_script.c */
+    HashTable* loaded_scripts;
+
     zend_object std; /* MUST be last - PHP allocates extra memory after this */
 } valkey_glide_object;
 
@@ -333,4 +357,21 @@ zend_class_entry* get_valkey_glide_exception_ce(void);
 
 zend_class_entry* get_valkey_glide_cluster_ce(void);
 
+/* Internal method running the current command, or NULL. Per-command stats are keyed by it,
+ * since request types such as CustomCommand are shared by eval, rawCommand and others */
+const zend_function* valkey_glide_calling_method(void);
+
+/* Count the commands sent until the next call under method instead of the running one, for
+ * pages an iterator fetches on behalf of the method that created it. Returns the previous
+ * setting, to be restored afterwards */
+const zend_function* valkey_glide_attribute_to(const zend_function* method);
+
+/* Stats label of method: "get" for client methods, "ValkeyGlideScript::run" for others */
+void valkey_glide_method_label(const zend_function* method, char* buf, size_t len);
+
+#define VALKEY_GLIDE_CLUSTER_SLOTS 16384
+
+/* Cluster hash slot of key, honouring {hash tags} */
+int valkey_glide_key_slot(const char* key, size_t len);
+
 #endif  // VALKEY_GLIDE
@@ -10,6 +10,9 @@ PHP_ARG_ENABLE(valkey_glide_debug, whether to enable debug mode,
 PHP_ARG_ENABLE(debug, whether to enable debug mode (alias for valkey-glide-debug),
 [  --enable-debug   Enable debug mode (alias for valkey-glide-debug)], no, no)
 
+PHP_ARG_WITH(valkey_glide_log_level, most verbose log level compiled into Valkey Glide,
+[  --with-valkey-glide-log-level=LEVEL   Compile out C log calls more verbose than LEVEL (error, warn, info, debug, trace, off)], trace, no)
+
 PHP_ARG_ENABLE(header_generation, whether to enable header generation during configure,
 [  --disable-header-generation   Skip header and protobuf generation during configure], yes, no)
 
@@ -60,6 +63,20 @@ if test "$PHP_VALKEY_GLIDE" != "no"; then
     PHP_VALKEY_GLIDE_LDFLAGS=""
   fi
 
+  dnl Compile out log calls more verbose than the chosen level
+  AC_MSG_CHECKING([for the most verbose log level compiled in])
+  case "$PHP_VALKEY_GLIDE_LOG_LEVEL" in
+    error) VALKEY_GLIDE_LOG_COMPILE_LEVEL=0 ;;
+    warn) VALKEY_GLIDE_LOG_COMPILE_LEVEL=1 ;;
+    info) VALKEY_GLIDE_LOG_COMPILE_LEVEL=2 ;;
+    debug) VALKEY_GLIDE_LOG_COMPILE_LEVEL=3 ;;
+    trace|yes) VALKEY_GLIDE_LOG_COMPILE_LEVEL=4 ;;
+    off|no) VALKEY_GLIDE_LOG_COMPILE_LEVEL=-1 ;;
+    *) AC_MSG_ERROR([invalid --with-valkey-glide-log-level: $PHP_VALKEY_GLIDE_LOG_LEVEL]) ;;
+  esac
+  AC_MSG_RESULT([$PHP_VALKEY_GLIDE_LOG_LEVEL])
+  PHP_VALKEY_GLIDE_CFLAGS="$PHP_VALKEY_GLIDE_CFLAGS -DVALKEY_GLIDE_LOG_COMPILE_LEVEL=$VALKEY_GLIDE_LOG_COMPILE_LEVEL"
+
   dnl Apply the flags to the extension
   if test -n "$PHP_VALKEY_GLIDE_CFLAGS"; then
     CFLAGS="$CFLAGS $PHP_VALKEY_GLIDE_CFLAGS"
@@ -97,7 +114,7 @@ if test "$PHP_VALKEY_GLIDE" != "no"; then
   esac
   
   PHP_NEW_EXTENSION(valkey_glide,
-    valkey_glide.c valkey_glide_cluster.c valkey_glide_pubsub_common.c valkey_glide_pubsub_introspection.c cluster_scan_cursor.c command_response.c logger.c valkey_glide_otel.c valkey_glide_commands.c valkey_glide_commands_2.c valkey_glide_commands_3.c valkey_glide_core_commands.c valkey_glide_core_common.c valkey_glide_expire_commands.c valkey_glide_geo_commands.c valkey_glide_geo_common.c valkey_glide_hash_common.c valkey_glide_list_common.c valkey_glide_s_common.c valkey_glide_str_commands.c valkey_glide_x_commands.c valkey_glide_x_common.c valkey_glide_z.c valkey_glide_z_common.c valkey_z_php_methods.c valkey_glide_script_commands.c valkey_glide_function_commands.c src/command_request.pb-c.c src/connection_request.pb-c.c src/response.pb-c.c src/client_constructor_mock.c,
+    valkey_glide.c valkey_glide_cluster.c valkey_glide_pubsub_common.c valkey_glide_pubsub_introspection.c cluster_scan_cursor.c command_response.c valkey_glide_async.c valkey_glide_latency.c valkey_glide_slowlog.c valkey_glide_allocstats.c valkey_glide_stream_consumer.c valkey_glide_hash_chunks.c valkey_glide_script.c valkey_glide_function.c logger.c valkey_glide_otel.c valkey_glide_commands.c valkey_glide_commands_2.c valkey_glide_commands_3.c valkey_glide_bulk_commands.c valkey_glide_core_commands.c valkey_glide_core_common.c valkey_glide_expire_commands.c valkey_glide_geo_commands.c valkey_glide_geo_common.c valkey_glide_hash_common.c valkey_glide_list_common.c valkey_glide_s_common.c valkey_glide_str_commands.c valkey_glide_x_commands.c valkey_glide_x_common.c valkey_glide_z.c valkey_glide_z_common.c valkey_z_php_methods.c valkey_glide_script_commands.c valkey_glide_function_commands.c src/command_request.pb-c.c src/connection_request.pb-c.c src/response.pb-c.c src/client_constructor_mock.c src/bench_harness.c,
     $ext_shared,, $VALKEY_GLIDE_SHARED_LIBADD)
 
   dnl Add FFI library only for macOS (keep Mac working as before)
@@ -3,12 +3,14 @@
 
 #include "logger.h"
 
+#include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "include/glide_bindings.h"
+#include "php.h"
 
 /* ============================================================================
  * Internal State Management - Singleton Pattern like Node.js Logger
@@ -19,6 +21,21 @@ static int  current_log_level  = VALKEY_LOG_LEVEL_DEFAULT;
 
 static enum Level current_ffi_log_level = WARN; /* FFI level tracking */
 
+int valkey_glide_log_threshold = VALKEY_LOG_LEVEL_DEFAULT;
+
+/* Per-category overrides of the global level, set with valkey_glide_logger_set_category_level
+ * for the current request only */
+typedef struct {
+    char name[VALKEY_LOG_CATEGORY_LEN];
+    int  level;
+} log_category_t;
+
+ZEND_TLS log_category_t log_categories[VALKEY_LOG_MAX_CATEGORIES];
+ZEND_TLS int            log_category_count = 0;
+
+/* Formatted messages are written here instead of an emalloc'd buffer */
+ZEND_TLS char log_fmt_buffer[VALKEY_LOG_FMT_BUFFER_SIZE];
+
 
 /* Simple mutex simulation using static variable for initialization protection */
 static volatile bool initialization_in_progress = false;
@@ -124,6 +141,30 @@ int valkey_glide_logger_get_level(void) {
  * Internal Helper Functions
  * ============================================================================ */
 
+/**
+ * Recompute the one-branch filter from the global level. Category overrides can only make a
+ * category quieter, since the Rust logger drops anything above its own level anyway.
+ */
+static void update_log_threshold(void) {
+    valkey_glide_log_threshold = current_log_level == VALKEY_LOG_LEVEL_OFF ? -1 : current_log_level;
+}
+
+/**
+ * Whether a message at level passes the override of its category, if it has one.
+ * Only reached once the message passed valkey_glide_log_threshold.
+ */
+static bool category_allows(int level, const char* identifier) {
+    int i;
+
+    for (i = 0; i < log_category_count; i++) {
+        if (strcmp(log_categories[i].name, identifier) == 0) {
+            return log_categories[i].level != VALKEY_LOG_LEVEL_OFF &&
+                   level <= log_categories[i].level;
+        }
+    }
+    return true;
+}
+
 /**
  * Internal function to actually initialize the logger via FFI.
  * This centralizes the FFI call and state management.
@@ -161,6 +202,7 @@ static int internal_init_logger(const char* level, const char* filename) {
     current_ffi_log_level = log_result->level;
     current_log_level     = ffi_level_to_int(log_result->level);
     logger_initialized    = true;
+    update_log_threshold();
 
     /* Clean up the LogResult */
     free_log_result(log_result);
@@ -227,6 +269,9 @@ void valkey_glide_logger_log(const char* level, const char* identifier, const ch
     if (current_ffi_log_level == OFF || ffi_level > current_ffi_log_level) {
         return; /* Don't log if level is below threshold or logging is off */
     }
+    if (log_category_count > 0 && !category_allows(level_int, identifier)) {
+        return;
+    }
 
     /* Call the FFI log function and handle result */
     valkey_glide_log_wrapper(ffi_level, identifier, message);
@@ -256,87 +301,104 @@ void valkey_glide_logger_debug(const char* identifier, const char* message) {
  * C Extension Interface Functions - Direct access for C code
  * ============================================================================ */
 
-void valkey_glide_c_log_error(const char* identifier, const char* message) {
+/**
+ * Common path of the C logging functions. Callers going through the VALKEY_LOG_* macros have
+ * already passed valkey_glide_log_threshold; direct callers are filtered here.
+ */
+static void c_log(int level, const char* identifier, const char* message) {
+    if (level > valkey_glide_log_threshold || identifier == NULL || message == NULL) {
+        return;
+    }
+
     /* Auto-initialize if needed */
     ensure_logger_initialized();
 
-    if (identifier == NULL || message == NULL) {
+    if (log_category_count > 0 && !category_allows(level, identifier)) {
         return;
     }
 
-    /* Check if message level is at or above current log level */
-    if (current_ffi_log_level == OFF || ERROR > current_ffi_log_level) {
-        return; /* Don't log if level is below threshold or logging is off */
-    }
-
     /* Call the FFI log function and handle result */
-    valkey_glide_log_wrapper(ERROR, identifier, message);
+    valkey_glide_log_wrapper(int_to_ffi_level(level), identifier, message);
+}
+
+void valkey_glide_c_log_error(const char* identifier, const char* message) {
+    c_log(VALKEY_LOG_LEVEL_ERROR, identifier, message);
 }
 
 void valkey_glide_c_log_warn(const char* identifier, const char* message) {
-    /* Auto-initialize if needed */
-    ensure_logger_initialized();
+    c_log(VALKEY_LOG_LEVEL_WARN, identifier, message);
+}
 
-    if (identifier == NULL || message == NULL) {
-        return;
-    }
+void valkey_glide_c_log_info(const char* identifier, const char* message) {
+    c_log(VALKEY_LOG_LEVEL_INFO, identifier, message);
+}
 
-    /* Check if message level is at or above current log level */
-    if (current_ffi_log_level == OFF || WARN > current_ffi_log_level) {
-        return; /* Don't log if level is below threshold or logging is off */
-    }
+void valkey_glide_c_log_debug(const char* identifier, const char* message) {
+    c_log(VALKEY_LOG_LEVEL_DEBUG, identifier, message);
+}
 
-    /* Call the FFI log function and handle result */
-    valkey_glide_log_wrapper(WARN, identifier, message);
+void valkey_glide_c_log_trace(const char* identifier, const char* message) {
+    c_log(VALKEY_LOG_LEVEL_TRACE, identifier, message);
 }
 
-void valkey_glide_c_log_info(const char* identifier, const char* message) {
-    /* Auto-initialize if needed */
-    ensure_logger_initialized();
+void valkey_glide_c_log_fmt(int level, const char* identifier, const char* format, ...) {
+    va_list args;
+    int     len;
 
-    if (identifier == NULL || message == NULL) {
+    if (level > valkey_glide_log_threshold) {
         return;
     }
 
-    /* Check if message level is at or above current log level */
-    if (current_ffi_log_level == OFF || INFO > current_ffi_log_level) {
-        return; /* Don't log if level is below threshold or logging is off */
-    }
-
-    /* Call the FFI log function and handle result */
-    valkey_glide_log_wrapper(INFO, identifier, message);
-}
-
-void valkey_glide_c_log_debug(const char* identifier, const char* message) {
-    /* Auto-initialize if needed */
-    ensure_logger_initialized();
+    va_start(args, format);
+    len = vsnprintf(log_fmt_buffer, sizeof(log_fmt_buffer), format, args);
+    va_end(args);
 
-    if (identifier == NULL || message == NULL) {
+    if (len < 0) {
         return;
     }
-
-    /* Check if message level is at or above current log level */
-    if (current_ffi_log_level == OFF || DEBUG > current_ffi_log_level) {
-        return; /* Don't log if level is below threshold or logging is off */
+    if ((size_t) len >= sizeof(log_fmt_buffer)) {
+        /* Mark the cut so a truncated message is not mistaken for a complete one */
+        memcpy(log_fmt_buffer + sizeof(log_fmt_buffer) - 4, "...", 4);
     }
-
-    /* Call the FFI log function and handle result */
-    valkey_glide_log_wrapper(DEBUG, identifier, message);
+    c_log(level, identifier, log_fmt_buffer);
 }
 
-void valkey_glide_c_log_trace(const char* identifier, const char* message) {
-    /* Auto-initialize if needed */
-    ensure_logger_initialized();
+/* ============================================================================
+ * Per-category Levels
+ * ============================================================================ */
 
-    if (identifier == NULL || message == NULL) {
-        return;
+int valkey_glide_logger_set_category_level(const char* category, const char* level) {
+    int i;
+
+    if (category == NULL || strlen(category) >= VALKEY_LOG_CATEGORY_LEN) {
+        return -1;
     }
 
-    /* Check if message level is at or above current log level */
-    if (current_ffi_log_level == OFF || TRACE > current_ffi_log_level) {
-        return; /* Don't log if level is below threshold or logging is off */
+    for (i = 0; i < log_category_count; i++) {
+        if (strcmp(log_categories[i].name, category) == 0) {
+            break;
+        }
     }
 
-    /* Call the FFI log function and handle result */
-    valkey_glide_log_wrapper(TRACE, identifier, message);
+    if (level == NULL) {
+        /* Drop the override, keeping the table dense */
+        if (i < log_category_count) {
+            log_categories[i] = log_categories[--log_category_count];
+        }
+    } else {
+        if (i == log_category_count) {
+            if (log_category_count == VALKEY_LOG_MAX_CATEGORIES) {
+                return -1;
+            }
+            strcpy(log_categories[i].name, category);
+            log_category_count++;
+        }
+        log_categories[i].level = valkey_glide_logger_level_from_string(level);
+    }
+
+    return 0;
+}
+
+void valkey_glide_logger_request_shutdown(void) {
+    log_category_count = 0;
 }
@@ -32,6 +32,31 @@ extern "C" {
 /* Default log level */
 #define VALKEY_LOG_LEVEL_DEFAULT VALKEY_LOG_LEVEL_WARN
 
+/* Size of the per-thread buffer formatted messages are written into; longer ones are cut */
+#define VALKEY_LOG_FMT_BUFFER_SIZE 1024
+
+/* Maximum number of per-category level overrides and the length of a category name */
+#define VALKEY_LOG_MAX_CATEGORIES 32
+#define VALKEY_LOG_CATEGORY_LEN 32
+
+/*
+ * Most verbose level compiled in, set with ./configure --with-valkey-glide-log-level.
+ * Log calls above it fold to nothing at compile time but are still type-checked.
+ */
+#ifndef VALKEY_GLIDE_LOG_COMPILE_LEVEL
+#define VALKEY_GLIDE_LOG_COMPILE_LEVEL VALKEY_LOG_LEVEL_TRACE
+#endif
+
+/*
+ * Current log level, or -1 when logging is off. Every logging macro compares against it
+ * first, so a disabled message costs one branch and neither formats nor crosses into the FFI.
+ */
+extern int valkey_glide_log_threshold;
+
+#define VALKEY_LOG_ENABLED(level_constant)                 \
+    ((level_constant) <= VALKEY_GLIDE_LOG_COMPILE_LEVEL && \
+     (level_constant) <= valkey_glide_log_threshold)
+
 /* ============================================================================
  * External FFI Function Declarations
  * ============================================================================ */
@@ -146,34 +171,65 @@ void valkey_glide_c_log_debug(const char* identifier, const char* message);
  */
 void valkey_glide_c_log_trace(const char* identifier, const char* message);
 
+/**
+ * Format and log a message from C extension code.
+ * Formats once into a fixed per-thread buffer, so nothing is allocated.
+ */
+void valkey_glide_c_log_fmt(int level, const char* identifier, const char* format, ...)
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((format(printf, 3, 4)))
+#endif
+    ;
+
+/**
+ * Override the log level of one category (the identifier passed to the log calls).
+ * Overrides can only make a category quieter than the global level.
+ *
+ * @param category Category name
+ * @param level Log level string, or NULL to fall back to the global level again
+ * @return 0 on success, -1 if the table of overrides is full or the name is too long
+ */
+int valkey_glide_logger_set_category_level(const char* category, const char* level);
+
+/**
+ * Drop the per-category overrides at the end of a request
+ */
+void valkey_glide_logger_request_shutdown(void);
+
 /* ============================================================================
  * Convenience Macros for C Extension Code
  * ============================================================================ */
 
-#define VALKEY_LOG_ERROR(identifier, message) valkey_glide_c_log_error(identifier, message)
-#define VALKEY_LOG_WARN(identifier, message) valkey_glide_c_log_warn(identifier, message)
-#define VALKEY_LOG_INFO(identifier, message) valkey_glide_c_log_info(identifier, message)
-#define VALKEY_LOG_DEBUG(identifier, message) valkey_glide_c_log_debug(identifier, message)
-#define VALKEY_LOG_TRACE(identifier, message) valkey_glide_c_log_trace(identifier, message)
-
-/* Base macro for formatted logging with dynamic allocation */
-#define VALKEY_LOG_FMT_BASE(level_constant, level_function, level_name, category, format, ...)  \
-    do {                                                                                        \
-        if (valkey_glide_logger_get_level() == VALKEY_LOG_LEVEL_OFF ||                          \
-            level_constant > valkey_glide_logger_get_level())                                   \
-            break;                                                                              \
-        int   needed_size = snprintf(NULL, 0, format, __VA_ARGS__) + 1;                         \
-        char* log_msg     = emalloc(needed_size);                                               \
-        if (log_msg) {                                                                          \
-            snprintf(log_msg, needed_size, format, __VA_ARGS__);                                \
-            level_function(category, log_msg);                                                  \
-            efree(log_msg);                                                                     \
-        } else {                                                                                \
-            VALKEY_LOG_ERROR(category, "Failed to allocate memory for " level_name " message"); \
-        }                                                                                       \
+#define VALKEY_LOG_ERROR(identifier, message)            \
+    (VALKEY_LOG_ENABLED(VALKEY_LOG_LEVEL_ERROR)          \
+         ? valkey_glide_c_log_error(identifier, message) \
+         : (void) 0)
+#define VALKEY_LOG_WARN(identifier, message)            \
+    (VALKEY_LOG_ENABLED(VALKEY_LOG_LEVEL_WARN)          \
+         ? valkey_glide_c_log_warn(identifier, message) \
+         : (void) 0)
+#define VALKEY_LOG_INFO(identifier, message)            \
+    (VALKEY_LOG_ENABLED(VALKEY_LOG_LEVEL_INFO)          \
+         ? valkey_glide_c_log_info(identifier, message) \
+         : (void) 0)
+#define VALKEY_LOG_DEBUG(identifier, message)            \
+    (VALKEY_LOG_ENABLED(VALKEY_LOG_LEVEL_DEBUG)          \
+         ? valkey_glide_c_log_debug(identifier, message) \
+         : (void) 0)
+#define VALKEY_LOG_TRACE(identifier, message)            \
+    (VALKEY_LOG_ENABLED(VALKEY_LOG_LEVEL_TRACE)          \
+         ? valkey_glide_c_log_trace(identifier, message) \
+         : (void) 0)
+
+/* Base macro for formatted logging; arguments are only evaluated when the level is enabled */
+#define VALKEY_LOG_FMT_BASE(level_constant, level_function, level_name, category, format, ...) \
+    do {                                                                                       \
+        if (VALKEY_LOG_ENABLED(level_constant)) {                                              \
+            valkey_glide_c_log_fmt(level_constant, category, format, __VA_ARGS__);             \
+        }                                                                                      \
     } while (0)
 
-/* Dynamic allocation macro for formatted debug logging */
+/* Macro for formatted debug logging */
 #define VALKEY_LOG_DEBUG_FMT(category, format, ...) \
     VALKEY_LOG_FMT_BASE(VALKEY_LOG_LEVEL_DEBUG,     \
                         VALKEY_LOG_DEBUG,           \
@@ -182,7 +238,7 @@ void valkey_glide_c_log_trace(const char* identifier, const char* message);
                         format,                     \
                         __VA_ARGS__)
 
-/* Dynamic allocation macro for formatted error logging */
+/* Macro for formatted error logging */
 #define VALKEY_LOG_ERROR_FMT(category, format, ...) \
     VALKEY_LOG_FMT_BASE(VALKEY_LOG_LEVEL_ERROR,     \
                         VALKEY_LOG_ERROR,           \
@@ -191,7 +247,7 @@ void valkey_glide_c_log_trace(const char* identifier, const char* message);
                         format,                     \
                         __VA_ARGS__)
 
-/* Dynamic allocation macro for formatted warning logging */
+/* Macro for formatted warning logging */
 #define VALKEY_LOG_WARN_FMT(category, format, ...) \
     VALKEY_LOG_FMT_BASE(VALKEY_LOG_LEVEL_WARN,     \
                         VALKEY_LOG_WARN,           \
@@ -113,6 +113,24 @@ function valkey_glide_logger_debug(string $identifier, string $message): void
 {
 }
 
+/**
+ * Override the log level of one identifier (category).
+ *
+ * Messages logged under the identifier, by PHP code or by the extension itself, are filtered
+ * at this level instead of the global one. Overrides can only make a category quieter: the
+ * global level set with valkey_glide_logger_set_config() still applies on top of them.
+ * Overrides are per thread and are dropped at the end of the request.
+ *
+ * @param string $category The identifier to filter, e.g. "command_response"
+ * @param string|null $level Log level: "error", "warn", "info", "debug", "trace", "off",
+ *                           or null to remove the override
+ * @return bool True on success, false if the name is too long (31 bytes at most) or 32
+ *              overrides are already set
+ */
+function valkey_glide_logger_set_category_level(string $category, ?string $level): bool
+{
+}
+
 /**
  * Check if the logger has been initialized.
  *
@@ -0,0 +1,405 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+/*
+ * Micro-benchmarks of the C hot paths that do not need a server: argument marshalling,
+ * CommandResponse to zval conversion and batch buffering. Each benchmark runs its loop in C
+ * and reports nanoseconds, Zend MM allocations and allocated bytes per operation, so that
+ * regressions show up without network noise. Used by `make bench` only.
+ */
+
+#include "command_response.h"
+#include "common.h"
+#include "php.h"
+#include "valkey_glide_core_common.h"
+#include "valkey_glide_hrtime.h"
+#include "valkey_glide_z_common.h"
+#include "zend_exceptions.h"
+
+#if PHP_VERSION_ID < 80000
+#include "src/bench_harness_legacy_arginfo.h"
+#else
+#include "src/bench_harness_arginfo.h"
+#endif
+
+#define BENCH_DEFAULT_ELEMENTS 10
+#define BENCH_DEFAULT_VALUE_SIZE 16
+#define BENCH_DEFAULT_DEPTH 16
+#define BENCH_FIELD_LEN 24
+#define BENCH_STREAM_FIELDS 10
+
+zend_class_entry* bench_harness_ce;
+
+typedef struct {
+    zend_long elements;   /* Elements of a synthetic aggregate reply */
+    zend_long value_size; /* Bytes of every string value */
+    zend_long depth;      /* Commands buffered before a batch is cleared */
+} bench_options_t;
+
+typedef struct {
+    CommandResponse  root;
+    CommandResponse* children; /* Elements, or map keys followed by map values */
+    char*            values;   /* Backing store of every string in the tree */
+} bench_reply_t;
+
+/* Allocation counting: Zend MM custom handlers that count and forward to the real heap */
+static zend_mm_heap* bench_heap;
+static uint64_t      bench_allocs;
+static uint64_t      bench_bytes;
+
+static void* bench_malloc(size_t size ZEND_FILE_LINE_DC ZEND_FILE_LINE_ORIG_DC) {
+    bench_allocs++;
+    bench_bytes += size;
+    return _zend_mm_alloc(bench_heap, size ZEND_FILE_LINE_RELAY_CC ZEND_FILE_LINE_ORIG_RELAY_CC);
+}
+
+static void bench_free(void* ptr ZEND_FILE_LINE_DC ZEND_FILE_LINE_ORIG_DC) {
+    _zend_mm_free(bench_heap, ptr ZEND_FILE_LINE_RELAY_CC ZEND_FILE_LINE_ORIG_RELAY_CC);
+}
+
+static void* bench_realloc(void* ptr, size_t size ZEND_FILE_LINE_DC ZEND_FILE_LINE_ORIG_DC) {
+    bench_allocs++;
+    bench_bytes += size;
+    return _zend_mm_realloc(
+        bench_heap, ptr, size ZEND_FILE_LINE_RELAY_CC ZEND_FILE_LINE_ORIG_RELAY_CC);
+}
+
+/* Start counting; false when another custom heap (USE_ZEND_ALLOC=0, memprof) is active */
+static bool bench_count_allocs_start(void) {
+    bench_allocs = 0;
+    bench_bytes  = 0;
+    bench_heap   = zend_mm_get_heap();
+    if (zend_mm_is_custom_heap(bench_heap)) {
+        return false;
+    }
+    zend_mm_set_custom_handlers(bench_heap, bench_malloc, bench_free, bench_realloc);
+    return true;
+}
+
+static void bench_count_allocs_stop(bool counting) {
+    if (counting) {
+        zend_mm_set_custom_handlers(bench_heap, NULL, NULL, NULL);
+    }
+}
+
+/* Fill buf with len bytes of printable data */
+static void bench_fill(char* buf, size_t len) {
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        buf[i] = (char) ('a' + i % 26);
+    }
+}
+
+static void bench_string_reply(CommandResponse* reply, char* value, size_t len) {
+    memset(reply, 0, sizeof(*reply));
+    reply->response_type    = String;
+    reply->string_value     = value;
+    reply->string_value_len = len;
+}
+
+/* Build a reply of the given shape ("string", "array", "map" or "stream") the way the core
+ * returns it */
+static bool bench_reply_build(bench_reply_t* reply, const char* shape, bench_options_t* opts) {
+    size_t value_size = (size_t) opts->value_size;
+    size_t elements   = (size_t) opts->elements;
+    size_t i;
+
+    memset(reply, 0, sizeof(*reply));
+
+    if (!strcmp(shape, "string")) {
+        reply->values = emalloc(value_size + 1);
+        bench_fill(reply->values, value_size);
+        bench_string_reply(&reply->root, reply->values, value_size);
+        return true;
+    }
+
+    if (!strcmp(shape, "array")) {
+        reply->values   = emalloc(value_size + 1);
+        reply->children = ecalloc(elements, sizeof(CommandResponse));
+        bench_fill(reply->values, value_size);
+        for (i = 0; i < elements; i++) {
+            bench_string_reply(&reply->children[i], reply->values, value_size);
+        }
+        reply->root.response_type   = Array;
+        reply->root.array_value     = reply->children;
+        reply->root.array_value_len = elements;
+        return true;
+    }
+
+    if (!strcmp(shape, "map")) {
+        /* Distinct field names, or the PHP array would collapse into a single key */
+        reply->values   = emalloc(value_size + 1 + elements * BENCH_FIELD_LEN);
+        reply->children = ecalloc(elements * 3, sizeof(CommandResponse));
+        bench_fill(reply->values, value_size);
+        for (i = 0; i < elements; i++) {
+            CommandResponse* entry = &reply->children[i];
+            CommandResponse* key   = &reply->children[elements + i];
+            CommandResponse* value = &reply->children[2 * elements + i];
+            char*            field = reply->values + value_size + 1 + i * BENCH_FIELD_LEN;
+
+            bench_string_reply(key, field, snprintf(field, BENCH_FIELD_LEN, "field:%zu", i));
+            bench_string_reply(value, reply->values, value_size);
+            entry->map_key   = key;
+            entry->map_value = value;
+        }
+        reply->root.response_type   = Map;
+        reply->root.array_value     = reply->children;
+        reply->root.array_value_len = elements;
+        return true;
+    }
+
+    if (!strcmp(shape, "stream")) {
+        /* XRANGE: id => [[field, value], ...], every entry with the same BENCH_STREAM_FIELDS */
+        size_t fields = elements * BENCH_STREAM_FIELDS;
+        size_t bytes  = value_size + 1 + (BENCH_STREAM_FIELDS + elements) * BENCH_FIELD_LEN;
+
+        reply->values   = emalloc(bytes);
+        reply->children = ecalloc(elements * 3 + fields * 3, sizeof(CommandResponse));
+        bench_fill(reply->values, value_size);
+
+        CommandResponse* entries  = reply->children;
+        CommandResponse* ids      = entries + elements;
+        CommandResponse* bodies   = ids + elements;
+        CommandResponse* pairs    = bodies + elements;
+        CommandResponse* strings  = pairs + fields;
+        char*            names    = reply->values + value_size + 1;
+        char*            id_bytes = names + BENCH_STREAM_FIELDS * BENCH_FIELD_LEN;
+
+        for (i = 0; i < elements; i++) {
+            char*  id = id_bytes + i * BENCH_FIELD_LEN;
+            size_t j;
+
+            bench_string_reply(&ids[i], id, snprintf(id, BENCH_FIELD_LEN, "1700000000000-%zu", i));
+            for (j = 0; j < BENCH_STREAM_FIELDS; j++) {
+                CommandResponse* pair = &pairs[i * BENCH_STREAM_FIELDS + j];
+                CommandResponse* kv   = &strings[(i * BENCH_STREAM_FIELDS + j) * 2];
+                char*            name = names + j * BENCH_FIELD_LEN;
+
+                bench_string_reply(&kv[0], name, snprintf(name, BENCH_FIELD_LEN, "field:%zu", j));
+                bench_string_reply(&kv[1], reply->values, value_size);
+                pair->response_type   = Array;
+                pair->array_value     = kv;
+                pair->array_value_len = 2;
+            }
+            bodies[i].response_type   = Array;
+            bodies[i].array_value     = &pairs[i * BENCH_STREAM_FIELDS];
+            bodies[i].array_value_len = BENCH_STREAM_FIELDS;
+            entries[i].map_key        = &ids[i];
+            entries[i].map_value      = &bodies[i];
+        }
+        reply->root.response_type   = Map;
+        reply->root.array_value     = entries;
+        reply->root.array_value_len = elements;
+        return true;
+    }
+
+    return false;
+}
+
+static void bench_reply_free(bench_reply_t* reply) {
+    if (reply->children) {
+        efree(reply->children);
+    }
+    if (reply->values) {
+        efree(reply->values);
+    }
+}
+
+/* Marshal SET key value (or GET key) into the argument arrays handed to the core */
+static void bench_marshal(enum RequestType type, const char* key, const char* value, size_t len) {
+    core_command_args_t args              = {0};
+    uintptr_t*          cmd_args          = NULL;
+    unsigned long*      cmd_args_len      = NULL;
+    char**              allocated_strings = NULL;
+    int                 allocated_count   = 0;
+
+    args.cmd_type = type;
+    args.key      = key;
+    args.key_len  = strlen(key);
+    if (type == Set) {
+        args.args[0].type                  = CORE_ARG_TYPE_STRING;
+        args.args[0].data.string_arg.value = value;
+        args.args[0].data.string_arg.len   = len;
+        args.arg_count                     = 1;
+    }
+
+    prepare_core_args(&args, &cmd_args, &cmd_args_len, &allocated_strings, &allocated_count);
+    free_core_args(cmd_args, cmd_args_len, allocated_strings, allocated_count);
+}
+
+static void bench_parse_options(HashTable* options, bench_options_t* opts) {
+    zval* val;
+
+    opts->elements   = BENCH_DEFAULT_ELEMENTS;
+    opts->value_size = BENCH_DEFAULT_VALUE_SIZE;
+    opts->depth      = BENCH_DEFAULT_DEPTH;
+    if (!options) {
+        return;
+    }
+    if ((val = zend_hash_str_find(options, "elements", sizeof("elements") - 1))) {
+        opts->elements = MAX(zval_get_long(val), 0);
+    }
+    if ((val = zend_hash_str_find(options, "value_size", sizeof("value_size") - 1))) {
+        opts->value_size = MAX(zval_get_long(val), 0);
+    }
+    if ((val = zend_hash_str_find(options, "depth", sizeof("depth") - 1))) {
+        opts->depth = MAX(zval_get_long(val), 1);
+    }
+}
+
+/* Run iterations operations of the named benchmark; false if there is no such benchmark */
+static bool bench_run(const char* name, zend_long iterations, bench_options_t* opts) {
+    static const char key[] = "bench:key";
+    bench_reply_t     reply;
+    char*             value;
+    zend_long         i;
+
+    if (!strcmp(name, "marshal_get") || !strcmp(name, "marshal_set")) {
+        enum RequestType type = name[8] == 'g' ? Get : Set;
+
+        value = emalloc(opts->value_size + 1);
+        bench_fill(value, opts->value_size);
+        for (i = 0; i < iterations; i++) {
+            bench_marshal(type, key, value, opts->value_size);
+        }
+        efree(value);
+        return true;
+    }
+
+    if (!strncmp(name, "response_", sizeof("response_") - 1)) {
+        const char* shape = name + sizeof("response_") - 1;
+        int         assoc = COMMAND_RESPONSE_NOT_ASSOSIATIVE;
+
+        if (!strcmp(shape, "map_assoc")) {
+            shape = "map";
+            assoc = COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP;
+        }
+        if (!bench_reply_build(&reply, shape, opts)) {
+            return false;
+        }
+        for (i = 0; i < iterations; i++) {
+            zval out;
+            if (!strcmp(shape, "stream")) {
+                command_response_to_stream_zval(&reply.root, &out);
+            } else {
+                command_response_to_zval(&reply.root, &out, assoc, false);
+            }
+            zval_ptr_dtor(&out);
+        }
+        bench_reply_free(&reply);
+        return true;
+    }
+
+    if (!strcmp(name, "batch_buffer")) {
+        /* Only the batch fields are used, the object is never handed to the engine */
+        valkey_glide_object batch = {0};
+        uintptr_t           args[2];
+        unsigned long       args_len[2];
+
+        value = emalloc(opts->value_size + 1);
+        bench_fill(value, opts->value_size);
+        args[0]     = (uintptr_t) key;
+        args_len[0] = sizeof(key) - 1;
+        args[1]     = (uintptr_t) value;
+        args_len[1] = opts->value_size;
+
+        for (i = 0; i < iterations; i++) {
+            if (!batch.is_in_batch_mode) {
+                batch.is_in_batch_mode = true;
+                batch.batch_type       = PIPELINE;
+            }
+            buffer_command_for_batch(&batch, Set, args, args_len, 2, NULL, NULL);
+            if ((zend_long) batch.command_count == opts->depth) {
+                clear_batch_state(&batch);
+            }
+        }
+        clear_batch_state(&batch);
+        efree(value);
+        return true;
+    }
+
+    return false;
+}
+
+void register_bench_harness_class(void) {
+    bench_harness_ce = register_class_ValkeyGlideBench();
+}
+
+/* {{{ proto array ValkeyGlideBench::run(string $name, int $iterations, array $options) */
+PHP_METHOD(ValkeyGlideBench, run) {
+    char*           name;
+    size_t          name_len;
+    zend_long       iterations = 100000;
+    HashTable*      options    = NULL;
+    bench_options_t opts;
+    zend_hrtime_t   started;
+    uint64_t        elapsed_ns;
+    bool            counting;
+
+    ZEND_PARSE_PARAMETERS_START(1, 3)
+    Z_PARAM_STRING(name, name_len)
+    Z_PARAM_OPTIONAL
+    Z_PARAM_LONG(iterations)
+    Z_PARAM_ARRAY_HT(options)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (iterations < 1) {
+        zend_argument_value_error(2, "must be greater than 0");
+        RETURN_THROWS();
+    }
+    bench_parse_options(options, &opts);
+
+    /* Warm caches and the allocator before measuring */
+    if (!bench_run(name, MIN(iterations, 1000), &opts)) {
+        zend_throw_exception(get_valkey_glide_exception_ce(), "Unknown benchmark", 0);
+        RETURN_THROWS();
+    }
+
+    counting   = bench_count_allocs_start();
+    started    = zend_hrtime();
+    bench_run(name, iterations, &opts);
+    elapsed_ns = (uint64_t) (zend_hrtime() - started);
+    bench_count_allocs_stop(counting);
+
+    array_init_size(return_value, 5);
+    add_assoc_string(return_value, "name", name);
+    add_assoc_long(return_value, "iterations", iterations);
+    add_assoc_double(return_value, "ns_per_op", (double) elapsed_ns / (double) iterations);
+    if (counting) {
+        add_assoc_double(
+            return_value, "allocs_per_op", (double) bench_allocs / (double) iterations);
+        add_assoc_double(return_value, "bytes_per_op", (double) bench_bytes / (double) iterations);
+    } else {
+        add_assoc_null(return_value, "allocs_per_op");
+        add_assoc_null(return_value, "bytes_per_op");
+    }
+}
+/* }}} */
+
+/* {{{ proto array ValkeyGlideBench::names() */
+PHP_METHOD(ValkeyGlideBench, names) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    array_init(return_value);
+    add_next_index_string(return_value, "marshal_get");
+    add_next_index_string(return_value, "marshal_set");
+    add_next_index_string(return_value, "response_string");
+    add_next_index_string(return_value, "response_array");
+    add_next_index_string(return_value, "response_map");
+    add_next_index_string(return_value, "response_map_assoc");
+    add_next_index_string(return_value, "response_stream");
+    add_next_index_string(return_value, "batch_buffer");
+}
+/* }}} */
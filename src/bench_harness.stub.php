@@ -0,0 +1,35 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * C micro-benchmarks of argument marshalling, reply conversion and batch buffering.
+ * Used by `make bench`; no server is needed.
+ */
+final class ValkeyGlideBench
+{
+    /**
+     * Run a benchmark loop in C.
+     *
+     * @param string $name       One of the names returned by names().
+     * @param int $iterations    Number of operations to time.
+     * @param array $options     ['elements' => 10, 'value_size' => 16, 'depth' => 16]: elements of
+     *                           aggregate replies, bytes per string value and commands buffered per
+     *                           batch.
+     *
+     * @return array ['name', 'iterations', 'ns_per_op', 'allocs_per_op', 'bytes_per_op']. The
+     *               allocation figures are null when another Zend MM custom heap is active.
+     */
+    public static function run(string $name, int $iterations = 100000, array $options = []): array;
+
+    /**
+     * Names of the available benchmarks.
+     *
+     * @return array<string>
+     */
+    public static function names(): array;
+}
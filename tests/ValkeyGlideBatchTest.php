@@ -761,6 +761,37 @@ class ValkeyGlideBatchTest extends ValkeyGlideBaseTest
         $this->valkey_glide->del($key1);
     }
 
+    public function testHashFieldResultsBatch()
+    {
+        if (!$this->compare_major_version_number(9)) {
+            $this->markTestSkipped('HGETEX requires Valkey 9.0.0+ (current: ' . $this->version . ')');
+        }
+
+        $key1 = 'batch_hfields_' . uniqid();
+        $this->valkey_glide->hSet($key1, 'field1', 'value1', 'field2', 'value2');
+
+        // The field names are only mapped onto the replies at exec()
+        $this->valkey_glide->multi();
+        $this->valkey_glide->hMget($key1, ['field1', 'missing']);
+        $this->valkey_glide->hGetEx($key1, ['field1', 'field2'], ['EX' => 60]);
+        $results = $this->valkey_glide->exec();
+
+        $this->assertEquals(['field1' => 'value1', 'missing' => false], $results[0]);
+        $this->assertEquals(['field1' => 'value1', 'field2' => 'value2'], $results[1]);
+
+        // Discarded commands release the field names they were queued with
+        $this->valkey_glide->multi();
+        $this->valkey_glide->hMget($key1, ['field1', 'field2']);
+        $this->valkey_glide->hGetEx($key1, ['field1'], ['PERSIST' => true]);
+        $this->valkey_glide->hRandField($key1, ['count' => 1, 'withvalues' => true]);
+        $this->assertTrue($this->valkey_glide->discard());
+
+        $this->assertEquals('value1', $this->valkey_glide->hGet($key1, 'field1'));
+
+        // Cleanup
+        $this->valkey_glide->del($key1);
+    }
+
     // ===================================================================
     // LIST ADVANCED OPERATIONS BATCH TESTS
     // ===================================================================
@@ -3890,6 +3921,181 @@ class ValkeyGlideBatchTest extends ValkeyGlideBaseTest
     }
     */
 
+    // ===================================================================
+    // READ COALESCING BATCH TESTS
+    // ===================================================================
+
+    public function testCoalescedReadsBatch()
+    {
+        $key1 = '{prefix}batch_coalesce_1_' . uniqid();
+        $key2 = '{prefix}batch_coalesce_2_' . uniqid();
+
+        $this->valkey_glide->set($key1, 'value1');
+        $this->valkey_glide->hset($key2, 'f1', 'v1', 'f2', 'v2');
+
+        try {
+            $this->assertTrue($this->valkey_glide->setOption(ValkeyGlide::OPT_COALESCE_READS, true));
+            $this->assertEquals(1, $this->valkey_glide->getOption(ValkeyGlide::OPT_COALESCE_READS));
+
+            // Duplicate reads share one reply, a write in between starts a new window
+            $results = $this->valkey_glide->multi(ValkeyGlide::PIPELINE)
+                ->get($key1)
+                ->hgetall($key2)
+                ->get($key1)
+                ->hgetall($key2)
+                ->set($key1, 'value2')
+                ->get($key1)
+                ->get($key1)
+                ->exec();
+
+            $this->assertEquals(['value1', ['f1' => 'v1', 'f2' => 'v2'], 'value1',
+                ['f1' => 'v1', 'f2' => 'v2'], true, 'value2', 'value2'], $results);
+
+            // Same behaviour inside a transaction
+            $results = $this->valkey_glide->multi()
+                ->get($key1)
+                ->incr($key1 . '_counter')
+                ->incr($key1 . '_counter')
+                ->get($key1)
+                ->exec();
+
+            $this->assertEquals(['value2', 1, 2, 'value2'], $results);
+        } finally {
+            $this->valkey_glide->setOption(ValkeyGlide::OPT_COALESCE_READS, false);
+            $this->valkey_glide->del($key1, $key2, $key1 . '_counter');
+        }
+    }
+
+    // ===================================================================
+    // BULK LOAD TESTS
+    // ===================================================================
+
+    public function testBulkLoad()
+    {
+        $prefix = '{prefix}bulk_load_' . uniqid() . '_';
+        $keys = [];
+
+        try {
+            // Generator of key => value pairs, split into several chunks
+            $rows = (function () use ($prefix, &$keys) {
+                for ($i = 0; $i < 25; $i++) {
+                    $keys[] = $prefix . "str_$i";
+                    yield $prefix . "str_$i" => "value_$i";
+                }
+            })();
+
+            $stats = $this->valkey_glide->bulkLoad($rows, ['chunk_size' => 10, 'ttl' => 100]);
+            $this->assertEquals(25, $stats['rows']);
+            $this->assertEquals(25, $stats['commands']);
+            $this->assertEquals(3, $stats['chunks']);
+            $this->assertEquals(0, $stats['errors']);
+            $this->assertEquals([10, 10, 5], array_column($stats['chunk_stats'], 'rows'));
+            $this->assertEquals('value_7', $this->valkey_glide->get($prefix . 'str_7'));
+            $this->assertBetween($this->valkey_glide->ttl($prefix . 'str_7'), 1, 100);
+
+            // [key, value] tuples with collection values
+            $hashKey = $prefix . 'hash';
+            $zsetKey = $prefix . 'zset';
+            $keys[] = $hashKey;
+            $keys[] = $zsetKey;
+
+            $stats = $this->valkey_glide->bulkLoad([[$hashKey, ['f1' => 'v1', 'f2' => 2]]], ['command' => 'hset']);
+            $this->assertEquals(1, $stats['rows']);
+            $this->assertEquals(['f1' => 'v1', 'f2' => '2'], $this->valkey_glide->hgetall($hashKey));
+
+            $stats = $this->valkey_glide->bulkLoad([$zsetKey => ['a' => 1, 'b' => 2.5]], ['command' => 'zadd']);
+            $this->assertEquals(0, $stats['errors']);
+            $this->assertEquals(2.5, $this->valkey_glide->zscore($zsetKey, 'b'));
+
+            // Numeric string keys arrive as integers and are still key => value pairs
+            $numericKey = (string) mt_rand(1000000, 9999999);
+            $numericSet = (string) ($numericKey + 1);
+            $keys[] = $numericKey;
+            $keys[] = $numericSet;
+
+            $stats = $this->valkey_glide->bulkLoad([$numericKey => 'numeric']);
+            $this->assertEquals(0, $stats['errors']);
+            $this->assertEquals('numeric', $this->valkey_glide->get($numericKey));
+
+            $stats = $this->valkey_glide->bulkLoad([$numericSet => ['a', 'b']], ['command' => 'sadd']);
+            $this->assertEquals(0, $stats['errors']);
+            $this->assertEqualsCanonicalizing(['a', 'b'], $this->valkey_glide->smembers($numericSet));
+
+            // Server side errors are counted per chunk rather than thrown
+            $stats = $this->valkey_glide->bulkLoad([$hashKey => ['member']], ['command' => 'sadd']);
+            $this->assertEquals(1, $stats['errors']);
+            $this->assertTrue(is_string($stats['chunk_stats'][0]['error']));
+        } finally {
+            $this->valkey_glide->del(...$keys);
+        }
+    }
+
+    public function testBulkLoadInvalidSpec()
+    {
+        try {
+            $this->valkey_glide->bulkLoad([['k', 'v']], ['command' => 'lpop']);
+            $this->fail('Expected an exception for an unsupported command');
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains('command must be one of', $e->getMessage());
+        }
+
+        try {
+            $this->valkey_glide->bulkLoad([['k', 'v', 'extra']], []);
+            $this->fail('Expected an exception for a malformed row');
+        } catch (TypeError $e) {
+            $this->assertStringContains('set values must be scalars', $e->getMessage());
+        }
+    }
+
+    public function testMigrateKeys()
+    {
+        if (!$this->minVersionCheck('7.0.0')) {
+            $this->markTestSkipped();
+        }
+
+        $prefix = '{prefix}migrate_' . uniqid() . '_';
+        $keys = [];
+        for ($i = 0; $i < 7; $i++) {
+            $keys[] = $prefix . $i;
+            $this->valkey_glide->set($prefix . $i, "value_$i");
+        }
+        $this->valkey_glide->expire($prefix . '0', 100);
+        $this->valkey_glide->hset($prefix . 'hash', 'f', 'v');
+        $keys[] = $prefix . 'hash';
+
+        // Migrating onto the same server exercises the full DUMP / RESTORE REPLACE path
+        $dst = $this->valkey_glide;
+        $progress = [];
+
+        try {
+            $stats = $this->valkey_glide->migrateKeys($dst, [...$keys, $prefix . 'missing'], [
+                'batch_size' => 3,
+                'progress' => function ($s) use (&$progress) {
+                    $progress[] = $s['migrated'];
+                },
+            ]);
+
+            $this->assertEquals(9, $stats['keys']);
+            $this->assertEquals(8, $stats['migrated']);
+            $this->assertEquals(1, $stats['missing']);
+            $this->assertEquals(0, $stats['errors']);
+            $this->assertEquals(3, $stats['batches']);
+            $this->assertEquals([3, 6, 8], $progress);
+            $this->assertEquals('value_4', $this->valkey_glide->get($prefix . '4'));
+            $this->assertEquals(['f' => 'v'], $this->valkey_glide->hgetall($prefix . 'hash'));
+            $this->assertBetween($this->valkey_glide->ttl($prefix . '0'), 1, 100);
+            $this->assertEquals(-1, $this->valkey_glide->ttl($prefix . '1'));
+
+            // Without REPLACE the existing keys make every RESTORE fail
+            $stats = $this->valkey_glide->migrateKeys($dst, $keys, ['replace' => false]);
+            $this->assertEquals(0, $stats['migrated']);
+            $this->assertEquals(count($keys), $stats['errors']);
+            $this->assertTrue(is_string($stats['last_error']));
+        } finally {
+            $this->valkey_glide->del(...$keys);
+        }
+    }
+
     // ===================================================================
     // SELECT COMMAND BATCH MODE PREVENTION TESTS
     // ===================================================================
@@ -826,6 +826,47 @@ class ValkeyGlideFeaturesTest extends ValkeyGlideBaseTest
         }
     }
 
+    public function testLoggerCategoryLevel()
+    {
+        $logFile = $this->createTempLogFile();
+        $log_file_with_date = $logFile;
+
+        try {
+            $this->assertTrue(valkey_glide_logger_set_config("info", $logFile));
+            $this->assertTrue(valkey_glide_logger_set_category_level("quiet-category", "error"));
+            $this->assertTrue(valkey_glide_logger_set_category_level("muted-category", "off"));
+            $this->assertFalse(valkey_glide_logger_set_category_level(str_repeat('x', 32), "off"));
+
+            $loudInfo = "Loud info - " . uniqid();
+            $quietInfo = "Quiet info - " . uniqid();
+            $quietError = "Quiet error - " . uniqid();
+            $mutedError = "Muted error - " . uniqid();
+
+            valkey_glide_logger_info("loud-category", $loudInfo);
+            valkey_glide_logger_info("quiet-category", $quietInfo);
+            valkey_glide_logger_error("quiet-category", $quietError);
+            valkey_glide_logger_error("muted-category", $mutedError);
+
+            // Removing the override restores the global level
+            $this->assertTrue(valkey_glide_logger_set_category_level("quiet-category", null));
+            $restoredInfo = "Restored info - " . uniqid();
+            valkey_glide_logger_info("quiet-category", $restoredInfo);
+
+            usleep(200000); // 200ms
+            $log_file_with_date = $logFile . $this->findLogSuffix($logFile);
+            $this->verifyLogFileCreated($log_file_with_date);
+
+            $this->verifyLogContains($log_file_with_date, $loudInfo, true);
+            $this->verifyLogContains($log_file_with_date, $quietInfo, false);
+            $this->verifyLogContains($log_file_with_date, $quietError, true);
+            $this->verifyLogContains($log_file_with_date, $mutedError, false);
+            $this->verifyLogContains($log_file_with_date, $restoredInfo, true);
+        } finally {
+            valkey_glide_logger_set_category_level("muted-category", null);
+            $this->cleanupLogFile($log_file_with_date);
+        }
+    }
+
     public function testLoggerLevelFiltering()
     {
         // Test that log level filtering works correctly at info level
@@ -1024,15 +1065,19 @@ class ValkeyGlideFeaturesTest extends ValkeyGlideBaseTest
             unlink($tracesFile);
         }
 
-        // Test with 100% sampling to ensure spans are exported
+        // Test with 100% sampling to ensure spans are exported. setex() shares the SET request
+        // type with set() but has a rule of its own, and an unsampled blPop() that blocks past
+        // the threshold is still reported as a slow span.
         $otelConfig = OpenTelemetryConfig::builder()
             ->traces(TracesConfig::builder()
                 ->endpoint('file://' . $tracesFile)
+                ->commandSamplePercentage('setex', 0)
+                ->commandSamplePercentage('blPop', 0)
+                ->slowCommandThresholdUs(50000)
                 ->build())
             ->flushIntervalMs(100)
             ->build();
 
-
         // Create client with OpenTelemetry configuration
         $client = new ValkeyGlide();
         $client->connect(
@@ -1055,6 +1100,12 @@ class ValkeyGlideFeaturesTest extends ValkeyGlideBaseTest
 
         ValkeyGlide::setOtelSamplePercentage(100);
 
+        // Sampled at 0% although SET runs at 100%; issued first so its rule is resolved first
+        for ($i = 0; $i < 3; $i++) {
+            $client->setex('otel:test', 60, 'value');
+        }
+        $client->blPop('otel:test:empty', 0.2);
+
         // Execute commands that should generate spans
         $client->set('otel:test', 'value');
         $value = $client->get('otel:test');
@@ -1100,6 +1151,11 @@ class ValkeyGlideFeaturesTest extends ValkeyGlideBaseTest
         $this->assertContains('SET', $spanNames, "Should have SET span");
         $this->assertContains('GET', $spanNames, "Should have GET span");
         $this->assertContains('DEL', $spanNames, "Should have DEL span");
+
+        $counts = array_count_values($spanNames);
+        $this->assertEquals(1, $counts['SET'] ?? 0, "Only set() should produce a SET span");
+        $this->assertContains('slow blPop', $spanNames, "Should have a tail-sampled blPop span");
+        $this->assertFalse(isset($counts['BLPOP']), "blPop should not be head sampled");
     }
 
     public function testOtelSamplingPercentage()
@@ -1236,6 +1292,42 @@ class ValkeyGlideFeaturesTest extends ValkeyGlideBaseTest
         );
     }
 
+    public function testOtelCommandSampleRules()
+    {
+        $tracesConfig = TracesConfig::builder()
+            ->endpoint('file:///tmp/test_traces.json')
+            ->samplePercentage(5)
+            ->commandSamplePercentage('get', 0.1)
+            ->commandSamplePercentage('flushAll', 100)
+            ->slowCommandThresholdUs(20000)
+            ->build();
+
+        $this->assertEquals(
+            ['get' => 0.1, 'flushAll' => 100.0],
+            $tracesConfig->getCommandSamplePercentages()
+        );
+        $this->assertEquals(20000, $tracesConfig->getSlowCommandThresholdUs());
+
+        // Both default to off
+        $defaults = TracesConfig::builder()->endpoint('file:///tmp/test_traces.json')->build();
+        $this->assertEquals([], $defaults->getCommandSamplePercentages());
+        $this->assertEquals(0, $defaults->getSlowCommandThresholdUs());
+
+        try {
+            TracesConfig::builder()->commandSamplePercentage('get', 100.5);
+            $this->fail("Should throw exception for percentage > 100");
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains("0 and 100", $e->getMessage());
+        }
+
+        try {
+            TracesConfig::builder()->slowCommandThresholdUs(-1);
+            $this->fail("Should throw exception for a negative threshold");
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains("negative", $e->getMessage());
+        }
+    }
+
     public function testOtelSetSamplePercentage()
     {
         // Initialize OTEL by creating a client with OTEL config
@@ -1291,6 +1383,42 @@ class ValkeyGlideFeaturesTest extends ValkeyGlideBaseTest
         }
     }
 
+    public function testOtelTraceParent()
+    {
+        $traceparent = '00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01';
+
+        $this->assertTrue(ValkeyGlide::setOtelTraceParent($traceparent));
+        $this->assertEquals($traceparent, ValkeyGlide::getOtelTraceParent());
+
+        // Malformed headers are rejected and leave the current context alone
+        $invalid = [
+            '',
+            '00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7',
+            '00-4BF92F3577B34DA6A3CE929D0E0E4736-00F067AA0BA902B7-01',
+            '00-00000000000000000000000000000000-00f067aa0ba902b7-01',
+            '00-4bf92f3577b34da6a3ce929d0e0e4736-0000000000000000-01',
+            'ff-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01',
+            '00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01-extra',
+        ];
+        foreach ($invalid as $header) {
+            try {
+                ValkeyGlide::setOtelTraceParent($header);
+                $this->fail("Should throw exception for traceparent '$header'");
+            } catch (ValkeyGlideException $e) {
+                $this->assertStringContains("traceparent", $e->getMessage());
+            }
+        }
+        $this->assertEquals($traceparent, ValkeyGlide::getOtelTraceParent());
+
+        // Future versions may append fields
+        $this->assertTrue(ValkeyGlide::setOtelTraceParent(
+            '01-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-00-extra'
+        ));
+
+        $this->assertTrue(ValkeyGlide::setOtelTraceParent(null));
+        $this->assertNull(ValkeyGlide::getOtelTraceParent());
+    }
+
     public function testCompressionBasicZSTD()
     {
         // Test basic compression with ZSTD backend
@@ -2245,4 +2373,576 @@ class ValkeyGlideFeaturesTest extends ValkeyGlideBaseTest
             $this->valkey_glide->del($key);
         }
     }
+
+    public function testAsyncIoFibers()
+    {
+        $advancedConfig = ['async_io' => true];
+        if ($this->getTLS()) {
+            $advancedConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+
+        $client = new ValkeyGlide();
+        $client->connect(
+            addresses: [['host' => $this->getHost(), 'port' => $this->getPort()]],
+            use_tls: $this->getTLS(),
+            advanced_config: $advancedConfig
+        );
+
+        // poll() is harmless when nothing is pending
+        $this->assertEquals(0, $client->poll());
+
+        $keys = [];
+        $fibers = [];
+        for ($i = 0; $i < 8; $i++) {
+            $key = "{async_io}fiber_$i";
+            $keys[] = $key;
+            $fibers[$i] = new Fiber(function () use ($client, $key, $i) {
+                $client->set($key, "value_$i");
+                return $client->get($key);
+            });
+            $fibers[$i]->start();
+        }
+
+        $deadline = microtime(true) + 5;
+        while (array_filter($fibers, fn($fiber) => !$fiber->isTerminated())) {
+            if (microtime(true) > $deadline) {
+                $this->fail('Fibers did not complete within 5 seconds');
+                $client->close();
+                return;
+            }
+            $client->poll(0.1);
+        }
+
+        foreach ($fibers as $i => $fiber) {
+            $this->assertEquals("value_$i", $fiber->getReturn());
+        }
+
+        // Outside a Fiber the blocking path is used
+        $this->assertEquals('value_0', $client->get($keys[0]));
+        $client->del(...$keys);
+
+        // select() is applied to the Fiber connection too
+        $this->assertTrue($client->select(1));
+        $fiber = new Fiber(fn() => $client->set($keys[0], 'db1'));
+        $fiber->start();
+        $deadline = microtime(true) + 5;
+        while (!$fiber->isTerminated() && microtime(true) < $deadline) {
+            $client->poll(0.1);
+        }
+        $this->assertTrue($fiber->isTerminated());
+        $this->assertEquals('db1', $client->get($keys[0]));
+        $client->del($keys[0]);
+        $client->select(0);
+
+        $client->close();
+    }
+
+    public function testAsyncIoCoalescedReads()
+    {
+        $advancedConfig = ['async_io' => true];
+        if ($this->getTLS()) {
+            $advancedConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+
+        $client = new ValkeyGlide();
+        $client->connect(
+            addresses: [['host' => $this->getHost(), 'port' => $this->getPort()]],
+            use_tls: $this->getTLS(),
+            advanced_config: $advancedConfig
+        );
+        $this->assertTrue($client->setOption(ValkeyGlide::OPT_COALESCE_READS, true));
+
+        $key = '{async_io}coalesced_' . uniqid();
+        $client->set($key, 'shared');
+
+        // Every Fiber gets its own copy of the reply, whether or not it shared the request
+        $fibers = [];
+        for ($i = 0; $i < 16; $i++) {
+            $fibers[$i] = new Fiber(fn() => $client->get($key));
+            $fibers[$i]->start();
+        }
+
+        $deadline = microtime(true) + 5;
+        while (array_filter($fibers, fn($fiber) => !$fiber->isTerminated())) {
+            if (microtime(true) > $deadline) {
+                $this->fail('Fibers did not complete within 5 seconds');
+                $client->close();
+                return;
+            }
+            $client->poll(0.1);
+        }
+
+        foreach ($fibers as $fiber) {
+            $this->assertEquals('shared', $fiber->getReturn());
+        }
+
+        // Callers sharing one decoded array each write to their own copy
+        $hash = "$key:hash";
+        $client->hMSet($hash, ['a' => '1', 'b' => '2']);
+        $fibers = [];
+        for ($i = 0; $i < 8; $i++) {
+            $fibers[$i] = new Fiber(function () use ($client, $hash, $i) {
+                $fields      = $client->hGetAll($hash);
+                $fields['a'] = "fiber$i";
+                return $fields;
+            });
+            $fibers[$i]->start();
+        }
+        while (array_filter($fibers, fn($fiber) => !$fiber->isTerminated()) && microtime(true) < $deadline) {
+            $client->poll(0.1);
+        }
+        foreach ($fibers as $i => $fiber) {
+            $this->assertEquals(['a' => "fiber$i", 'b' => '2'], $fiber->isTerminated() ? $fiber->getReturn() : null);
+        }
+        $client->del($hash);
+
+        // A read after a write sees the new value rather than a shared stale one
+        $client->set($key, 'updated');
+        $fiber = new Fiber(fn() => $client->get($key));
+        $fiber->start();
+        while (!$fiber->isTerminated() && microtime(true) < $deadline) {
+            $client->poll(0.1);
+        }
+        $this->assertEquals('updated', $fiber->isTerminated() ? $fiber->getReturn() : null);
+
+        $client->del($key);
+        $client->close();
+    }
+
+    public function testAsyncIoCompletionStream()
+    {
+        if (PHP_OS_FAMILY === 'Windows') {
+            $this->markTestSkipped();
+        }
+
+        $advancedConfig = ['async_io' => true];
+        if ($this->getTLS()) {
+            $advancedConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+
+        $client = new ValkeyGlide();
+        $client->connect(
+            addresses: [['host' => $this->getHost(), 'port' => $this->getPort()]],
+            use_tls: $this->getTLS(),
+            advanced_config: $advancedConfig
+        );
+
+        $stream = $client->getCompletionStream();
+        $this->assertTrue(is_resource($stream));
+
+        $key = '{async_io}completion_stream';
+        $fiber = new Fiber(fn() => $client->set($key, 'value'));
+        $fiber->start();
+
+        // Only wake up when the stream says a reply is waiting
+        while (!$fiber->isTerminated()) {
+            $read = [$stream];
+            $write = $except = null;
+            if (!$this->assertEquals(1, stream_select($read, $write, $except, 5))) {
+                break;
+            }
+            $client->poll();
+        }
+        $this->assertTrue($fiber->getReturn());
+
+        fclose($stream);
+        $client->del($key);
+        $client->close();
+
+        // Without async_io there is nothing to watch
+        $this->assertFalse($this->valkey_glide->getCompletionStream());
+    }
+
+    public function testLatencyStats()
+    {
+        $key = '{latency}stats_' . uniqid();
+
+        $this->assertTrue($this->valkey_glide->resetLatencyStats());
+        $this->assertEquals([], $this->valkey_glide->getLatencyStats('get'));
+
+        $this->valkey_glide->set($key, 'value');
+        for ($i = 0; $i < 10; $i++) {
+            $this->valkey_glide->get($key);
+        }
+
+        $get = $this->valkey_glide->getLatencyStats('GET');
+        $this->assertEquals(10, $get['count']);
+        foreach (['min_us', 'mean_us', 'p50_us', 'p90_us', 'p99_us', 'p999_us', 'max_us'] as $field) {
+            $this->assertGT(0, $get[$field]);
+        }
+        $this->assertLTE($get['p99_us'], $get['p50_us']);
+        $this->assertLTE($get['max_us'], $get['p99_us']);
+        $this->assertLTE($get['p50_us'], $get['min_us']);
+
+        $all = $this->valkey_glide->getLatencyStats();
+        $this->assertArrayKey($all, 'get');
+        $this->assertArrayKey($all, 'set');
+        $this->assertEquals(1, $all['set']['count']);
+
+        // eval and rawCommand both send custom commands but are labelled apart
+        $this->valkey_glide->rawCommand('PING');
+        $this->valkey_glide->eval('return 1');
+        $this->valkey_glide->eval('return 2');
+        $this->assertEquals(1, $this->valkey_glide->getLatencyStats('rawCommand')['count']);
+        $this->assertEquals(2, $this->valkey_glide->getLatencyStats('eval')['count']);
+
+        $this->valkey_glide->resetLatencyStats();
+        $this->assertEquals([], $this->valkey_glide->getLatencyStats());
+
+        $this->valkey_glide->del($key);
+    }
+
+    public function testSlowLog()
+    {
+        // A 1us threshold makes every command slow
+        $advancedConfig = ['slow_log' => ['threshold_us' => 1, 'max_len' => 4]];
+        if ($this->getTLS()) {
+            $advancedConfig['tls_config'] = ['use_insecure_tls' => true];
+        }
+
+        $client = new ValkeyGlide();
+        $client->connect(
+            addresses: [['host' => $this->getHost(), 'port' => $this->getPort()]],
+            use_tls: $this->getTLS(),
+            advanced_config: $advancedConfig
+        );
+
+        $key = '{slowlog}key_' . uniqid();
+        $this->assertTrue($client->resetSlowLog());
+        $this->assertEquals([], $client->getSlowLog());
+
+        $client->set($key, 'value');
+        $client->get($key);
+
+        $log = $client->getSlowLog();
+        $this->assertEquals(2, count($log));
+        $this->assertEquals('get', $log[0]['command']);
+        $this->assertEquals('set', $log[1]['command']);
+        $this->assertGT($log[1]['id'], $log[0]['id']);
+
+        $get = $log[0];
+        $this->assertEquals($key, $get['key']);
+        $this->assertEquals(strlen($key), $get['key_len']);
+        $this->assertBetween($get['slot'], 0, 16383);
+        $this->assertEquals(1, $get['argc']);
+        $this->assertEquals(strlen($key), $get['payload_bytes']);
+        $this->assertEquals(strlen('value'), $get['reply_size']);
+        $this->assertGT(0, $get['duration_us']);
+        $this->assertNull($get['route']);
+
+        $this->assertEquals(1, count($client->getSlowLog(1)));
+
+        // The first argument of a custom command is its name, not a key
+        $client->rawCommand('GET', $key);
+        $raw = $client->getSlowLog(1)[0];
+        $this->assertEquals('rawCommand', $raw['command']);
+        $this->assertNull($raw['key']);
+        $this->assertNull($raw['slot']);
+
+        // The ring buffer keeps only the newest max_len entries
+        for ($i = 0; $i < 10; $i++) {
+            $client->get($key);
+        }
+        $this->assertEquals(4, count($client->getSlowLog()));
+
+        $client->resetSlowLog();
+        $this->assertEquals([], $client->getSlowLog());
+
+        // Turn it back off for the other tests sharing this process
+        $client->close();
+        $client = new ValkeyGlide();
+        $client->connect(
+            addresses: [['host' => $this->getHost(), 'port' => $this->getPort()]],
+            use_tls: $this->getTLS(),
+            advanced_config: ['slow_log' => ['threshold_us' => 0]] + $advancedConfig
+        );
+        $client->del($key);
+        $this->assertEquals([], $client->getSlowLog());
+        $client->close();
+    }
+
+    public function testPackedNumerics()
+    {
+        $key = '{packed}z_' . uniqid();
+        $geo = '{packed}geo_' . uniqid();
+
+        $this->valkey_glide->zAdd($key, 1.5, 'a', -2, 'b');
+        $this->valkey_glide->geoAdd($geo, 13.361389, 38.115556, 'Palermo');
+
+        $this->assertTrue($this->valkey_glide->setOption(ValkeyGlide::OPT_PACKED_NUMERICS, true));
+        $this->assertEquals(1, $this->valkey_glide->getOption(ValkeyGlide::OPT_PACKED_NUMERICS));
+
+        try {
+            $scores = $this->valkey_glide->zMscore($key, 'a', 'missing', 'b');
+            $this->assertEquals(3 * 8, strlen($scores));
+            $scores = array_values(unpack('d*', $scores));
+            $this->assertEquals(1.5, $scores[0]);
+            $this->assertTrue(is_nan($scores[1]));
+            $this->assertEquals(-2.0, $scores[2]);
+
+            $positions = $this->valkey_glide->geopos($geo, 'Palermo', 'missing');
+            $this->assertEquals(4 * 8, strlen($positions));
+            $positions = array_values(unpack('d*', $positions));
+            $this->assertLT(0.001, abs($positions[0] - 13.361389));
+            $this->assertLT(0.001, abs($positions[1] - 38.115556));
+            $this->assertTrue(is_nan($positions[2]) && is_nan($positions[3]));
+
+            /* The option also applies to commands queued in a batch */
+            $replies = $this->valkey_glide->pipeline()->zMscore($key, 'b')->exec();
+            $this->assertEquals([-2.0], array_values(unpack('d*', $replies[0])));
+        } finally {
+            $this->valkey_glide->setOption(ValkeyGlide::OPT_PACKED_NUMERICS, false);
+        }
+
+        $this->assertEquals([1.5], $this->valkey_glide->zMscore($key, 'a'));
+        $this->valkey_glide->del($key, $geo);
+    }
+
+    public function testStreamConsumer()
+    {
+        if (version_compare($this->version, '6.2.0') < 0) {
+            $this->markTestSkipped();
+            return;
+        }
+
+        $key = '{consumer}stream_' . uniqid();
+        $this->valkey_glide->del($key);
+        $this->valkey_glide->xGroup('CREATE', $key, 'group', '0', true);
+        for ($i = 0; $i < 5; $i++) {
+            $this->valkey_glide->xAdd($key, '*', ['n' => (string)$i, "bin\0field" => 'v']);
+        }
+
+        $consumer = new ValkeyGlideStreamConsumer($this->valkey_glide, $key, 'group', 'c1', ['count' => 3]);
+
+        $entries = $consumer->read();
+        $this->assertEquals(3, count($entries));
+        $this->assertTrue($entries[0] instanceof ValkeyGlideStreamEntry);
+        $this->assertEquals(['n' => '0', "bin\0field" => 'v'], $entries[0]->fields);
+        $this->assertFalse($entries[0]->claimed);
+        $this->assertEquals(array_map(fn ($e) => $e->id, $entries), $consumer->getPendingAcks());
+
+        /* The next read acknowledges the first three in the same round-trip */
+        $entries = $consumer->read();
+        $this->assertEquals(2, count($entries));
+        $this->assertEquals(3, $this->valkey_glide->xPending($key, 'group')[0]);
+
+        $this->assertEquals([], $consumer->read());
+        $this->assertEquals(0, $this->valkey_glide->xPending($key, 'group')[0]);
+        $this->assertEquals(0, $consumer->flush());
+
+        /* Entries left pending by a consumer that went away are claimed by another */
+        $this->valkey_glide->xAdd($key, '*', ['n' => 'lost']);
+        $lost = new ValkeyGlideStreamConsumer($this->valkey_glide, $key, 'group', 'c2', ['auto_ack' => false]);
+        $this->assertEquals(1, count($lost->read()));
+        usleep(20000);
+
+        $claimer = new ValkeyGlideStreamConsumer($this->valkey_glide, $key, 'group', 'c3', ['claim_idle' => 10]);
+        $entries = $claimer->read();
+        $this->assertEquals(1, count($entries));
+        $this->assertTrue($entries[0]->claimed);
+        $this->assertEquals(['n' => 'lost'], $entries[0]->fields);
+        $this->assertEquals(1, $claimer->flush());
+        $this->assertEquals(0, $this->valkey_glide->xPending($key, 'group')[0]);
+
+        try {
+            new ValkeyGlideStreamConsumer($this->valkey_glide, $key, 'group', 'c4', ['count' => 0]);
+            $this->fail('A zero count should throw');
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains('count', $e->getMessage());
+        }
+
+        $this->valkey_glide->del($key);
+    }
+
+    public function testScriptObject()
+    {
+        $key  = '{script}key_' . uniqid();
+        $code = "redis.call('INCRBY', KEYS[1], ARGV[1]) return {KEYS[1], redis.call('GET', KEYS[1])}";
+
+        $script = new ValkeyGlideScript($code);
+        $this->assertEquals(sha1($code), $script->sha1());
+
+        /* NOSCRIPT on the first EVALSHA is recovered from with EVAL */
+        $this->valkey_glide->scriptFlush();
+        $this->assertEquals([$key, '2'], $script->run($this->valkey_glide, [$key], [2]));
+        $this->assertTrue((bool) $this->valkey_glide->scriptExists([$script->sha1()])[0]);
+        $this->assertEquals([$key => 5], $script->run($this->valkey_glide, [$key], [3], ValkeyGlide::SCRIPT_DECODE_ALL));
+
+        /* Known-loaded connections queue EVALSHA; a flushed cache is reloaded by the next run */
+        $this->valkey_glide->scriptFlush();
+        $this->assertEquals([$key, '6'], $script->run($this->valkey_glide, [$key], [1]));
+
+        $this->valkey_glide->pipeline()->set("$key:other", 'x');
+        $this->assertTrue($script->run($this->valkey_glide, [$key], [1]) === $this->valkey_glide);
+        $script->run($this->valkey_glide, [$key], [1], ValkeyGlide::SCRIPT_DECODE_NUMERIC);
+        $replies = $this->valkey_glide->exec();
+        $this->assertEquals([true, [$key, '7'], [$key, 8]], $replies);
+
+        /* A fresh script object sends its body inside a pipeline the first time */
+        $this->valkey_glide->scriptFlush();
+        $fresh = new ValkeyGlideScript("return ARGV[1]");
+        $this->valkey_glide->pipeline();
+        $fresh->run($this->valkey_glide, [], ['a']);
+        $fresh->run($this->valkey_glide, [], ['b']);
+        $this->assertEquals(['a', 'b'], $this->valkey_glide->exec());
+
+        /* A NOSCRIPT reply inside a batch makes the next queued call send the body again */
+        $this->valkey_glide->scriptFlush();
+        $this->valkey_glide->pipeline();
+        $fresh->run($this->valkey_glide, [], ['c']);
+        $this->assertEquals([false], $this->valkey_glide->exec());
+        $this->valkey_glide->pipeline();
+        $fresh->run($this->valkey_glide, [], ['d']);
+        $this->assertEquals(['d'], $this->valkey_glide->exec());
+
+        /* Queueing is not loading: a discarded EVAL leaves the next batch sending the body */
+        $tag       = uniqid();
+        $discarded = new ValkeyGlideScript("return '$tag'");
+        $this->valkey_glide->pipeline();
+        $discarded->run($this->valkey_glide);
+        $this->valkey_glide->discard();
+        $this->valkey_glide->pipeline();
+        $discarded->run($this->valkey_glide);
+        $this->assertEquals([$tag], $this->valkey_glide->exec());
+
+        $broken = new ValkeyGlideScript("return redis.call('NOSUCHCOMMAND')");
+        try {
+            $broken->run($this->valkey_glide);
+            $this->fail('A failing script should throw');
+        } catch (ValkeyGlideException $e) {
+            $this->assertTrue(strlen($e->getMessage()) > 0);
+        }
+
+        $this->valkey_glide->del($key, "$key:other");
+    }
+
+    public function testPreparedFunction()
+    {
+        if (version_compare($this->version, '7.0.0') < 0) {
+            $this->markTestSkipped();
+            return;
+        }
+
+        $key = '{function}key_' . uniqid();
+        $lib = "#!lua name=preparedlib\n" .
+               "redis.register_function{function_name='pget', callback=function(keys, args) " .
+               "return redis.call('GET', keys[1]) end, flags={'no-writes'}}\n" .
+               "redis.register_function('pincr', function(keys, args) " .
+               "return redis.call('INCRBY', keys[1], args[1]) end)";
+        $this->valkey_glide->functionLoad($lib, true);
+
+        $get  = $this->valkey_glide->prepareFunction('preparedlib', 'pget');
+        $incr = $this->valkey_glide->prepareFunction('preparedlib', 'pincr');
+        $this->assertEquals('pget', $get->getName());
+        $this->assertTrue($get->isReadOnly());
+        $this->assertFalse($incr->isReadOnly());
+
+        $this->assertEquals(5, $incr->call([$key], [5]));
+        $this->assertEquals('5', $get->call([$key]));
+
+        /* One pipeline for all argument sets, replies in order */
+        $this->assertEquals([6, 8, 11], $incr->callMany([[[$key], [1]], [[$key], ['2']], ['keys' => [$key], 'args' => [3]]]));
+        $this->assertEquals([], $incr->callMany([]));
+
+        /* Inside a caller's pipeline the calls are queued there */
+        $this->valkey_glide->pipeline();
+        $this->assertTrue($get->callMany([[[$key], []], [["$key:missing"], []]]) === $this->valkey_glide);
+        $this->assertTrue($incr->call([$key], [1]) === $this->valkey_glide);
+        $this->assertEquals(['11', null, 12], $this->valkey_glide->exec());
+
+        try {
+            $incr->callMany([[[$key], [1]], 'not a set']);
+            $this->fail('A malformed argument set should throw');
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains('callMany', $e->getMessage());
+        }
+        $this->assertEquals('12', $this->valkey_glide->get($key));
+
+        try {
+            $this->valkey_glide->prepareFunction('preparedlib', 'nosuchfn');
+            $this->fail('An unknown function should throw');
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains('nosuchfn', $e->getMessage());
+        }
+
+        $this->valkey_glide->functionDelete('preparedlib');
+        $this->valkey_glide->del($key);
+    }
+
+    public function testAllocStats()
+    {
+        $key = '{allocstats}key_' . uniqid();
+
+        $client = new ValkeyGlide();
+        $client->connect(
+            addresses: [['host' => $this->getHost(), 'port' => $this->getPort()]],
+            advanced_config: ['alloc_stats' => true]
+        );
+        $this->assertTrue($client->resetAllocStats());
+        $this->assertEquals([], $client->getAllocStats());
+
+        $client->set($key, str_repeat('x', 64));
+        for ($i = 0; $i < 10; $i++) {
+            $client->get($key);
+        }
+
+        $stats = $client->getAllocStats();
+        $this->assertArrayKey($stats, 'set');
+        $get = $stats['get'];
+        $this->assertEquals(10, $get['calls']);
+        foreach (['prepare', 'execute', 'convert'] as $phase) {
+            $this->assertArrayKey($get, $phase);
+            $this->assertArrayKey($get[$phase], 'allocs');
+            $this->assertArrayKey($get[$phase], 'bytes');
+        }
+        // Converting the reply allocates at least the returned string
+        $this->assertGT(0, $get['convert']['allocs']);
+
+        // rawCommand and eval share a request type but are profiled apart
+        $client->rawCommand('PING');
+        $client->eval('return 1');
+        $client->eval('return 2');
+        $stats = $client->getAllocStats();
+        $this->assertEquals(1, $stats['rawCommand']['calls']);
+        $this->assertEquals(2, $stats['eval']['calls']);
+
+        // Calls inside a Fiber may interleave with other fibers and are left out
+        $fiber = new Fiber(function () use ($client, $key) {
+            $client->get($key);
+        });
+        $fiber->start();
+        $this->assertEquals(10, $client->getAllocStats()['get']['calls']);
+
+        $client->resetAllocStats();
+        $this->assertEquals([], $client->getAllocStats());
+
+        $client->del($key);
+        $client->close();
+    }
+
+    public function testBenchHarness()
+    {
+        $names = ValkeyGlideBench::names();
+        $this->assertTrue(in_array('response_map', $names));
+
+        foreach ($names as $name) {
+            $result = ValkeyGlideBench::run($name, 100, ['elements' => 4, 'value_size' => 8]);
+            $this->assertEquals($name, $result['name']);
+            $this->assertEquals(100, $result['iterations']);
+            $this->assertGT(0, $result['ns_per_op']);
+        }
+
+        // Converting a 4 element array allocates at least the array and its strings
+        $result = ValkeyGlideBench::run('response_array', 100, ['elements' => 4, 'value_size' => 8]);
+        if ($result['allocs_per_op'] !== null) {
+            $this->assertGT(1, $result['allocs_per_op']);
+        }
+
+        try {
+            ValkeyGlideBench::run('no_such_benchmark');
+            $this->fail('Unknown benchmark name should throw');
+        } catch (ValkeyGlideException $e) {
+            $this->assertStringContains('Unknown benchmark', $e->getMessage());
+        }
+    }
 }
@@ -3261,6 +3261,25 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
         $this->assertEquals($mems, $this->valkey_glide->zRange('{z}', 0, -1, ['withscores' => true]));
     }
 
+    public function testZRangeWithScoresBinaryMembers()
+    {
+        $this->valkey_glide->del('{z}');
+
+        /* Members containing NUL bytes must not be truncated when used as keys */
+        $mems = ["a\0b" => 1.0, "a\0c" => 2.5, '10' => 3.0, 'top' => INF];
+        foreach ($mems as $mem => $score) {
+            $this->valkey_glide->zAdd('{z}', $score, (string)$mem);
+        }
+
+        $result = $this->valkey_glide->zRange('{z}', 0, -1, ['withscores' => true]);
+        $this->assertEquals($mems, $result);
+        foreach ($result as $score) {
+            $this->assertTrue(is_float($score));
+        }
+
+        $this->assertEquals(["a\0b" => 1.0], $this->valkey_glide->zPopMin('{z}'));
+    }
+
     public function testZRangeByLex()
     {
         /* ZRANGEBYLEX available on versions >= 2.8.9 */
@@ -3832,6 +3851,18 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
 
         $this->assertEquals([123 => 'x', 'y' => '456'], $this->valkey_glide->hMget('h', $keys));
 
+        // many fields, binary and float field names map back to the names that were sent
+        $this->valkey_glide->del('h');
+        $fields = [];
+        for ($i = 0; $i < 500; $i++) {
+            $fields["field:$i"] = "value:$i";
+        }
+        $fields["bin\0field"] = 'binary';
+        $fields['1.5'] = 'float';
+        $this->assertTrue($this->valkey_glide->hMset('h', $fields));
+        $this->assertEquals($fields, $this->valkey_glide->hMget('h', array_keys($fields)));
+        $this->assertEquals(['1.5' => 'float'], $this->valkey_glide->hMget('h', [1.5]));
+
         // check non-string types.
 
         $this->valkey_glide->del('h1');
@@ -5328,6 +5359,60 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
     }
 
 
+    public function testEvalDecode()
+    {
+        if (version_compare($this->version, '2.5.0') < 0) {
+            $this->markTestSkipped();
+        }
+
+        $pairs = "return {'a', '1', 'b', '2.5', 'c', 'x', 'list', {'7', 'y'}}";
+
+        $this->assertEquals(['a', '1', 'b', '2.5', 'c', 'x', 'list', ['7', 'y']], $this->valkey_glide->eval($pairs));
+        $this->assertEquals(
+            ['a' => '1', 'b' => '2.5', 'c' => 'x', 'list' => [7 => 'y']],
+            $this->valkey_glide->eval($pairs, [], 0, ValkeyGlide::SCRIPT_DECODE_PAIRS)
+        );
+        $this->assertEquals(
+            ['a', 1, 'b', 2.5, 'c', 'x', 'list', [7, 'y']],
+            $this->valkey_glide->eval($pairs, [], 0, ValkeyGlide::SCRIPT_DECODE_NUMERIC)
+        );
+
+        $decoded = $this->valkey_glide->eval($pairs, [], 0, ValkeyGlide::SCRIPT_DECODE_ALL);
+        $this->assertTrue($decoded['a'] === 1 && $decoded['b'] === 2.5 && $decoded['c'] === 'x');
+
+        /* Only numbers spelled the way the server prints them decode; the rest is data */
+        $this->assertTrue(
+            [-3, 0, 1.5, -2.0e-5, '007', '+1', ' 1', '1 ', '-0', '.5', '1.', '0x1A', '1e', '99999999999999999999']
+            === $this->valkey_glide->eval(
+                "return {'-3', '0', '1.5', '-2.0e-5', '007', '+1', ' 1', '1 ', '-0', '.5', '1.', '0x1A', '1e', '99999999999999999999'}",
+                [], 0, ValkeyGlide::SCRIPT_DECODE_NUMERIC
+            )
+        );
+
+        /* Odd lengths and non-scalar keys stay lists */
+        $this->assertEquals(['a', 'b', 'c'], $this->valkey_glide->eval("return {'a', 'b', 'c'}", [], 0, ValkeyGlide::SCRIPT_DECODE_PAIRS));
+        $this->assertEquals([['a'], 'b'], $this->valkey_glide->eval("return {{'a'}, 'b'}", [], 0, ValkeyGlide::SCRIPT_DECODE_PAIRS));
+
+        /* A RESP3 map, or its flat RESP2 form, decodes the same with every flag */
+        $map = "redis.setresp(3); return {map={x='10'}}";
+        $this->assertEquals(['x' => 10], $this->valkey_glide->eval($map, [], 0, ValkeyGlide::SCRIPT_DECODE_ALL));
+
+        $rows = [];
+        for ($i = 0; $i < 500; $i++) {
+            $rows["k$i"] = $i;
+        }
+        $script = "local t = {} for i = 0, 499 do t[#t + 1] = 'k' .. i t[#t + 1] = tostring(i) end return t";
+        $this->assertEquals($rows, $this->valkey_glide->eval($script, [], 0, ValkeyGlide::SCRIPT_DECODE_ALL));
+
+        if (version_compare($this->version, '7.0.0') >= 0) {
+            $lib = "#!lua name=decodelib\nredis.register_function('decodefn', function(keys, args) return {'n', args[1]} end)";
+            $this->valkey_glide->functionLoad($lib, true);
+            $this->assertEquals(['n', '42'], $this->valkey_glide->fcall('decodefn', [], ['42']));
+            $this->assertEquals(['n' => 42], $this->valkey_glide->fcall('decodefn', [], ['42'], ValkeyGlide::SCRIPT_DECODE_ALL));
+            $this->valkey_glide->functionDelete('decodelib');
+        }
+    }
+
     public function testEvalSHA()
     {
         if (version_compare($this->version, '2.5.0') < 0) {
@@ -5762,6 +5847,68 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
         set_time_limit(0);  // Reset to unlimited (or default) at the end
     }
 
+    public function testHGetAllChunked()
+    {
+        $key = '{hash}chunked';
+        $this->valkey_glide->del($key);
+
+        $expected = [];
+        for ($i = 0; $i < 2000; $i++) {
+            $expected["field:$i"] = "value:$i";
+        }
+        $expected["bin\0field"] = "\xff\x00";
+        foreach (array_chunk($expected, 500, true) as $fields) {
+            $this->valkey_glide->hMset($key, $fields);
+        }
+
+        $this->valkey_glide->resetLatencyStats();
+        $chunks = $this->valkey_glide->hGetAllChunked($key, 100);
+        $this->assertIsObject($chunks, ValkeyGlideHashChunks::class);
+
+        $all = [];
+        $pages = 0;
+        foreach ($chunks as $page => $fields) {
+            $this->assertEquals($pages++, $page);
+            $this->assertTrue(count($fields) > 0);
+            $all += $fields;
+        }
+        $this->assertGT(1, $pages);
+        // Every HSCAN is timed under the method that created the iterator
+        $this->assertGTE($pages, $this->valkey_glide->getLatencyStats('hGetAllChunked')['count']);
+        ksort($all);
+        ksort($expected);
+        $this->assertEquals($expected, $all);
+
+        // Like a generator it cannot be replayed once it has advanced
+        $this->assertThrowsMatch($chunks, function ($chunks) {
+            foreach ($chunks as $page) {
+            }
+        }, '/rewind/');
+
+        // A missing key has no pages
+        $this->valkey_glide->del('{hash}chunked-missing');
+        $missing = $this->valkey_glide->hGetAllChunked('{hash}chunked-missing');
+        $this->assertEquals([], iterator_to_array($missing));
+
+        if (version_compare($this->version, '8.0.0') >= 0) {
+            $fields = [];
+            foreach ($this->valkey_glide->hGetAllChunked($key, 500, true) as $page) {
+                array_push($fields, ...$page);
+            }
+            sort($fields);
+            $names = array_map('strval', array_keys($expected));
+            sort($names);
+            $this->assertEquals($names, array_values(array_unique($fields)));
+        }
+
+        $this->valkey_glide->set('{hash}chunked-string', 'value');
+        $this->assertThrowsMatch($this->valkey_glide, function ($client) {
+            iterator_to_array($client->hGetAllChunked('{hash}chunked-string'));
+        }, '/WRONGTYPE/');
+
+        $this->valkey_glide->del($key, '{hash}chunked-string');
+    }
+
     public function testSScan()
     {
         set_time_limit(10); // Enforce a 10-second limit on this test
@@ -6088,6 +6235,77 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
         });
     }
 
+    public function testGeoSearchColumnsAndMerge()
+    {
+        if (! $this->minVersionCheck('6.2.0')) {
+            $this->markTestSkipped();
+        }
+
+        $this->valkey_glide->del('{gk}a', '{gk}b');
+        foreach ($this->cities as $city => $longlat) {
+            $key = in_array($city, ['Gridley', 'Sacramento']) ? '{gk}b' : '{gk}a';
+            $this->valkey_glide->geoadd($key, $longlat[0], $longlat[1], $city);
+        }
+        $this->valkey_glide->geoadd('{gk}b', $this->cities['Chico'][0], $this->cities['Chico'][1], 'Chico');
+
+        $from = $this->cities['Chico'];
+        $opts = ['withdist', 'withcoord', 'withhash', 'asc'];
+
+        $cols = $this->valkey_glide->geosearch('{gk}a', $from, 500, 'km', $opts + ['columns' => true]);
+        $this->assertEquals(['names', 'distances', 'hash', 'lon', 'lat'], array_keys($cols));
+        $this->assertEquals(['Chico', 'Marysville', 'Cupertino'], $cols['names']);
+        $this->assertEquals(3, count($cols['distances']));
+        $this->assertTrue(is_float($cols['distances'][1]) && is_int($cols['hash'][1]));
+        $this->assertTrue(abs($cols['lon'][0] - $from[0]) < 0.001);
+
+        $rows = $this->valkey_glide->geosearch('{gk}a', $from, 500, 'km', $opts);
+        $this->assertEquals(['Chico', 'Marysville', 'Cupertino'], array_keys($rows));
+        $this->assertEquals($cols['distances'][1], $rows['Marysville'][0]);
+        $this->assertEquals($cols['hash'][1], $rows['Marysville'][1]);
+        $this->assertEquals([$cols['lon'][1], $cols['lat'][1]], $rows['Marysville'][2]);
+
+        $this->assertEquals(
+            ['names' => ['Chico']],
+            $this->valkey_glide->geosearch('{gk}a', 'Chico', 1, 'm', ['columns' => true])
+        );
+
+        /* Rows and columns merge into the same order, Chico only once */
+        $order = ['Chico', 'Gridley', 'Marysville', 'Sacramento', 'Cupertino'];
+        $rows = [];
+        $cols = [];
+        foreach (['{gk}a', '{gk}b'] as $key) {
+            $rows[] = $this->valkey_glide->geosearch($key, $from, 500, 'km', $opts);
+            $cols[] = $this->valkey_glide->geosearch($key, $from, 500, 'km', $opts + ['columns' => true]);
+        }
+
+        $this->assertEquals($order, array_keys(ValkeyGlide::geosearchMerge($rows)));
+        $this->assertEquals(array_slice($order, 0, 3), array_keys(ValkeyGlide::geosearchMerge($rows, 3)));
+        $merged = ValkeyGlide::geosearchMerge($cols);
+        $this->assertEquals($order, $merged['names']);
+        $this->assertEquals(5, count($merged['lat']));
+        $this->assertEquals($merged['distances'], array_values(array_map(fn ($r) => $r[0], ValkeyGlide::geosearchMerge($rows))));
+
+        $desc = [];
+        foreach (['{gk}a', '{gk}b'] as $key) {
+            $desc[] = $this->valkey_glide->geosearch($key, $from, 500, 'km', ['withdist', 'desc']);
+        }
+        $this->assertEquals(array_reverse($order), array_keys(ValkeyGlide::geosearchMerge($desc, -1, true)));
+
+        $this->assertThrowsMatch(null, function () {
+            ValkeyGlide::geosearchMerge([['Chico']]);
+        }, '/WITHDIST/');
+
+        /* A WITHHASH geohash is not a distance */
+        $hashed = $this->valkey_glide->geosearch('{gk}a', $from, 500, 'km', ['withhash']);
+        $this->assertThrowsMatch($hashed, function ($hashed) {
+            ValkeyGlide::geosearchMerge([$hashed]);
+        }, '/WITHDIST/');
+
+        $this->assertThrowsMatch($rows, function ($rows) {
+            ValkeyGlide::geosearchMerge($rows, 0);
+        }, '/count/');
+    }
+
     public function testGeoSearchStore()
     {
         if (! $this->minVersionCheck('6.2.0')) {
@@ -6958,6 +7176,40 @@ class ValkeyGlideTest extends ValkeyGlideBaseTest
         }
     }
 
+    public function testXRangeMultipleFields()
+    {
+        if (! $this->minVersionCheck('5.0')) {
+            $this->markTestSkipped();
+        }
+
+        $key = '{stream}';
+        $this->valkey_glide->del($key);
+
+        /* Entries sharing a field layout, a different layout, binary and numeric fields */
+        $rows = [
+            ['a' => '1', 'b' => "two\0bytes", 'c' => ''],
+            ['a' => '3', 'b' => 'four', 'c' => 'five'],
+            ['b' => 'six', "bin\0ary" => "\xff\x00\x01", '7' => 'numeric'],
+            ['a' => '8', 'b' => 'nine', 'c' => 'ten'],
+        ];
+        $ids = [];
+        foreach ($rows as $row) {
+            $ids[] = $this->valkey_glide->xAdd($key, '*', $row);
+        }
+
+        $messages = $this->valkey_glide->xRange($key, '-', '+');
+        $this->assertEquals($ids, array_keys($messages));
+        foreach ($ids as $i => $id) {
+            $this->assertEquals($rows[$i], $messages[$id]);
+        }
+
+        $messages = $this->valkey_glide->xRevRange($key, '+', '-', 2);
+        $this->assertEquals([$ids[3], $ids[2]], array_keys($messages));
+        $this->assertEquals($rows[2], $messages[$ids[2]]);
+
+        $this->valkey_glide->del($key);
+    }
+
     protected function testXLen()
     {
         if (! $this->minVersionCheck('5.0')) {
@@ -15,6 +15,13 @@
 #include "valkey_glide_cluster_arginfo.h"  // Include generated arginfo header
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
+#include "valkey_glide_allocstats.h"
+#include "valkey_glide_latency.h"
+#include "valkey_glide_slowlog.h"
+#include "valkey_glide_stream_consumer.h"
+#include "valkey_glide_hash_chunks.h"
+#include "valkey_glide_script.h"
+#include "valkey_glide_function.h"
 #include "valkey_glide_pubsub_common.h"
 #include "valkey_glide_pubsub_introspection.h"
 
@@ -58,6 +65,7 @@ extern void free_valkey_glide_client_configuration(
     valkey_glide_base_client_configuration_t* config);
 
 void register_mock_constructor_class(void);
+void register_bench_harness_class(void);
 
 /* Default values for addresses */
 static const char* const DEFAULT_HOST            = "localhost";
@@ -83,6 +91,67 @@ zend_class_entry* get_valkey_glide_ce(void) {
     return valkey_glide_ce;
 }
 
+ZEND_TLS const zend_function* valkey_glide_attributed_method;
+
+const zend_function* valkey_glide_attribute_to(const zend_function* method) {
+    const zend_function* previous = valkey_glide_attributed_method;
+
+    valkey_glide_attributed_method = method;
+    return previous;
+}
+
+const zend_function* valkey_glide_calling_method(void) {
+    zend_execute_data* ex = EG(current_execute_data);
+
+    if (valkey_glide_attributed_method) {
+        return valkey_glide_attributed_method;
+    }
+
+    /* Internal functions live as long as the module, so the pointer is a stable key */
+    if (!ex || !ex->func || ex->func->type != ZEND_INTERNAL_FUNCTION ||
+        !ex->func->common.function_name) {
+        return NULL;
+    }
+    return ex->func;
+}
+
+void valkey_glide_method_label(const zend_function* method, char* buf, size_t len) {
+    zend_class_entry* scope = method->common.scope;
+
+    if (!scope || scope == valkey_glide_ce || scope == valkey_glide_cluster_ce) {
+        snprintf(buf, len, "%s", ZSTR_VAL(method->common.function_name));
+    } else {
+        snprintf(
+            buf, len, "%s::%s", ZSTR_VAL(scope->name), ZSTR_VAL(method->common.function_name));
+    }
+}
+
+/* CRC16-CCITT (XModem), the cluster key hash */
+static uint16_t valkey_glide_crc16(const char* buf, size_t len) {
+    uint16_t crc = 0;
+    size_t   i;
+    int      bit;
+
+    for (i = 0; i < len; i++) {
+        crc ^= (uint16_t) ((unsigned char) buf[i] << 8);
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x1021) : (uint16_t) (crc << 1);
+        }
+    }
+    return crc;
+}
+
+int valkey_glide_key_slot(const char* key, size_t len) {
+    const char* open  = memchr(key, '{', len);
+    const char* close = open ? memchr(open + 1, '}', len - (size_t) (open - key) - 1) : NULL;
+
+    if (close && close > open + 1) {
+        key = open + 1;
+        len = (size_t) (close - open - 1);
+    }
+    return valkey_glide_crc16(key, len) % VALKEY_GLIDE_CLUSTER_SLOTS;
+}
+
 zend_class_entry* get_valkey_glide_exception_ce(void) {
     return valkey_glide_exception_ce;
 }
@@ -529,6 +598,21 @@ PHP_MINIT_FUNCTION(valkey_glide) {
     /* Register mock constructor class used for testing only. */
     register_mock_constructor_class();
 
+    /* Register the C micro-benchmark class used by make bench */
+    register_bench_harness_class();
+
+    /* Register ValkeyGlideStreamEntry and ValkeyGlideStreamConsumer */
+    register_stream_consumer_classes();
+
+    /* Register the iterator returned by hGetAllChunked() */
+    register_hash_chunks_class();
+
+    /* Register ValkeyGlideScript */
+    register_script_class();
+
+    /* Register the handle returned by prepareFunction() */
+    register_function_class();
+
     /* ValkeyGlideException class */
     valkey_glide_exception_ce = register_class_ValkeyGlideException(spl_ce_RuntimeException);
     if (!valkey_glide_exception_ce) {
@@ -549,6 +633,16 @@ PHP_MINIT_FUNCTION(valkey_glide) {
 
 PHP_MSHUTDOWN_FUNCTION(valkey_glide) {
     valkey_glide_pubsub_shutdown();
+    valkey_glide_latency_shutdown();
+    valkey_glide_slowlog_shutdown();
+    valkey_glide_alloc_stats_shutdown();
+    return SUCCESS;
+}
+
+PHP_RSHUTDOWN_FUNCTION(valkey_glide) {
+    valkey_glide_otel_request_shutdown();
+    valkey_glide_alloc_stats_request_shutdown();
+    valkey_glide_logger_request_shutdown();
     return SUCCESS;
 }
 
@@ -558,7 +652,7 @@ zend_module_entry valkey_glide_module_entry = {STANDARD_MODULE_HEADER,
                                                PHP_MINIT(valkey_glide),
                                                PHP_MSHUTDOWN(valkey_glide),
                                                NULL,
-                                               NULL,
+                                               PHP_RSHUTDOWN(valkey_glide),
                                                NULL,
                                                VALKEY_GLIDE_PHP_VERSION,
                                                STANDARD_MODULE_PROPERTIES};
@@ -576,6 +670,13 @@ void free_valkey_glide_object(zend_object* object) {
         valkey_glide->glide_client = NULL;
     }
 
+    /* Script load state dies with the connection it describes */
+    if (valkey_glide->loaded_scripts) {
+        zend_hash_destroy(valkey_glide->loaded_scripts);
+        FREE_HASHTABLE(valkey_glide->loaded_scripts);
+        valkey_glide->loaded_scripts = NULL;
+    }
+
     if (valkey_glide->opt_prefix) {
         efree(valkey_glide->opt_prefix);
         valkey_glide->opt_prefix     = NULL;
@@ -848,6 +949,8 @@ static int valkey_glide_create_connection(valkey_glide_object* valkey_glide,
 
     VALKEY_LOG_INFO("valkey_glide_create_connection", "ValkeyGlide client connected successfully");
     valkey_glide->glide_client = conn_resp->conn_ptr;
+    valkey_glide_async_set_coalesce_reads(valkey_glide->glide_client,
+                                          valkey_glide->opt_coalesce_reads);
 
     free_connection_response((ConnectionResponse*) conn_resp);
 
@@ -1020,6 +1123,42 @@ PHP_METHOD(ValkeyGlide, close) {
 GET_STATISTICS_METHOD_IMPL(ValkeyGlide)
 /* }}} */
 
+/* {{{ proto array ValkeyGlide::getLatencyStats(?string command = null) */
+GET_LATENCY_STATS_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlide::resetLatencyStats() */
+RESET_LATENCY_STATS_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::getSlowLog(int count = -1) */
+GET_SLOW_LOG_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlide::resetSlowLog() */
+RESET_SLOW_LOG_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::getAllocStats() */
+GET_ALLOC_STATS_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlide::resetAllocStats() */
+RESET_ALLOC_STATS_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto int ValkeyGlide::poll(float timeout = 0.0) */
+POLL_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlide::setSuspensionFactory(?callable factory) */
+SET_SUSPENSION_FACTORY_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto resource ValkeyGlide::getCompletionStream() */
+GET_COMPLETION_STREAM_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
 PHP_METHOD(ValkeyGlide, setOtelSamplePercentage) {
     zend_long percentage;
 
@@ -1041,6 +1180,38 @@ PHP_METHOD(ValkeyGlide, getOtelSamplePercentage) {
 }
 /* }}} */
 
+/* {{{ proto bool ValkeyGlide::setOtelTraceParent(?string traceparent) */
+PHP_METHOD(ValkeyGlide, setOtelTraceParent) {
+    zend_string* traceparent = NULL;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_STR_OR_NULL(traceparent)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (!valkey_glide_otel_set_trace_parent(traceparent ? ZSTR_VAL(traceparent) : NULL,
+                                            traceparent ? ZSTR_LEN(traceparent) : 0)) {
+        zend_throw_exception(
+            get_valkey_glide_exception_ce(), "Invalid W3C traceparent header", 0);
+        RETURN_THROWS();
+    }
+    RETURN_TRUE;
+}
+/* }}} */
+
+/* {{{ proto ?string ValkeyGlide::getOtelTraceParent() */
+PHP_METHOD(ValkeyGlide, getOtelTraceParent) {
+    const char* traceparent;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    traceparent = valkey_glide_otel_get_trace_parent();
+    if (traceparent) {
+        RETURN_STRING(traceparent);
+    }
+    RETURN_NULL();
+}
+/* }}} */
+
 /* {{{ proto string ValkeyGlide::updateConnectionPassword(string $password, bool $immediateAuth =
  * false)
  */
@@ -1337,6 +1508,23 @@ PHP_FUNCTION(valkey_glide_logger_debug) {
     valkey_glide_logger_debug(identifier, message);
 }
 
+/**
+ * PHP function: valkey_glide_logger_set_category_level(string $category, ?string $level): bool
+ */
+PHP_FUNCTION(valkey_glide_logger_set_category_level) {
+    char*  category;
+    size_t category_len;
+    char*  level     = NULL;
+    size_t level_len = 0;
+
+    ZEND_PARSE_PARAMETERS_START(2, 2)
+    Z_PARAM_STRING(category, category_len)
+    Z_PARAM_STRING_OR_NULL(level, level_len)
+    ZEND_PARSE_PARAMETERS_END();
+
+    RETURN_BOOL(valkey_glide_logger_set_category_level(category, level) == 0);
+}
+
 /**
  * PHP function: valkey_glide_logger_is_initialized(): bool
  */
@@ -1612,6 +1800,27 @@ static valkey_glide_advanced_base_client_configuration_t* _build_advanced_config
     advanced_config->connection_timeout = _determine_connection_timeout(params);
     advanced_config->tls_config         = _build_advanced_tls_config(params, is_cluster);
 
+    HashTable* advanced_config_ht = _get_advanced_config_ht(params);
+    if (advanced_config_ht) {
+        zval* async_io_val = zend_hash_str_find(
+            advanced_config_ht, VALKEY_GLIDE_ASYNC_IO, sizeof(VALKEY_GLIDE_ASYNC_IO) - 1);
+        advanced_config->async_io = async_io_val && zend_is_true(async_io_val);
+
+        /* The slow log is shared by every client in the process, like getStatistics() */
+        zval* slow_log_val = zend_hash_str_find(
+            advanced_config_ht, VALKEY_GLIDE_SLOW_LOG, sizeof(VALKEY_GLIDE_SLOW_LOG) - 1);
+        if (slow_log_val && Z_TYPE_P(slow_log_val) == IS_ARRAY) {
+            valkey_glide_slowlog_configure(Z_ARRVAL_P(slow_log_val));
+        }
+
+        /* Allocation profiling is process wide too, and stays on until turned off */
+        zval* alloc_stats_val = zend_hash_str_find(
+            advanced_config_ht, VALKEY_GLIDE_ALLOC_STATS, sizeof(VALKEY_GLIDE_ALLOC_STATS) - 1);
+        if (alloc_stats_val) {
+            valkey_glide_alloc_stats_configure(zend_is_true(alloc_stats_val));
+        }
+    }
+
     /* If TLS config build failed (exception thrown), clean up and return NULL */
     if (EG(exception)) {
         efree(advanced_config);
@@ -419,6 +419,65 @@ class ValkeyGlide
      */
     public const OPT_PACK_IGNORE_NUMBERS = UNKNOWN;
 
+    /**
+     * Runtime option: Coalesce identical read commands.
+     * When enabled, repeated idempotent reads (GET, HGETALL, SMEMBERS, ZRANGE, ...)
+     * with the same arguments inside multi()/pipeline() are sent once and share the
+     * decoded reply. Any other command in between starts a new coalescing window.
+     * On a client connected with advanced_config ['async_io' => true], a read issued
+     * from a Fiber while an identical read is still in flight waits for that reply
+     * instead of being sent again, so a cache stampede costs one round trip.
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_OPT_COALESCE_READS
+     */
+    public const OPT_COALESCE_READS = UNKNOWN;
+
+    /**
+     * Runtime option: Return numeric array replies as packed binary columns instead of
+     * PHP arrays. zMscore() returns one native-endian float64 per member and geopos() a
+     * longitude, latitude float64 pair per member; read them with unpack('d*', $reply).
+     * Missing members are NAN.
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_OPT_PACKED_NUMERICS
+     */
+    public const OPT_PACKED_NUMERICS = UNKNOWN;
+
+    /**
+     * eval()/fcall() $decode flag: Map replies (RESP3 tables) become key => value arrays.
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SCRIPT_DECODE_MAPS
+     */
+    public const SCRIPT_DECODE_MAPS = UNKNOWN;
+
+    /**
+     * eval()/fcall() $decode flag: Flat arrays of even length whose even elements are all
+     * strings or integers, [k1, v1, k2, v2], become [k1 => v1, k2 => v2].
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SCRIPT_DECODE_PAIRS
+     */
+    public const SCRIPT_DECODE_PAIRS = UNKNOWN;
+
+    /**
+     * eval()/fcall() $decode flag: Numeric strings become int or float. Only the canonical
+     * spelling decodes, so '007', '+1', ' 1' and out of range integers stay strings.
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SCRIPT_DECODE_NUMERIC
+     */
+    public const SCRIPT_DECODE_NUMERIC = UNKNOWN;
+
+    /**
+     * eval()/fcall() $decode flags: All of the SCRIPT_DECODE_* conversions.
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SCRIPT_DECODE_ALL
+     */
+    public const SCRIPT_DECODE_ALL = UNKNOWN;
+
     /**
      * @var int
      * @cvalue VALKEY_GLIDE_SERIALIZER_NONE
@@ -549,7 +608,8 @@ class ValkeyGlide
      * @param int|null $database_id Database number (0-15 for standalone)
      * @param string|null $client_name Client identifier for debugging
      * @param string|null $client_az Availability zone for routing
-     * @param array|null $advanced_config Advanced TLS/connection settings
+     * @param array|null $advanced_config Advanced TLS/connection settings, e.g. ['async_io' => true] to yield Fibers on I/O.
+     *                                   async_io opens a second connection per client (per node for clusters) for Fiber commands.
      * @param bool|null $lazy_connect Defer connection until first command (default: false)
      * @param resource|array|null $context Stream context resource or array for TLS configuration
      * @param array|null $compression Compression configuration: ['enabled' => true, 'backend' => COMPRESSION_BACKEND_ZSTD, 'compression_level' => 3, 'min_compression_size' => 64]
@@ -826,6 +886,157 @@ class ValkeyGlide
      */
     public function getStatistics(): array;
 
+    /**
+     * Get client-side latency percentiles per command.
+     *
+     * Every command sent through this extension is timed around the call into the core and
+     * recorded in a histogram for the method that issued it, so eval() and rawCommand() are
+     * kept apart even though both send custom commands. Methods of helper classes are labelled
+     * "Class::method" (e.g. "ValkeyGlideScript::run"). Values are in microseconds and within
+     * ~6% of the true latency. Like getStatistics(), the numbers are shared by all clients in
+     * the process.
+     *
+     * @param string|null $command Method name (case-insensitive), or null for all commands
+     * @return array For one command: count, min_us, mean_us, p50_us, p90_us, p99_us, p999_us
+     *               and max_us (empty if it never ran). Without a command: those arrays keyed
+     *               by method name.
+     *
+     * @example
+     * $client->get('key');
+     * $get = $client->getLatencyStats('get');
+     * printf("GET p99: %.1fus over %d calls\n", $get['p99_us'], $get['count']);
+     */
+    public function getLatencyStats(?string $command = null): array;
+
+    /**
+     * Clear the latency histograms reported by getLatencyStats().
+     *
+     * @return bool Always true
+     */
+    public function resetLatencyStats(): bool;
+
+    /**
+     * Get the client-side slow log.
+     *
+     * Enabled by connecting with advanced_config ['slow_log' => ['threshold_us' => 10000]].
+     * Optional settings are max_len (entries kept, default 128), hash_keys (record a hash
+     * instead of the key) and log (also report each entry through the glide logger at WARN).
+     * Like getLatencyStats(), the log is shared by all clients in the process.
+     *
+     * @param int $count Number of entries to return, or -1 for all of them
+     * @return array Entries, newest first, each with id, timestamp, duration_us, command,
+     *               request_type, key (the first key), key_len, slot, argc, payload_bytes,
+     *               reply_size (bytes of a string reply, elements of an aggregate) and route
+     *               (the explicit cluster route, if any). key and slot are null for commands
+     *               that do not lead with a key, such as eval() or rawCommand().
+     *
+     * @example
+     * foreach ($client->getSlowLog(10) as $entry) {
+     *     printf("%s %s took %.0fus\n", $entry['command'], $entry['key'], $entry['duration_us']);
+     * }
+     */
+    public function getSlowLog(int $count = -1): array;
+
+    /**
+     * Clear the slow log reported by getSlowLog().
+     *
+     * @return bool Always true
+     */
+    public function resetSlowLog(): bool;
+
+    /**
+     * Get the allocation profile of the commands issued so far.
+     *
+     * Enabled by connecting with advanced_config ['alloc_stats' => true]; every client method
+     * then counts the Zend allocations (emalloc/efree) it makes, split into argument
+     * preparation, the call into the core and reply conversion. Counting slows every method
+     * down, so this is meant for benchmarks and CI, not production. Like getLatencyStats(), the
+     * counts are shared by all clients in the process. Methods that are batched or never
+     * reach the server are not reported. Neither are calls that can suspend, as other fibers
+     * would allocate in the meantime: anything called inside a Fiber, or on a client with
+     * async_io enabled (and any client method those are nested in).
+     *
+     * @return array Keyed by method name, each with request_type, calls, prepare, execute and
+     *               convert (each ['allocs' => int, 'frees' => int, 'bytes' => int]),
+     *               allocs_per_call and bytes_per_call.
+     *
+     * @example
+     * $client->get('key');
+     * $client->getAllocStats()['get']['prepare']['allocs'];
+     */
+    public function getAllocStats(): array;
+
+    /**
+     * Clear the counts reported by getAllocStats().
+     *
+     * @return bool Always true
+     */
+    public function resetAllocStats(): bool;
+
+    /**
+     * Resume Fibers whose replies have arrived.
+     *
+     * Only meaningful for clients connected with advanced_config ['async_io' => true]. On such
+     * a client, commands issued from inside a Fiber or a Swoole/OpenSwoole coroutine are sent
+     * without blocking the process and the caller is suspended until its reply arrives. The
+     * code driving them calls poll() to resume every caller whose reply is ready.
+     *
+     * The Fiber path uses a second connection, so async_io doubles the connections a client
+     * opens. select(), updateConnectionPassword() and clearConnectionPassword() are applied to
+     * both connections. While a WATCH is active, until exec() of a multi() or unwatch(), every
+     * command blocks on the connection holding the watch.
+     *
+     * @param float $timeout Seconds to wait for the first reply (0 returns immediately)
+     * @return int Number of replies delivered
+     *
+     * @example
+     * $client->connect(addresses: [['host' => 'localhost', 'port' => 6379]],
+     *                  advanced_config: ['async_io' => true]);
+     * $fibers = [];
+     * foreach (['a', 'b', 'c'] as $key) {
+     *     $fibers[$key] = new Fiber(fn() => $client->get($key));
+     *     $fibers[$key]->start();
+     * }
+     * while (array_filter($fibers, fn($f) => !$f->isTerminated())) {
+     *     $client->poll(0.1);
+     * }
+     */
+    public function poll(float $timeout = 0.0): int;
+
+    /**
+     * Install a suspension factory so an event loop owns Fiber scheduling.
+     *
+     * The factory is called once per command and must return an object with suspend() and
+     * resume(mixed $value) methods, e.g. Revolt's EventLoop::getSuspension(). While a factory
+     * is installed every command takes the non-blocking path, including those made from the
+     * main Fiber. Pass null to remove it.
+     *
+     * @param callable|null $factory Callable returning a suspension object
+     * @return bool False if the client was not connected with async_io
+     *
+     * @example
+     * $client->setSuspensionFactory(fn() => \Revolt\EventLoop::getSuspension());
+     */
+    public function setSuspensionFactory(?callable $factory): bool;
+
+    /**
+     * Get a stream that becomes readable whenever poll() has replies to deliver.
+     *
+     * Backed by an eventfd on Linux and a pipe elsewhere. Register it with the event loop so
+     * poll() runs only when there is work, instead of on a timer.
+     *
+     * @return resource|false Read-only stream, or false without async_io (or on Windows)
+     *
+     * @example
+     * // Swoole / OpenSwoole
+     * Swoole\Event::add($client->getCompletionStream(), fn() => $client->poll());
+     * go(fn() => var_dump($client->get('key')));
+     *
+     * // Revolt
+     * EventLoop::onReadable($client->getCompletionStream(), fn() => $client->poll());
+     */
+    public function getCompletionStream(): mixed;
+
     /**
      * Set the OpenTelemetry sample percentage at runtime.
      *
@@ -841,6 +1052,29 @@ class ValkeyGlide
      */
     public static function getOtelSamplePercentage(): ?int;
 
+    /**
+     * Follow the sampling decision of the application's current trace.
+     *
+     * Takes a W3C traceparent header ("00-<trace-id>-<parent-id>-<flags>"). While it is set,
+     * the upstream sampling decision is honoured: when the sampled flag is clear no spans are
+     * created at all, otherwise the usual sample percentages apply. Client spans are not
+     * stitched into the upstream trace: the core only parents spans to spans it created
+     * itself and cannot adopt an external trace and span id, so they remain root spans. The
+     * context is cleared at the end of every request.
+     *
+     * @param string|null $traceparent The traceparent header, or null to detach
+     * @return bool True on success
+     * @throws ValkeyGlideException if the header is malformed
+     */
+    public static function setOtelTraceParent(?string $traceparent): bool;
+
+    /**
+     * Get the traceparent set with setOtelTraceParent().
+     *
+     * @return string|null The traceparent header, or null if none is set
+     */
+    public static function getOtelTraceParent(): ?string;
+
     /**
      * Update the connection password.
      *
@@ -1044,11 +1278,15 @@ class ValkeyGlide
      * @param int    $num_keys How many of the arguments are keys.  This is needed
      *                         as Valkey distinguishes between key name arguments
      *                         and other data.
+     * @param int    $decode   ValkeyGlide::SCRIPT_DECODE_* flags applied to the whole reply
+     *                         while it is converted, e.g. SCRIPT_DECODE_PAIRS | SCRIPT_DECODE_NUMERIC
+     *                         to return a Lua table built as {k1, v1, k2, v2} as [k1 => v1, ...]
+     *                         with numbers instead of numeric strings.
      *
      * @return mixed Lua scripts may return arbitrary data so this method can return
      *               strings, arrays, nested arrays, etc.
      */
-    public function eval(string $script, array $args = [], int $num_keys = 0): mixed;
+    public function eval(string $script, array $args = [], int $num_keys = 0, int $decode = 0): mixed;
 
     /**
      * Execute a LUA script on the server but instead of sending the script, send
@@ -1060,6 +1298,7 @@ class ValkeyGlide
      *                           with `EVAL` first.
      * @param array  $args       Arguments to send to the script.
      * @param int    $num_keys   The number of arguments that are keys
+     * @param int    $decode     ValkeyGlide::SCRIPT_DECODE_* flags, see ValkeyGlide::eval().
      *
      * @return mixed Returns whatever the specific script does.
      *
@@ -1067,7 +1306,7 @@ class ValkeyGlide
      * @see ValkeyGlide::eval();
      *
      */
-    public function evalsha(string $sha1, array $args = [], int $num_keys = 0): mixed;
+    public function evalsha(string $sha1, array $args = [], int $num_keys = 0, int $decode = 0): mixed;
 
     /**
      * Execute a read-only Lua script on the server.
@@ -1075,6 +1314,7 @@ class ValkeyGlide
      * @param string $script   A string containing the LUA script
      * @param array  $args     An array of arguments to pass to this script
      * @param int    $num_keys How many of the arguments are keys.
+     * @param int    $decode   ValkeyGlide::SCRIPT_DECODE_* flags, see ValkeyGlide::eval().
      *
      * @return mixed Lua scripts may return arbitrary data so this method can return
      *               strings, arrays, nested arrays, etc.
@@ -1082,7 +1322,7 @@ class ValkeyGlide
      * @see https://valkey.io/commands/eval_ro/
      * @see ValkeyGlide::eval();
      */
-    public function eval_ro(string $script, array $args = [], int $num_keys = 0): mixed;
+    public function eval_ro(string $script, array $args = [], int $num_keys = 0, int $decode = 0): mixed;
 
     /**
      * Execute a read-only Lua script on the server using SHA1 hash.
@@ -1090,13 +1330,14 @@ class ValkeyGlide
      * @param string $sha1     The SHA1 hash of the lua code.
      * @param array  $args     Arguments to send to the script.
      * @param int    $num_keys The number of arguments that are keys
+     * @param int    $decode   ValkeyGlide::SCRIPT_DECODE_* flags, see ValkeyGlide::eval().
      *
      * @return mixed Returns whatever the specific script does.
      *
      * @see https://valkey.io/commands/evalsha_ro/
      * @see ValkeyGlide::evalsha();
      */
-    public function evalsha_ro(string $sha1, array $args = [], int $num_keys = 0): mixed;
+    public function evalsha_ro(string $sha1, array $args = [], int $num_keys = 0, int $decode = 0): mixed;
 
     /**
      * Execute either a MULTI or PIPELINE block and return the array of replies.
@@ -1118,6 +1359,74 @@ class ValkeyGlide
      */
     public function exec(): ValkeyGlide|array|false;
 
+    /**
+     * Load many keys through pipelined chunks without a PHP method call per key.
+     *
+     * Rows come from an array or generator, either as `key => value` pairs or as
+     * `[key, value]` tuples. A row is a tuple when it is a two entry list whose second entry
+     * is a scalar for set, or an array for the other commands. SET values must be scalars and
+     * collection values arrays of scalars, otherwise a TypeError is thrown. Each chunk of rows is sent as one non-atomic pipeline. When the
+     * client was connected with advanced_config ['async_io' => true] up to `window` chunks
+     * are in flight at once, otherwise chunks are sent one after another.
+     *
+     * @param iterable $rows Rows to load
+     * @param array    $spec Options:
+     *   - command: 'set' (default), 'hset' (value: field => value), 'sadd' or 'rpush'
+     *     (value: list of members), 'zadd' (value: member => score)
+     *   - chunk_size: Rows per pipeline (default 1000)
+     *   - window: Chunks in flight at once (default 4, max 64, needs async_io)
+     *   - ttl: Expiry in seconds applied to every key (SET EX, otherwise an EXPIRE per key)
+     *
+     * @return array|false Totals (rows, commands, chunks, errors, seconds, rows_per_sec) and
+     *                     chunk_stats, one entry per chunk with rows, commands, errors,
+     *                     seconds and the first error message (or null).
+     *
+     * @example
+     * $gen = (function () {
+     *     for ($i = 0; $i < 1000000; $i++) {
+     *         yield "user:$i" => ['name' => "n$i", 'visits' => 0];
+     *     }
+     * })();
+     * $stats = $valkey_glide->bulkLoad($gen, ['command' => 'hset', 'chunk_size' => 5000]);
+     * printf("%d rows, %d errors, %.0f rows/s\n", $stats['rows'], $stats['errors'],
+     *        $stats['rows_per_sec']);
+     */
+    public function bulkLoad(iterable $rows, array $spec = []): array|false;
+
+    /**
+     * Copy keys to another client with pipelined DUMP and RESTORE ... ABSTTL.
+     *
+     * Keys are read in batches: one pipeline of DUMP + PEXPIRETIME on this client, then one
+     * pipeline of RESTORE on the destination, so expiries carry over as absolute times.
+     * Either side may be a cluster client. At most one batch of payloads is held at a time;
+     * when the destination was connected with advanced_config ['async_io' => true] its
+     * RESTOREs overlap with the next batch of DUMPs. Requires Valkey 7.0+ (PEXPIRETIME).
+     *
+     * @param ValkeyGlide|ValkeyGlideCluster $dst  Destination client
+     * @param iterable                       $keys Keys to migrate (array or generator)
+     * @param array                          $opts Options:
+     *   - batch_size: Keys per pipeline (default 100)
+     *   - replace: Overwrite existing keys on the destination (default true)
+     *   - delete: UNLINK each key from this client once restored (default false)
+     *   - progress: callable(array $stats) invoked after every batch
+     *
+     * @return array|false keys, migrated, missing (gone before DUMP), errors, bytes, batches,
+     *                     seconds, keys_per_sec and last_error.
+     *
+     * @example
+     * $keys = (function () use ($src) {
+     *     $it = null;
+     *     while (($batch = $src->scan($it, 'user:*', 1000)) !== false) {
+     *         yield from $batch;
+     *     }
+     * })();
+     * $stats = $src->migrateKeys($dst, $keys, [
+     *     'batch_size' => 500,
+     *     'progress'   => fn($s) => printf("%d keys, %.0f/s\n", $s['migrated'], $s['keys_per_sec']),
+     * ]);
+     */
+    public function migrateKeys(object $dst, iterable $keys, array $opts = []): array|false;
+
     /**
      * Test if one or more keys exist.
      *
@@ -1217,13 +1526,37 @@ class ValkeyGlide
      * @param string $fn    The name of the function
      * @param array  $keys  Optional list of keys
      * @param array  $args  Optional list of args
+     * @param int    $decode ValkeyGlide::SCRIPT_DECODE_* flags, see ValkeyGlide::eval(). Map
+     *                      replies always decode as key => value.
      *
      * @return mixed        Function may return arbitrary data so this method can return
      *                      strings, arrays, nested arrays, etc.
      *
      * @see https://valkey.io/commands/fcall
      */
-    public function fcall(string $fn, array $keys = [], array $args = []): mixed;
+    public function fcall(string $fn, array $keys = [], array $args = [], int $decode = 0): mixed;
+
+    /**
+     * Resolve a loaded function once and return a handle to call it with.
+     *
+     * The function's flags are read with FUNCTION LIST, so calls through the handle use
+     * FCALL_RO for functions registered with 'no-writes' and FCALL otherwise, and
+     * ValkeyGlideFunction::callMany() sends many calls in one pipeline.
+     *
+     * @param string $lib  The library the function was registered in.
+     * @param string $name The name of the function.
+     *
+     * @return ValkeyGlideFunction|false The function handle.
+     * @throws ValkeyGlideException If the function is not loaded, or the client is in multi()
+     *                              or pipeline().
+     *
+     * @see https://valkey.io/commands/function-list
+     *
+     * @example
+     * $get = $valkey_glide->prepareFunction('mylib', 'get');
+     * $values = $get->callMany([[['key1'], []], [['key2'], []]]);
+     */
+    public function prepareFunction(string $lib, string $name): ValkeyGlideFunction|false;
 
     /**
      * This is a read-only variant of the FCALL command that cannot execute commands that modify data.
@@ -1231,13 +1564,15 @@ class ValkeyGlide
      * @param string $fn    The name of the function
      * @param array  $keys  Optional list of keys
      * @param array  $args  Optional list of args
+     * @param int    $decode ValkeyGlide::SCRIPT_DECODE_* flags, see ValkeyGlide::eval(). Map
+     *                      replies always decode as key => value.
      *
      * @return mixed        Function may return arbitrary data so this method can return
      *                      strings, arrays, nested arrays, etc.
      *
      * @see https://valkey.io/commands/fcall_ro
      */
-    public function fcall_ro(string $fn, array $keys = [], array $args = []): mixed;
+    public function fcall_ro(string $fn, array $keys = [], array $args = [], int $decode = 0): mixed;
 
     /**
      * Deletes every key in all ValkeyGlide databases
@@ -1366,9 +1701,35 @@ class ValkeyGlide
      * @param string          $unit     The unit of our shape.  See {@link ValkeyGlide::geodist} for possible units.
      * @param array           $options  @see {@link ValkeyGlide::georadius} for options.  Note that the `STORE`
      *                                  options are not allowed for this command.
+     *                                  'columns' => true returns parallel lists instead of
+     *                                  rows keyed by member: ['names' => [...], 'distances' => [...],
+     *                                  'hash' => [...], 'lon' => [...], 'lat' => [...]], holding only
+     *                                  the requested WITH* columns.
      */
     public function geosearch(string $key, array|string $position, array|int|float $shape, string $unit, array $options = []): array;
 
+    /**
+     * Merge GEOSEARCH results that are each sorted by distance, e.g. one search per shard, into one
+     * result in distance order.
+     *
+     * @param array $results A list of geosearch() results searched WITHDIST, either rows keyed by
+     *                       member or the parallel columns of the 'columns' option.
+     * @param int   $count   Keep only the first $count members, -1 for all of them.
+     * @param bool  $desc    The results are sorted DESC rather than ASC.
+     *
+     * @return array A result of the same shape. A member present in several results is kept once.
+     *
+     * @throws ValkeyGlideException If a result has no distances, rows and columns are mixed or
+     *                              count is neither positive nor -1.
+     *
+     * @example
+     * $near = ValkeyGlide::geosearchMerge([
+     *     $valkey_glide->geosearch('{eu}places', [2.35, 48.85], 50, 'km', ['WITHDIST', 'ASC']),
+     *     $valkey_glide->geosearch('{us}places', [2.35, 48.85], 50, 'km', ['WITHDIST', 'ASC']),
+     * ], 10);
+     */
+    public static function geosearchMerge(array $results, int $count = -1, bool $desc = false): array;
+
     /**
      * Search a geospacial sorted set for members within a given area or range, storing the results into
      * a new set.
@@ -1563,6 +1924,36 @@ class ValkeyGlide
      */
     public function hGetAll(string $key): ValkeyGlide|array|false;
 
+    /**
+     * Read a large hash in pages with HSCAN instead of one HGETALL reply.
+     *
+     * A single HGETALL of a very large hash blocks the server while the reply is built and
+     * holds the whole reply and the whole PHP array at once. The returned iterator yields one
+     * page per step, so memory stays bounded by the chunk size. With advanced_config
+     * ['async_io' => true] the HSCAN for the next page is sent before the current page is
+     * handed out, keeping one request in flight. Without it, that HSCAN runs synchronously
+     * while the iterator advances, so each step waits for a round trip. Every HSCAN is
+     * counted under hGetAllChunked in getLatencyStats(), the slow log and traces.
+     *
+     * HSCAN may return a field more than once if the hash is modified while it is read.
+     *
+     * @param string $key      The hash to read.
+     * @param int    $chunk    COUNT hint per HSCAN (default 1000).
+     * @param bool   $novalues Yield lists of fields only (HSCAN NOVALUES, Valkey 8.0+).
+     *
+     * @return ValkeyGlideHashChunks|false An iterator of pages keyed 0, 1, 2, ...
+     *
+     * @see https://valkey.io/commands/hscan
+     *
+     * @example
+     * foreach ($valkey_glide->hGetAllChunked('big-hash', 5000) as $page) {
+     *     foreach ($page as $field => $value) {
+     *         echo "$field => $value\n";
+     *     }
+     * }
+     */
+    public function hGetAllChunked(string $key, int $chunk = 1000, bool $novalues = false): ValkeyGlideHashChunks|false;
+
     /**
      * Increment a hash field's value by an integer
      *
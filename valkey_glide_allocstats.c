@@ -0,0 +1,360 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+
+#include "valkey_glide_allocstats.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "valkey_glide_async.h"
+#include "zend_execute.h"
+
+#define ALLOC_MAX_TYPES 2048 /* Upper bound on RequestType values we index directly */
+#define ALLOC_MAX_DEPTH 8    /* Nested method calls (e.g. from subscribe callbacks) measured */
+#define ALLOC_NAME_LEN 64
+#define ALLOC_NO_TYPE -1
+
+typedef struct {
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t bytes;
+} alloc_counts_t;
+
+typedef struct {
+    uint64_t             calls;
+    alloc_counts_t       phases[VALKEY_GLIDE_ALLOC_PHASES];
+    const zend_function* method; /* Method measured */
+    int                  command_type;
+    char                 name[ALLOC_NAME_LEN];
+} alloc_stats_t;
+
+/* A method call being measured */
+typedef struct {
+    int                        command_type; /* ALLOC_NO_TYPE until the method reaches the FFI */
+    valkey_glide_alloc_phase_t phase;
+    alloc_counts_t             phases[VALKEY_GLIDE_ALLOC_PHASES];
+} alloc_call_t;
+
+ZEND_TLS bool valkey_glide_alloc_stats_active = false;
+
+/* One entry per method and request type: CustomCommand alone carries eval, rawCommand and
+ * more, so the request type is not a label by itself */
+ZEND_TLS alloc_stats_t** alloc_entries;
+ZEND_TLS size_t          alloc_entry_count;
+ZEND_TLS size_t          alloc_entry_cap;
+
+/* Entry each request type was last added to, so the usual lookup is one compare */
+ZEND_TLS alloc_stats_t* alloc_by_type[ALLOC_MAX_TYPES];
+ZEND_TLS alloc_call_t   alloc_calls[ALLOC_MAX_DEPTH];
+ZEND_TLS int            alloc_depth = 0;
+ZEND_TLS zend_mm_heap*  alloc_heap;
+ZEND_TLS uint32_t       alloc_generation; /* Bumped whenever in-flight calls are dropped */
+
+/* zend_execute_internal is process wide, so is the switch that routes calls through us */
+static bool alloc_enabled = false;
+static void (*alloc_prev_execute_internal)(zend_execute_data* execute_data, zval* return_value);
+
+/* Zend MM handlers: count against the innermost call's phase and forward to the real heap */
+static void* alloc_malloc(size_t size ZEND_FILE_LINE_DC ZEND_FILE_LINE_ORIG_DC) {
+    alloc_call_t* call = &alloc_calls[alloc_depth - 1];
+
+    call->phases[call->phase].allocs++;
+    call->phases[call->phase].bytes += size;
+    return _zend_mm_alloc(alloc_heap, size ZEND_FILE_LINE_RELAY_CC ZEND_FILE_LINE_ORIG_RELAY_CC);
+}
+
+static void alloc_free(void* ptr ZEND_FILE_LINE_DC ZEND_FILE_LINE_ORIG_DC) {
+    alloc_call_t* call = &alloc_calls[alloc_depth - 1];
+
+    call->phases[call->phase].frees++;
+    _zend_mm_free(alloc_heap, ptr ZEND_FILE_LINE_RELAY_CC ZEND_FILE_LINE_ORIG_RELAY_CC);
+}
+
+static void* alloc_realloc(void* ptr, size_t size ZEND_FILE_LINE_DC ZEND_FILE_LINE_ORIG_DC) {
+    alloc_call_t* call = &alloc_calls[alloc_depth - 1];
+
+    call->phases[call->phase].allocs++;
+    call->phases[call->phase].bytes += size;
+    return _zend_mm_realloc(
+        alloc_heap, ptr, size ZEND_FILE_LINE_RELAY_CC ZEND_FILE_LINE_ORIG_RELAY_CC);
+}
+
+static void alloc_call_internal(zend_execute_data* execute_data, zval* return_value) {
+    if (alloc_prev_execute_internal) {
+        alloc_prev_execute_internal(execute_data, return_value);
+    } else {
+        execute_internal(execute_data, return_value);
+    }
+}
+
+static alloc_stats_t* alloc_stats_find(const zend_function* method, int command_type) {
+    alloc_stats_t* stats;
+    size_t         i;
+
+    for (i = 0; i < alloc_entry_count; i++) {
+        stats = alloc_entries[i];
+        if (stats->method == method && stats->command_type == command_type) {
+            return stats;
+        }
+    }
+
+    if (alloc_entry_count == alloc_entry_cap) {
+        size_t          cap  = alloc_entry_cap ? alloc_entry_cap * 2 : 32;
+        alloc_stats_t** grow = realloc(alloc_entries, cap * sizeof(*grow));
+        if (!grow) {
+            return NULL;
+        }
+        alloc_entries   = grow;
+        alloc_entry_cap = cap;
+    }
+    if (!(stats = calloc(1, sizeof(alloc_stats_t)))) {
+        return NULL;
+    }
+    stats->method       = method;
+    stats->command_type = command_type;
+    valkey_glide_method_label(method, stats->name, ALLOC_NAME_LEN);
+
+    alloc_entries[alloc_entry_count++] = stats;
+    return stats;
+}
+
+static void alloc_stats_add(const alloc_call_t* call, zend_execute_data* execute_data) {
+    alloc_stats_t* stats;
+    int            phase;
+
+    if ((unsigned) call->command_type >= ALLOC_MAX_TYPES) {
+        return;
+    }
+    stats = alloc_by_type[call->command_type];
+    if (UNEXPECTED(!stats || stats->method != execute_data->func)) {
+        if (!(stats = alloc_stats_find(execute_data->func, call->command_type))) {
+            return;
+        }
+        alloc_by_type[call->command_type] = stats;
+    }
+
+    stats->calls++;
+    for (phase = 0; phase < VALKEY_GLIDE_ALLOC_PHASES; phase++) {
+        stats->phases[phase].allocs += call->phases[phase].allocs;
+        stats->phases[phase].frees += call->phases[phase].frees;
+        stats->phases[phase].bytes += call->phases[phase].bytes;
+    }
+}
+
+/* Stop counting after the outermost measured call, or after a bailout skipped its epilogue */
+static void alloc_uninstall(void) {
+    if (alloc_depth > 0) {
+        zend_mm_set_custom_handlers(alloc_heap, NULL, NULL, NULL);
+    }
+    alloc_depth                     = 0;
+    valkey_glide_alloc_stats_active = false;
+    alloc_generation++;
+}
+
+/* A call that can suspend (async_io, or any call made inside a Fiber) lets other fibers run and
+ * allocate while its frame is the innermost one */
+static bool alloc_call_may_suspend(zend_execute_data* execute_data) {
+    valkey_glide_object* valkey_glide;
+
+    if (EG(active_fiber)) {
+        return true;
+    }
+    if (Z_TYPE(execute_data->This) != IS_OBJECT) {
+        return false;
+    }
+    valkey_glide = VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_object, Z_OBJ(execute_data->This));
+    return valkey_glide->glide_client && valkey_glide_async_lookup(valkey_glide->glide_client);
+}
+
+static void alloc_execute_internal(zend_execute_data* execute_data, zval* return_value) {
+    zend_class_entry* scope = execute_data->func->common.scope;
+    alloc_call_t*     call;
+    uint32_t          generation;
+
+    if (!alloc_enabled ||
+        (scope != get_valkey_glide_ce() && scope != get_valkey_glide_cluster_ce())) {
+        alloc_call_internal(execute_data, return_value);
+        return;
+    }
+
+    /* Counts live on one stack per thread, so a call that can suspend is not measured, and
+     * neither are the calls it is nested in */
+    if (alloc_call_may_suspend(execute_data)) {
+        if (alloc_depth > 0) {
+            alloc_uninstall();
+        }
+        alloc_call_internal(execute_data, return_value);
+        return;
+    }
+
+    /* Another allocator hook (USE_ZEND_ALLOC=0, memprof) takes precedence */
+    if (alloc_depth >= ALLOC_MAX_DEPTH ||
+        (alloc_depth == 0 && zend_mm_is_custom_heap(zend_mm_get_heap()))) {
+        alloc_call_internal(execute_data, return_value);
+        return;
+    }
+
+    call = &alloc_calls[alloc_depth];
+    memset(call, 0, sizeof(*call));
+    call->command_type = ALLOC_NO_TYPE;
+    call->phase        = VALKEY_GLIDE_ALLOC_PREPARE;
+    if (alloc_depth++ == 0) {
+        alloc_heap = zend_mm_get_heap();
+        zend_mm_set_custom_handlers(alloc_heap, alloc_malloc, alloc_free, alloc_realloc);
+        valkey_glide_alloc_stats_active = true;
+    }
+
+    generation = alloc_generation;
+    alloc_call_internal(execute_data, return_value);
+
+    /* Dropped while running (see above, or a bailout); the frame may be reused already */
+    if (generation != alloc_generation) {
+        return;
+    }
+
+    /* Methods that never reach the FFI (options, batch buffering, ...) are not reported */
+    if (call->command_type != ALLOC_NO_TYPE) {
+        alloc_stats_add(call, execute_data);
+    }
+    if (alloc_depth == 1) {
+        alloc_uninstall();
+    } else {
+        alloc_depth--;
+    }
+}
+
+void valkey_glide_alloc_stats_configure(bool enabled) {
+    if (enabled && !alloc_enabled) {
+        if (zend_execute_internal != alloc_execute_internal) {
+            alloc_prev_execute_internal = zend_execute_internal;
+            zend_execute_internal       = alloc_execute_internal;
+        }
+        alloc_enabled = true;
+    } else if (!enabled && alloc_enabled) {
+        /* Unhook unless another extension hooked in after us; the flag then keeps us inert */
+        if (zend_execute_internal == alloc_execute_internal) {
+            zend_execute_internal = alloc_prev_execute_internal;
+        }
+        alloc_enabled = false;
+    }
+}
+
+void valkey_glide_alloc_stats_enter(enum RequestType           command_type,
+                                    valkey_glide_alloc_phase_t phase) {
+    alloc_call_t* call;
+
+    if (alloc_depth == 0) {
+        return;
+    }
+    call               = &alloc_calls[alloc_depth - 1];
+    call->command_type = (int) command_type;
+    call->phase        = phase;
+}
+
+static void alloc_counts_to_zval(const alloc_counts_t* counts, zval* out) {
+    array_init_size(out, 3);
+    add_assoc_long(out, "allocs", (zend_long) counts->allocs);
+    add_assoc_long(out, "frees", (zend_long) counts->frees);
+    add_assoc_long(out, "bytes", (zend_long) counts->bytes);
+}
+
+/* Sum every entry labelled name, starting the scan at index first */
+static void alloc_merge_named(alloc_stats_t* into, const char* name, size_t first) {
+    size_t i;
+    int    phase;
+
+    memset(into, 0, sizeof(*into));
+    for (i = first; i < alloc_entry_count; i++) {
+        const alloc_stats_t* stats = alloc_entries[i];
+        if (stats->calls == 0 || strcmp(stats->name, name) != 0) {
+            continue;
+        }
+        into->calls += stats->calls;
+        for (phase = 0; phase < VALKEY_GLIDE_ALLOC_PHASES; phase++) {
+            into->phases[phase].allocs += stats->phases[phase].allocs;
+            into->phases[phase].frees += stats->phases[phase].frees;
+            into->phases[phase].bytes += stats->phases[phase].bytes;
+        }
+    }
+}
+
+void valkey_glide_alloc_stats_get(zval* return_value) {
+    static const char* const phase_names[VALKEY_GLIDE_ALLOC_PHASES] = {
+        "prepare", "execute", "convert"};
+    alloc_stats_t merged;
+    size_t        i;
+
+    array_init(return_value);
+    for (i = 0; i < alloc_entry_count; i++) {
+        const alloc_stats_t* stats  = alloc_entries[i];
+        uint64_t             allocs = 0;
+        uint64_t             bytes  = 0;
+        size_t               name_len;
+        zval                 entry, counts;
+        int                  phase;
+
+        if (stats->calls == 0) {
+            continue;
+        }
+        /* Several request types can sit behind one method (e.g. set with options), and client
+         * and cluster methods share a label */
+        name_len = strlen(stats->name);
+        if (zend_hash_str_exists(Z_ARRVAL_P(return_value), stats->name, name_len)) {
+            continue;
+        }
+        alloc_merge_named(&merged, stats->name, i);
+
+        array_init_size(&entry, 7);
+        add_assoc_long(&entry, "request_type", (zend_long) stats->command_type);
+        add_assoc_long(&entry, "calls", (zend_long) merged.calls);
+        for (phase = 0; phase < VALKEY_GLIDE_ALLOC_PHASES; phase++) {
+            alloc_counts_to_zval(&merged.phases[phase], &counts);
+            add_assoc_zval(&entry, phase_names[phase], &counts);
+            allocs += merged.phases[phase].allocs;
+            bytes += merged.phases[phase].bytes;
+        }
+        add_assoc_double(&entry, "allocs_per_call", (double) allocs / (double) merged.calls);
+        add_assoc_double(&entry, "bytes_per_call", (double) bytes / (double) merged.calls);
+        zend_hash_str_add_new(Z_ARRVAL_P(return_value), stats->name, name_len, &entry);
+    }
+}
+
+void valkey_glide_alloc_stats_reset(void) {
+    size_t i;
+
+    for (i = 0; i < alloc_entry_count; i++) {
+        memset(alloc_entries[i]->phases, 0, sizeof(alloc_entries[i]->phases));
+        alloc_entries[i]->calls = 0;
+    }
+}
+
+void valkey_glide_alloc_stats_request_shutdown(void) {
+    alloc_uninstall();
+}
+
+void valkey_glide_alloc_stats_shutdown(void) {
+    size_t i;
+
+    valkey_glide_alloc_stats_configure(false);
+    for (i = 0; i < alloc_entry_count; i++) {
+        free(alloc_entries[i]);
+    }
+    free(alloc_entries);
+    alloc_entries     = NULL;
+    alloc_entry_count = 0;
+    alloc_entry_cap   = 0;
+    memset(alloc_by_type, 0, sizeof(alloc_by_type));
+}
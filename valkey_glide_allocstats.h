@@ -0,0 +1,68 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_ALLOCSTATS_H
+#define VALKEY_GLIDE_ALLOCSTATS_H
+
+#include "include/glide_bindings.h"
+#include "php.h"
+
+/*
+ * Allocation profiling.
+ *
+ * When enabled with advanced_config ['alloc_stats' => true], every ValkeyGlide and
+ * ValkeyGlideCluster method call runs with Zend MM handlers that count emalloc/efree calls and
+ * bytes. The counts are split into the phases around the FFI call (argument preparation, the
+ * call itself, reply conversion) and attributed to the RequestType the method sent. Like the
+ * latency histograms, the stats are process (thread, under ZTS) wide.
+ */
+
+typedef enum {
+    VALKEY_GLIDE_ALLOC_PREPARE = 0, /* From method entry to the FFI call */
+    VALKEY_GLIDE_ALLOC_EXECUTE,     /* The FFI call, including async I/O and tracing */
+    VALKEY_GLIDE_ALLOC_CONVERT,     /* From the FFI call to method exit */
+    VALKEY_GLIDE_ALLOC_PHASES
+} valkey_glide_alloc_phase_t;
+
+/* True while a method call is being measured */
+extern ZEND_TLS bool valkey_glide_alloc_stats_active;
+
+/* Start (or stop) measuring method calls */
+void valkey_glide_alloc_stats_configure(bool enabled);
+
+/* Attribute the current method call to command_type and move it to phase */
+void valkey_glide_alloc_stats_enter(enum RequestType           command_type,
+                                    valkey_glide_alloc_phase_t phase);
+
+/* Called around the FFI call; a single branch while profiling is off */
+static inline void valkey_glide_alloc_stats_phase(enum RequestType           command_type,
+                                                  valkey_glide_alloc_phase_t phase) {
+    if (UNEXPECTED(valkey_glide_alloc_stats_active)) {
+        valkey_glide_alloc_stats_enter(command_type, phase);
+    }
+}
+
+/* Fill return_value with the counts of every method seen so far */
+void valkey_glide_alloc_stats_get(zval* return_value);
+
+/* Forget everything counted so far */
+void valkey_glide_alloc_stats_reset(void);
+
+/* Drop the allocator hook left behind by a method call that bailed out */
+void valkey_glide_alloc_stats_request_shutdown(void);
+
+/* Stop measuring and release the counters at module shutdown */
+void valkey_glide_alloc_stats_shutdown(void);
+
+#endif /* VALKEY_GLIDE_ALLOCSTATS_H */
@@ -0,0 +1,1055 @@
+/** Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0 */
+
+#include "valkey_glide_async.h"
+
+#include <php_streams.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zend_exceptions.h>
+#include <zend_fibers.h>
+#include <zend_interfaces.h>
+#include <zend_smart_str.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#endif
+
+#include "common.h"
+#include "logger.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_pubsub_common.h"
+
+/* One submitted request. Shared between the PHP thread (the waiting caller) and the
+ * core thread that runs the reply callback, hence the two references. A coalesced read is
+ * never submitted: it points at its leader and completes with the leader's reply. */
+struct valkey_glide_async_request {
+    valkey_glide_async_ctx*     ctx;
+    int                         refs; /* Waiting caller + core callback + results */
+    bool                        done;
+    bool                        queued;        /* Listed in ctx->ready */
+    CommandResponse*            response;      /* Released with free_command_response() */
+    char*                       error_message; /* Released with free_error_message() */
+    enum RequestErrorType       error_type;
+    zend_hrtime_t               completed;     /* When the reply arrived */
+    valkey_glide_async_request* leader;        /* Read this one shares the reply of, or NULL */
+    valkey_glide_async_request* followers;     /* Reads waiting on this one's reply */
+    valkey_glide_async_request* next_follower;
+    bool                        shared; /* Has had followers: its reply backs several calls */
+    zval waiter; /* Fiber, suspension or coroutine id to resume (PHP thread only) */
+};
+
+struct valkey_glide_async_ctx {
+    const void*                  client; /* Companion client created as AsyncClient */
+    mutex_t                      lock;
+    cond_t                       cond;
+    valkey_glide_async_request** ready; /* Completed requests poll() has not seen yet */
+    size_t                       ready_len;
+    size_t                       ready_cap;
+    size_t                       refs; /* Registry reference plus one per live request */
+    bool                         closed;
+    zval                         factory;        /* Suspension factory, IS_UNDEF when unset */
+    zend_class_entry*            coroutine_ce;   /* Swoole/OpenSwoole Coroutine, if loaded */
+    uint32_t                     pinned;         /* Nested valkey_glide_async_pin() calls */
+    bool                         watching;       /* WATCH is active on the blocking client */
+    bool                         coalesce_reads; /* OPT_COALESCE_READS: single-flight reads */
+    HashTable                    inflight;       /* Read key -> request in flight (PHP thread) */
+    int notify_fd[2]; /* Readable when replies are queued; both ends equal for eventfd */
+};
+
+/* The value decoded from a reply several coalesced reads share, so it is decoded once and
+ * handed to every caller as a copy-on-write zval. PHP thread only: it lives in
+ * async_decoded rather than on the request, whose last reference may drop on a core thread */
+typedef struct {
+    z_result_processor_t processor; /* Decoder value came from, NULL until the first decode */
+    int                  status;    /* What processor returned */
+    zval                 value;
+    uint32_t             results; /* Live results of the reply */
+} async_shared_decode;
+
+/* What execute_command() callers get back; starts with CommandResult so it can be cast.
+ * The response stays owned by the request it came from, which may be shared by several
+ * coalesced reads, so each result holds a reference on that request. */
+typedef struct {
+    CommandResult               result;
+    CommandError                error;
+    valkey_glide_async_request* source;
+    async_shared_decode*        shared; /* Set when source is shared */
+} valkey_glide_async_result;
+
+static HashTable async_clients; /* glide_client pointer -> valkey_glide_async_ctx* */
+static HashTable async_results; /* Live valkey_glide_async_result pointers */
+static HashTable async_decoded; /* Shared source request pointer -> async_shared_decode* */
+static bool      async_tables_initialized = false;
+
+static void async_inflight_dtor(zval* zv);
+
+static void async_tables_init(void) {
+    if (!async_tables_initialized) {
+        zend_hash_init(&async_clients, 8, NULL, NULL, 1);
+        zend_hash_init(&async_results, 16, NULL, NULL, 1);
+        zend_hash_init(&async_decoded, 8, NULL, NULL, 1);
+        async_tables_initialized = true;
+    }
+}
+
+static valkey_glide_async_ctx* async_find(const void* glide_client) {
+    if (!async_tables_initialized) {
+        return NULL;
+    }
+    return zend_hash_index_find_ptr(&async_clients, (zend_ulong) (uintptr_t) glide_client);
+}
+
+/* ====================================================================
+ * COMPLETION NOTIFICATION
+ * ==================================================================== */
+
+static void async_notify_open(valkey_glide_async_ctx* ctx) {
+    ctx->notify_fd[0] = ctx->notify_fd[1] = -1;
+#if defined(__linux__)
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd >= 0) {
+        ctx->notify_fd[0] = ctx->notify_fd[1] = fd;
+    }
+#elif !defined(_WIN32)
+    int fds[2];
+    if (pipe(fds) == 0) {
+        fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+        ctx->notify_fd[0] = fds[0];
+        ctx->notify_fd[1] = fds[1];
+    }
+#endif
+}
+
+static void async_notify_close(valkey_glide_async_ctx* ctx) {
+#ifndef _WIN32
+    if (ctx->notify_fd[1] >= 0 && ctx->notify_fd[1] != ctx->notify_fd[0]) {
+        close(ctx->notify_fd[1]);
+    }
+    if (ctx->notify_fd[0] >= 0) {
+        close(ctx->notify_fd[0]);
+    }
+#endif
+    ctx->notify_fd[0] = ctx->notify_fd[1] = -1;
+}
+
+/* Called from the core thread: a plain write() is all we may do here */
+static void async_notify_signal(valkey_glide_async_ctx* ctx) {
+#ifndef _WIN32
+    if (ctx->notify_fd[1] >= 0) {
+        uint64_t one = 1;
+        ssize_t  n;
+        /* EAGAIN means the counter/pipe is already readable, which is all we need */
+        do {
+            n = write(ctx->notify_fd[1], &one, ctx->notify_fd[0] == ctx->notify_fd[1] ? 8 : 1);
+        } while (n < 0 && errno == EINTR);
+    }
+#endif
+}
+
+static void async_notify_drain(valkey_glide_async_ctx* ctx) {
+#ifndef _WIN32
+    if (ctx->notify_fd[0] >= 0) {
+        char    buf[64];
+        ssize_t n;
+        do {
+            n = read(ctx->notify_fd[0], buf, sizeof(buf));
+        } while (n > 0 || (n < 0 && errno == EINTR));
+    }
+#endif
+}
+
+/* ====================================================================
+ * SWOOLE / OPENSWOOLE COROUTINES
+ * ==================================================================== */
+
+static zend_class_entry* async_coroutine_lookup(void) {
+    zend_class_entry* ce = zend_hash_str_find_ptr(
+        CG(class_table), "swoole\\coroutine", sizeof("swoole\\coroutine") - 1);
+    if (!ce) {
+        ce = zend_hash_str_find_ptr(
+            CG(class_table), "openswoole\\coroutine", sizeof("openswoole\\coroutine") - 1);
+    }
+    return ce;
+}
+
+/* Id of the running coroutine, or 0 when not inside one */
+static zend_long async_coroutine_id(valkey_glide_async_ctx* ctx) {
+    zval      retval;
+    zend_long cid = 0;
+
+    if (!ctx->coroutine_ce) {
+        return 0;
+    }
+    ZVAL_UNDEF(&retval);
+    zend_call_method_with_0_params(NULL, ctx->coroutine_ce, NULL, "getcid", &retval);
+    if (Z_TYPE(retval) == IS_LONG && Z_LVAL(retval) > 0) {
+        cid = Z_LVAL(retval);
+    }
+    zval_ptr_dtor(&retval);
+    return cid;
+}
+
+/* ====================================================================
+ * REFERENCE COUNTING (safe on any thread)
+ * ==================================================================== */
+
+static void async_ctx_release(valkey_glide_async_ctx* ctx) {
+    mutex_lock(&ctx->lock);
+    bool last = --ctx->refs == 0;
+    mutex_unlock(&ctx->lock);
+
+    if (last) {
+        mutex_destroy(&ctx->lock);
+        cond_destroy(&ctx->cond);
+        async_notify_close(ctx);
+        free(ctx->ready);
+        free(ctx);
+    }
+}
+
+static void async_request_release(valkey_glide_async_request* req) {
+    valkey_glide_async_ctx* ctx = req->ctx;
+
+    mutex_lock(&ctx->lock);
+    bool last = --req->refs == 0;
+    mutex_unlock(&ctx->lock);
+
+    if (!last) {
+        return;
+    }
+
+    if (req->response) {
+        free_command_response(req->response);
+    }
+    if (req->error_message) {
+        free_error_message(req->error_message);
+    }
+    if (req->leader) {
+        async_request_release(req->leader);
+    }
+    free(req);
+    async_ctx_release(ctx);
+}
+
+/* Caller must hold ctx->lock */
+static void async_unqueue_locked(valkey_glide_async_ctx* ctx, valkey_glide_async_request* req) {
+    size_t i;
+
+    if (!req->queued) {
+        return;
+    }
+    for (i = 0; i < ctx->ready_len; i++) {
+        if (ctx->ready[i] == req) {
+            memmove(&ctx->ready[i],
+                    &ctx->ready[i + 1],
+                    (ctx->ready_len - i - 1) * sizeof(valkey_glide_async_request*));
+            ctx->ready_len--;
+            break;
+        }
+    }
+    req->queued = false;
+}
+
+/* ====================================================================
+ * CORE CALLBACKS (run on a core worker thread: no Zend API here)
+ * ==================================================================== */
+
+/* Caller must hold ctx->lock */
+static void async_mark_done_locked(valkey_glide_async_ctx* ctx, valkey_glide_async_request* req) {
+    req->done      = true;
+    req->completed = zend_hrtime();
+
+    /* Only announce replies someone is still waiting for; ready_cap is sized on submit */
+    if (req->refs > 1 && !ctx->closed && ctx->ready_len < ctx->ready_cap) {
+        ctx->ready[ctx->ready_len++] = req;
+        req->queued                  = true;
+        async_notify_signal(ctx);
+    }
+}
+
+static void async_complete(uintptr_t             index_ptr,
+                           CommandResponse*      response,
+                           char*                 error_message,
+                           enum RequestErrorType error_type) {
+    valkey_glide_async_request* req = (valkey_glide_async_request*) index_ptr;
+    valkey_glide_async_ctx*     ctx = req->ctx;
+    valkey_glide_async_request* follower;
+
+    mutex_lock(&ctx->lock);
+    req->response      = response;
+    req->error_message = error_message;
+    req->error_type    = error_type;
+    async_mark_done_locked(ctx, req);
+
+    /* Coalesced reads complete with the same reply */
+    follower       = req->followers;
+    req->followers = NULL;
+    for (valkey_glide_async_request* f = follower; f; f = f->next_follower) {
+        async_mark_done_locked(ctx, f);
+    }
+    cond_signal(&ctx->cond);
+    mutex_unlock(&ctx->lock);
+
+    /* Drop the reference each follower kept for this callback */
+    while (follower) {
+        valkey_glide_async_request* next = follower->next_follower;
+        async_request_release(follower);
+        follower = next;
+    }
+    async_request_release(req);
+}
+
+static void async_on_success(uintptr_t index_ptr, const CommandResponse* message) {
+    async_complete(index_ptr, (CommandResponse*) message, NULL, (enum RequestErrorType) 0);
+}
+
+static void async_on_failure(uintptr_t             index_ptr,
+                             const char*           error_message,
+                             enum RequestErrorType error_type) {
+    async_complete(index_ptr, NULL, (char*) error_message, error_type);
+}
+
+/* ====================================================================
+ * CLIENT LIFECYCLE
+ * ==================================================================== */
+
+bool valkey_glide_async_attach(const void*    glide_client,
+                               const uint8_t* connection_request,
+                               size_t         connection_request_len) {
+    async_tables_init();
+
+    ClientType client_type;
+    client_type.tag                           = AsyncClient;
+    client_type.async_client.success_callback = async_on_success;
+    client_type.async_client.failure_callback = async_on_failure;
+
+    const ConnectionResponse* conn_resp = create_client(connection_request,
+                                                        connection_request_len,
+                                                        &client_type,
+                                                        valkey_glide_pubsub_callback);
+    if (!conn_resp) {
+        VALKEY_LOG_ERROR("async_io", "Failed to create async client");
+        return false;
+    }
+    if (conn_resp->connection_error_message) {
+        VALKEY_LOG_ERROR("async_io", conn_resp->connection_error_message);
+        free_connection_response((ConnectionResponse*) conn_resp);
+        return false;
+    }
+
+    valkey_glide_async_ctx* ctx = calloc(1, sizeof(valkey_glide_async_ctx));
+    if (!ctx) {
+        close_client(conn_resp->conn_ptr);
+        free_connection_response((ConnectionResponse*) conn_resp);
+        return false;
+    }
+
+    ctx->client       = conn_resp->conn_ptr;
+    ctx->refs         = 1;
+    ctx->coroutine_ce = async_coroutine_lookup();
+    zend_hash_init(&ctx->inflight, 8, NULL, async_inflight_dtor, 1);
+    mutex_init(&ctx->lock);
+    cond_init(&ctx->cond);
+    async_notify_open(ctx);
+    ZVAL_UNDEF(&ctx->factory);
+    free_connection_response((ConnectionResponse*) conn_resp);
+
+    zend_hash_index_update_ptr(&async_clients, (zend_ulong) (uintptr_t) glide_client, ctx);
+    VALKEY_LOG_DEBUG("async_io", "Async companion client attached");
+    return true;
+}
+
+void valkey_glide_async_detach(const void* glide_client) {
+    valkey_glide_async_ctx* ctx = async_find(glide_client);
+    size_t                  i;
+
+    if (!ctx) {
+        return;
+    }
+    zend_hash_index_del(&async_clients, (zend_ulong) (uintptr_t) glide_client);
+
+    mutex_lock(&ctx->lock);
+    ctx->closed = true;
+    for (i = 0; i < ctx->ready_len; i++) {
+        ctx->ready[i]->queued = false;
+    }
+    ctx->ready_len = 0;
+    mutex_unlock(&ctx->lock);
+
+    zval_ptr_dtor(&ctx->factory);
+    ZVAL_UNDEF(&ctx->factory);
+    zend_hash_destroy(&ctx->inflight);
+
+    /* Replies still in flight are released by their callbacks */
+    close_client(ctx->client);
+    async_ctx_release(ctx);
+}
+
+valkey_glide_async_ctx* valkey_glide_async_lookup(const void* glide_client) {
+    return async_find(glide_client);
+}
+
+valkey_glide_async_ctx* valkey_glide_async_route(const void* glide_client) {
+    if (EXPECTED(!async_tables_initialized || zend_hash_num_elements(&async_clients) == 0)) {
+        return NULL;
+    }
+
+    valkey_glide_async_ctx* ctx = async_find(glide_client);
+    if (!ctx || ctx->pinned || ctx->watching) {
+        return NULL;
+    }
+    if (Z_TYPE(ctx->factory) == IS_UNDEF && !EG(active_fiber) && !async_coroutine_id(ctx)) {
+        return NULL;
+    }
+    return ctx;
+}
+
+valkey_glide_async_ctx* valkey_glide_async_route_prefetch(const void* glide_client) {
+    valkey_glide_async_ctx* ctx = async_find(glide_client);
+
+    return ctx && !ctx->pinned && !ctx->watching ? ctx : NULL;
+}
+
+void valkey_glide_async_pin(const void* glide_client, bool pin) {
+    valkey_glide_async_ctx* ctx = async_find(glide_client);
+
+    if (ctx) {
+        if (pin) {
+            ctx->pinned++;
+        } else if (ctx->pinned > 0) {
+            ctx->pinned--;
+        }
+    }
+}
+
+void valkey_glide_async_set_watching(const void* glide_client, bool watching) {
+    valkey_glide_async_ctx* ctx = async_find(glide_client);
+
+    if (ctx) {
+        ctx->watching = watching;
+    }
+}
+
+void valkey_glide_async_set_coalesce_reads(const void* glide_client, bool coalesce) {
+    valkey_glide_async_ctx* ctx = async_find(glide_client);
+
+    if (ctx) {
+        ctx->coalesce_reads = coalesce;
+    }
+}
+
+bool valkey_glide_async_set_suspension_factory(const void* glide_client, zval* factory) {
+    valkey_glide_async_ctx* ctx = async_find(glide_client);
+    if (!ctx) {
+        return false;
+    }
+
+    zval_ptr_dtor(&ctx->factory);
+    ZVAL_UNDEF(&ctx->factory);
+    if (factory && Z_TYPE_P(factory) != IS_NULL) {
+        ZVAL_COPY(&ctx->factory, factory);
+    }
+    return true;
+}
+
+/* ====================================================================
+ * SUBMIT AND WAIT (PHP thread)
+ * ==================================================================== */
+
+static valkey_glide_async_request* async_request_new(valkey_glide_async_ctx* ctx) {
+    mutex_lock(&ctx->lock);
+    /* Every live request may sit in the ready list at once; grow it here so the
+     * callback never has to allocate */
+    if (ctx->ready_cap < ctx->refs) {
+        size_t                       new_cap = ctx->refs * 2 < 16 ? 16 : ctx->refs * 2;
+        valkey_glide_async_request** ready =
+            realloc(ctx->ready, new_cap * sizeof(valkey_glide_async_request*));
+        if (!ready) {
+            mutex_unlock(&ctx->lock);
+            return NULL;
+        }
+        ctx->ready     = ready;
+        ctx->ready_cap = new_cap;
+    }
+    ctx->refs++;
+    mutex_unlock(&ctx->lock);
+
+    valkey_glide_async_request* req = calloc(1, sizeof(valkey_glide_async_request));
+    if (!req) {
+        async_ctx_release(ctx);
+        return NULL;
+    }
+    req->ctx  = ctx;
+    req->refs = 2;
+    ZVAL_UNDEF(&req->waiter);
+    return req;
+}
+
+/* Suspend the current Fiber, coroutine or scheduler suspension until poll() resumes it */
+static bool async_suspend(valkey_glide_async_ctx* ctx, valkey_glide_async_request* req) {
+    zval      retval;
+    zend_long cid;
+
+    ZVAL_UNDEF(&retval);
+    if (Z_TYPE(ctx->factory) != IS_UNDEF) {
+        zval suspension;
+        if (call_user_function(NULL, NULL, &ctx->factory, &suspension, 0, NULL) != SUCCESS ||
+            EG(exception)) {
+            return false;
+        }
+        if (Z_TYPE(suspension) != IS_OBJECT) {
+            zval_ptr_dtor(&suspension);
+            zend_throw_exception(
+                get_valkey_glide_exception_ce(), "Suspension factory must return an object", 0);
+            return false;
+        }
+        mutex_lock(&ctx->lock);
+        ZVAL_COPY(&req->waiter, &suspension);
+        mutex_unlock(&ctx->lock);
+        zend_call_method_with_0_params(
+            Z_OBJ(suspension), Z_OBJCE(suspension), NULL, "suspend", &retval);
+        zval_ptr_dtor(&suspension);
+    } else if (EG(active_fiber)) {
+        mutex_lock(&ctx->lock);
+        ZVAL_OBJ_COPY(&req->waiter, &EG(active_fiber)->std);
+        mutex_unlock(&ctx->lock);
+        zend_call_method_with_0_params(NULL, zend_ce_fiber, NULL, "suspend", &retval);
+    } else if ((cid = async_coroutine_id(ctx)) > 0) {
+        mutex_lock(&ctx->lock);
+        ZVAL_LONG(&req->waiter, cid);
+        mutex_unlock(&ctx->lock);
+        zend_call_method_with_0_params(NULL, ctx->coroutine_ce, NULL, "yield", &retval);
+    } else {
+        /* Nothing to yield to (factory removed meanwhile): wait in place */
+        mutex_lock(&ctx->lock);
+        while (!req->done) {
+            cond_wait(&ctx->cond, &ctx->lock);
+        }
+        mutex_unlock(&ctx->lock);
+    }
+
+    zval_ptr_dtor(&retval);
+    return !EG(exception);
+}
+
+static CommandResult* async_take_result(valkey_glide_async_request* req) {
+    valkey_glide_async_result*  out    = ecalloc(1, sizeof(valkey_glide_async_result));
+    valkey_glide_async_request* source = req->leader ? req->leader : req;
+
+    if (source->error_message) {
+        out->error.command_error_message = estrdup(source->error_message);
+        out->error.command_error_type    = source->error_type;
+        out->result.command_error        = &out->error;
+    }
+    out->result.response = source->response;
+    out->source          = source;
+
+    mutex_lock(&source->ctx->lock);
+    source->refs++;
+    bool shared = source->shared;
+    mutex_unlock(&source->ctx->lock);
+
+    if (shared) {
+        zend_ulong index = (zend_ulong) (uintptr_t) source;
+        out->shared      = zend_hash_index_find_ptr(&async_decoded, index);
+        if (!out->shared) {
+            out->shared = ecalloc(1, sizeof(async_shared_decode));
+            ZVAL_UNDEF(&out->shared->value);
+            zend_hash_index_add_new_ptr(&async_decoded, index, out->shared);
+        }
+        out->shared->results++;
+    }
+
+    zend_hash_index_add_empty_element(&async_results, (zend_ulong) (uintptr_t) out);
+    return &out->result;
+}
+
+static CommandResult* async_await(valkey_glide_async_request* req) {
+    valkey_glide_async_ctx* ctx = req->ctx;
+    CommandResult*          result;
+
+    for (;;) {
+        zval stale;
+
+        mutex_lock(&ctx->lock);
+        bool done = req->done;
+        if (done) {
+            async_unqueue_locked(ctx, req);
+        }
+        ZVAL_COPY_VALUE(&stale, &req->waiter);
+        ZVAL_UNDEF(&req->waiter);
+        mutex_unlock(&ctx->lock);
+        zval_ptr_dtor(&stale);
+
+        if (done) {
+            break;
+        }
+
+        if (!async_suspend(ctx, req)) {
+            /* Fiber destroyed or scheduler failed: the core callback frees the reply */
+            mutex_lock(&ctx->lock);
+            async_unqueue_locked(ctx, req);
+            ZVAL_COPY_VALUE(&stale, &req->waiter);
+            ZVAL_UNDEF(&req->waiter);
+            mutex_unlock(&ctx->lock);
+            zval_ptr_dtor(&stale);
+
+            async_request_release(req);
+            return NULL;
+        }
+    }
+
+    result = async_take_result(req);
+    async_request_release(req);
+    return result;
+}
+
+/* The core answered synchronously; no callback will follow */
+static void async_request_discard(valkey_glide_async_request* req) {
+    async_request_release(req);
+    async_request_release(req);
+}
+
+/* ====================================================================
+ * SINGLE-FLIGHT READS (PHP thread)
+ * ==================================================================== */
+
+/* ctx->inflight holds a reference on every request it lists */
+static void async_inflight_dtor(zval* zv) {
+    async_request_release(Z_PTR_P(zv));
+}
+
+/* Type, length-prefixed arguments and route: identical keys mean identical replies */
+static void async_inflight_key(smart_str*           key,
+                               enum RequestType     command_type,
+                               unsigned long        arg_count,
+                               const uintptr_t*     args,
+                               const unsigned long* args_len,
+                               const uint8_t*       route_bytes,
+                               uintptr_t            route_bytes_len) {
+    unsigned long i;
+
+    smart_str_appendl(key, (const char*) &command_type, sizeof(command_type));
+    for (i = 0; i < arg_count; i++) {
+        smart_str_appendl(key, (const char*) &args_len[i], sizeof(args_len[i]));
+        if (args_len[i] > 0) {
+            smart_str_appendl(key, (const char*) args[i], args_len[i]);
+        }
+    }
+    smart_str_appendl(key, (const char*) &route_bytes_len, sizeof(route_bytes_len));
+    if (route_bytes_len > 0) {
+        smart_str_appendl(key, (const char*) route_bytes, route_bytes_len);
+    }
+    smart_str_0(key);
+}
+
+/* Wait on leader's reply instead of sending a read of our own. NULL if leader has already
+ * completed, in which case a fresh read is sent */
+static valkey_glide_async_request* async_request_join(valkey_glide_async_ctx*     ctx,
+                                                      valkey_glide_async_request* leader) {
+    valkey_glide_async_request* req = async_request_new(ctx);
+    if (!req) {
+        return NULL;
+    }
+
+    mutex_lock(&ctx->lock);
+    if (leader->done) {
+        mutex_unlock(&ctx->lock);
+        async_request_discard(req);
+        return NULL;
+    }
+    leader->refs++;
+    leader->shared     = true;
+    req->leader        = leader;
+    req->next_follower = leader->followers;
+    leader->followers  = req;
+    mutex_unlock(&ctx->lock);
+    return req;
+}
+
+CommandResult* valkey_glide_async_command(valkey_glide_async_ctx* ctx,
+                                          enum RequestType        command_type,
+                                          unsigned long           arg_count,
+                                          const uintptr_t*        args,
+                                          const unsigned long*    args_len,
+                                          const uint8_t*          route_bytes,
+                                          uintptr_t               route_bytes_len,
+                                          uint64_t                span_ptr) {
+    valkey_glide_async_request* req;
+    CommandResult*              result;
+    smart_str                   key = {0};
+
+    /* With OPT_COALESCE_READS, a read identical to one still in flight waits for that
+     * reply instead of going out again (e.g. many Fibers missing the same cache key) */
+    bool single_flight = ctx->coalesce_reads && is_coalescable_read(command_type);
+    if (single_flight) {
+        async_inflight_key(
+            &key, command_type, arg_count, args, args_len, route_bytes, route_bytes_len);
+
+        valkey_glide_async_request* leader =
+            zend_hash_str_find_ptr(&ctx->inflight, ZSTR_VAL(key.s), ZSTR_LEN(key.s));
+        if (leader) {
+            req = async_request_join(ctx, leader);
+            if (req) {
+                smart_str_free(&key);
+                return async_await(req);
+            }
+            zend_hash_str_del(&ctx->inflight, ZSTR_VAL(key.s), ZSTR_LEN(key.s));
+        }
+    }
+
+    req = async_request_new(ctx);
+    if (!req) {
+        VALKEY_LOG_ERROR("async_io", "Failed to allocate async request");
+        smart_str_free(&key);
+        return NULL;
+    }
+
+    CommandResult* immediate = command(ctx->client,
+                                       (uintptr_t) req,
+                                       command_type,
+                                       arg_count,
+                                       args,
+                                       args_len,
+                                       route_bytes,
+                                       route_bytes_len,
+                                       span_ptr);
+    if (immediate) {
+        async_request_discard(req);
+        smart_str_free(&key);
+        return immediate;
+    }
+
+    if (!single_flight) {
+        return async_await(req);
+    }
+
+    /* One reference for the ctx->inflight entry, one to keep ctx alive until it is unlisted,
+     * since the client may be closed while this caller is suspended */
+    mutex_lock(&ctx->lock);
+    req->refs += 2;
+    mutex_unlock(&ctx->lock);
+    zend_hash_str_update_ptr(&ctx->inflight, ZSTR_VAL(key.s), ZSTR_LEN(key.s), req);
+
+    result = async_await(req);
+
+    /* Later identical reads send their own request; followers already joined keep theirs */
+    if (!ctx->closed &&
+        zend_hash_str_find_ptr(&ctx->inflight, ZSTR_VAL(key.s), ZSTR_LEN(key.s)) == req) {
+        zend_hash_str_del(&ctx->inflight, ZSTR_VAL(key.s), ZSTR_LEN(key.s));
+    }
+    async_request_release(req);
+    smart_str_free(&key);
+    return result;
+}
+
+valkey_glide_async_request* valkey_glide_async_command_submit(valkey_glide_async_ctx* ctx,
+                                                           enum RequestType        command_type,
+                                                           unsigned long           arg_count,
+                                                           const uintptr_t*        args,
+                                                           const unsigned long*    args_len,
+                                                           uint64_t                span_ptr,
+                                                           CommandResult**         immediate) {
+    valkey_glide_async_request* req = async_request_new(ctx);
+
+    *immediate = NULL;
+    if (!req) {
+        VALKEY_LOG_ERROR("async_io", "Failed to allocate async request");
+        return NULL;
+    }
+
+    *immediate = command(
+        ctx->client, (uintptr_t) req, command_type, arg_count, args, args_len, NULL, 0, span_ptr);
+    if (*immediate) {
+        async_request_discard(req);
+        return NULL;
+    }
+    return req;
+}
+
+CommandResult* valkey_glide_async_batch(valkey_glide_async_ctx*  ctx,
+                                        const struct BatchInfo* batch_info,
+                                        bool                    raise_on_error,
+                                        uint64_t                span_ptr) {
+    valkey_glide_async_request* req = async_request_new(ctx);
+    if (!req) {
+        VALKEY_LOG_ERROR("async_io", "Failed to allocate async request");
+        return NULL;
+    }
+
+    CommandResult* immediate =
+        batch(ctx->client, (uintptr_t) req, batch_info, raise_on_error, NULL, span_ptr);
+    if (immediate) {
+        async_request_discard(req);
+        return immediate;
+    }
+
+    return async_await(req);
+}
+
+valkey_glide_async_request* valkey_glide_async_batch_submit(valkey_glide_async_ctx*  ctx,
+                                                         const struct BatchInfo* batch_info,
+                                                         bool                    raise_on_error,
+                                                         CommandResult**         immediate) {
+    valkey_glide_async_request* req = async_request_new(ctx);
+
+    *immediate = NULL;
+    if (!req) {
+        VALKEY_LOG_ERROR("async_io", "Failed to allocate async request");
+        return NULL;
+    }
+
+    *immediate = batch(ctx->client, (uintptr_t) req, batch_info, raise_on_error, NULL, 0);
+    if (*immediate) {
+        async_request_discard(req);
+        return NULL;
+    }
+    return req;
+}
+
+CommandResult* valkey_glide_async_wait(valkey_glide_async_request* req) {
+    return valkey_glide_async_wait_timed(req, NULL);
+}
+
+CommandResult* valkey_glide_async_wait_timed(valkey_glide_async_request* req,
+                                             zend_hrtime_t*              completed) {
+    valkey_glide_async_ctx* ctx = req->ctx;
+    CommandResult*          result;
+
+    mutex_lock(&ctx->lock);
+    while (!req->done) {
+        cond_wait(&ctx->cond, &ctx->lock);
+    }
+    async_unqueue_locked(ctx, req);
+    if (completed) {
+        *completed = req->completed;
+    }
+    mutex_unlock(&ctx->lock);
+
+    result = async_take_result(req);
+    async_request_release(req);
+    return result;
+}
+
+/* Wait in place for a request the core may have answered on the spot; true on success */
+static bool async_finish_blocking(valkey_glide_async_request* req, CommandResult* immediate) {
+    CommandResult* result = immediate;
+    bool           ok;
+
+    if (immediate) {
+        async_request_discard(req);
+    } else {
+        result = valkey_glide_async_wait(req);
+    }
+
+    ok = result && !result->command_error;
+    if (result && !valkey_glide_async_release_result(result)) {
+        free_command_result(result);
+    }
+    return ok;
+}
+
+bool valkey_glide_async_mirror(const void*          glide_client,
+                               enum RequestType     command_type,
+                               unsigned long        arg_count,
+                               const uintptr_t*     args,
+                               const unsigned long* args_len) {
+    valkey_glide_async_ctx* ctx = async_find(glide_client);
+    if (!ctx) {
+        return true;
+    }
+
+    valkey_glide_async_request* req = async_request_new(ctx);
+    if (!req) {
+        VALKEY_LOG_ERROR("async_io", "Failed to allocate async request");
+        return false;
+    }
+
+    CommandResult* immediate = command(
+        ctx->client, (uintptr_t) req, command_type, arg_count, args, args_len, NULL, 0, 0);
+    return async_finish_blocking(req, immediate);
+}
+
+bool valkey_glide_async_mirror_password(const void* glide_client,
+                                        const char* password,
+                                        bool        immediate_auth) {
+    valkey_glide_async_ctx* ctx = async_find(glide_client);
+    if (!ctx) {
+        return true;
+    }
+
+    valkey_glide_async_request* req = async_request_new(ctx);
+    if (!req) {
+        VALKEY_LOG_ERROR("async_io", "Failed to allocate async request");
+        return false;
+    }
+
+    CommandResult* immediate =
+        update_connection_password(ctx->client, (uintptr_t) req, password, immediate_auth);
+    return async_finish_blocking(req, immediate);
+}
+
+bool valkey_glide_async_release_result(CommandResult* result) {
+    if (EXPECTED(!async_tables_initialized || zend_hash_num_elements(&async_results) == 0) ||
+        !result) {
+        return false;
+    }
+    if (zend_hash_index_del(&async_results, (zend_ulong) (uintptr_t) result) != SUCCESS) {
+        return false;
+    }
+
+    valkey_glide_async_result* out = (valkey_glide_async_result*) result;
+    if (out->shared && --out->shared->results == 0) {
+        zend_hash_index_del(&async_decoded, (zend_ulong) (uintptr_t) out->source);
+        zval_ptr_dtor(&out->shared->value);
+        efree(out->shared);
+    }
+    async_request_release(out->source);
+    if (out->result.command_error) {
+        efree((char*) out->error.command_error_message);
+    }
+    efree(out);
+    return true;
+}
+
+int valkey_glide_async_decode(CommandResult*       result,
+                              z_result_processor_t processor,
+                              void*                output,
+                              zval*                return_value) {
+    valkey_glide_async_result* out;
+    int                        status;
+
+    /* Output a decoder fills in per call cannot be shared */
+    if (output || !async_tables_initialized || zend_hash_num_elements(&async_decoded) == 0 ||
+        !zend_hash_index_exists(&async_results, (zend_ulong) (uintptr_t) result)) {
+        return processor(result->response, output, return_value);
+    }
+    out = (valkey_glide_async_result*) result;
+    if (!out->shared) {
+        return processor(result->response, NULL, return_value);
+    }
+
+    if (out->shared->processor == processor) {
+        ZVAL_COPY(return_value, &out->shared->value);
+        return out->shared->status;
+    }
+    status = processor(result->response, NULL, return_value);
+    if (!out->shared->processor) {
+        out->shared->processor = processor;
+        out->shared->status    = status;
+        ZVAL_COPY(&out->shared->value, return_value);
+    }
+    return status;
+}
+
+/* ====================================================================
+ * SCHEDULER ENTRY POINT
+ * ==================================================================== */
+
+static bool async_resume(valkey_glide_async_ctx* ctx, zval* waiter) {
+    zend_object* obj;
+    zval         retval;
+
+    ZVAL_UNDEF(&retval);
+    if (Z_TYPE_P(waiter) == IS_LONG) {
+        zend_call_method_with_1_params(NULL, ctx->coroutine_ce, NULL, "resume", &retval, waiter);
+        zval_ptr_dtor(&retval);
+        return true;
+    }
+
+    obj = Z_OBJ_P(waiter);
+    if (instanceof_function(obj->ce, zend_ce_fiber)) {
+        zend_fiber* fiber = (zend_fiber*) obj;
+        if (fiber->context.status != ZEND_FIBER_STATUS_SUSPENDED) {
+            return false;
+        }
+    }
+
+    zend_call_method_with_0_params(obj, obj->ce, NULL, "resume", &retval);
+    zval_ptr_dtor(&retval);
+    return true;
+}
+
+int valkey_glide_async_poll(const void* glide_client, double timeout) {
+    valkey_glide_async_ctx* ctx     = async_find(glide_client);
+    zval*                   waiters = NULL;
+    size_t                  count   = 0;
+    size_t                  i;
+    int                     resumed = 0;
+
+    if (!ctx) {
+        return 0;
+    }
+
+    /* Drain first: anything queued after this point signals again */
+    async_notify_drain(ctx);
+
+    mutex_lock(&ctx->lock);
+    if (ctx->ready_len == 0 && timeout > 0) {
+        cond_timed_wait(&ctx->cond, &ctx->lock, (long) (timeout * 1000));
+    }
+    if (ctx->ready_len > 0) {
+        size_t kept = 0;
+
+        waiters = safe_emalloc(ctx->ready_len, sizeof(zval), 0);
+        for (i = 0; i < ctx->ready_len; i++) {
+            valkey_glide_async_request* req = ctx->ready[i];
+            if (Z_TYPE(req->waiter) == IS_UNDEF) {
+                /* Reply beat the caller to its suspend; leave it for the next poll */
+                ctx->ready[kept++] = req;
+                continue;
+            }
+            req->queued = false;
+            ZVAL_COPY_VALUE(&waiters[count++], &req->waiter);
+            ZVAL_UNDEF(&req->waiter);
+        }
+        ctx->ready_len = kept;
+    }
+    mutex_unlock(&ctx->lock);
+
+    /* Keep resuming if one waiter throws so the others are not stranded */
+    for (i = 0; i < count; i++) {
+        if (async_resume(ctx, &waiters[i])) {
+            resumed++;
+        }
+        if (EG(exception)) {
+            zend_exception_save();
+        }
+        zval_ptr_dtor(&waiters[i]);
+    }
+    if (waiters) {
+        zend_exception_restore();
+        efree(waiters);
+    }
+
+    return resumed;
+}
+
+bool valkey_glide_async_completion_stream(const void* glide_client, zval* return_value) {
+    valkey_glide_async_ctx* ctx = async_find(glide_client);
+
+#ifndef _WIN32
+    if (ctx && ctx->notify_fd[0] >= 0) {
+        /* The stream owns a duplicate so closing it never invalidates our descriptor */
+        int fd = dup(ctx->notify_fd[0]);
+        if (fd >= 0) {
+            php_stream* stream = php_stream_fopen_from_fd(fd, "r", NULL);
+            if (stream) {
+                php_stream_to_zval(stream, return_value);
+                return true;
+            }
+            close(fd);
+        }
+    }
+#endif
+    (void) ctx;
+    return false;
+}
@@ -0,0 +1,132 @@
+/** Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0 */
+
+#ifndef VALKEY_GLIDE_ASYNC_H
+#define VALKEY_GLIDE_ASYNC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "include/glide_bindings.h"
+#include "php.h"
+#include "valkey_glide_hrtime.h"
+
+/*
+ * Fiber-aware execution.
+ *
+ * A client connected with advanced_config['async_io'] gets a second, callback-driven
+ * core client next to its blocking one. Commands issued from inside a Fiber or a
+ * Swoole/OpenSwoole coroutine (or while a suspension factory is installed) are submitted
+ * through the callback path with their own request index; the caller is suspended and
+ * resumed by poll() once the core reports the reply. The completion stream (an eventfd on
+ * Linux, a pipe elsewhere) lets an event loop call poll() only when there is work. Everything
+ * else keeps using the blocking client unchanged.
+ *
+ * The companion is a second connection, so per-connection state has to be kept in step:
+ * SELECT and password changes are replayed on it, and while WATCH is active every command
+ * stays on the blocking client that holds the watch.
+ */
+typedef struct valkey_glide_async_ctx     valkey_glide_async_ctx;
+typedef struct valkey_glide_async_request valkey_glide_async_request;
+
+/* Create and register the callback-driven companion of glide_client */
+bool valkey_glide_async_attach(const void*    glide_client,
+                               const uint8_t* connection_request,
+                               size_t         connection_request_len);
+
+/* Close the companion client, if any; pending replies are dropped */
+void valkey_glide_async_detach(const void* glide_client);
+
+/* Return the companion of glide_client regardless of the calling context, or NULL */
+valkey_glide_async_ctx* valkey_glide_async_lookup(const void* glide_client);
+
+/* Return the companion to use for this call, or NULL to stay on the blocking path */
+valkey_glide_async_ctx* valkey_glide_async_route(const void* glide_client);
+
+/* Like valkey_glide_async_route() for a command sent ahead of use, which suspends nobody and
+ * so does not need a Fiber */
+valkey_glide_async_ctx* valkey_glide_async_route_prefetch(const void* glide_client);
+
+/* Submit a command and yield until its reply arrives. Returns NULL on failure */
+CommandResult* valkey_glide_async_command(valkey_glide_async_ctx* ctx,
+                                          enum RequestType        command_type,
+                                          unsigned long           arg_count,
+                                          const uintptr_t*        args,
+                                          const unsigned long*    args_len,
+                                          const uint8_t*          route_bytes,
+                                          uintptr_t               route_bytes_len,
+                                          uint64_t                span_ptr);
+
+/* Submit a command without waiting for it. Returns NULL and sets *immediate (possibly to
+ * NULL as well) when the core answered or failed on the spot */
+valkey_glide_async_request* valkey_glide_async_command_submit(valkey_glide_async_ctx* ctx,
+                                                           enum RequestType        command_type,
+                                                           unsigned long           arg_count,
+                                                           const uintptr_t*        args,
+                                                           const unsigned long*    args_len,
+                                                           uint64_t                span_ptr,
+                                                           CommandResult**         immediate);
+
+/* Submit a batch and yield until its reply arrives. Returns NULL on failure */
+CommandResult* valkey_glide_async_batch(valkey_glide_async_ctx*  ctx,
+                                        const struct BatchInfo* batch_info,
+                                        bool                    raise_on_error,
+                                        uint64_t                span_ptr);
+
+/* Submit a batch without waiting for it. Returns NULL and sets *immediate (possibly to
+ * NULL as well) when the core answered or failed on the spot */
+valkey_glide_async_request* valkey_glide_async_batch_submit(valkey_glide_async_ctx*  ctx,
+                                                         const struct BatchInfo* batch_info,
+                                                         bool                    raise_on_error,
+                                                         CommandResult**         immediate);
+
+/* Block the whole thread until a submitted request completes and return its result */
+CommandResult* valkey_glide_async_wait(valkey_glide_async_request* req);
+
+/* valkey_glide_async_wait(), also reporting when the reply arrived if completed is set */
+CommandResult* valkey_glide_async_wait_timed(valkey_glide_async_request* req,
+                                             zend_hrtime_t*              completed);
+
+/* Free result if it was produced by the async path; returns false for core-owned results */
+bool valkey_glide_async_release_result(CommandResult* result);
+
+/* processor(result->response, output, return_value), except that reads coalesced onto one
+ * reply decode it once: later callers using the same processor without output get a
+ * copy-on-write copy of the first caller's value */
+int valkey_glide_async_decode(CommandResult*       result,
+                              z_result_processor_t processor,
+                              void*                output,
+                              zval*                return_value);
+
+/* Resume Fibers whose replies arrived, waiting up to timeout seconds for the first one */
+int valkey_glide_async_poll(const void* glide_client, double timeout);
+
+/* Store in return_value a stream that turns readable whenever poll() has work to do */
+bool valkey_glide_async_completion_stream(const void* glide_client, zval* return_value);
+
+/* Install (or clear with NULL) a callable returning Revolt/AMPHP style suspensions */
+bool valkey_glide_async_set_suspension_factory(const void* glide_client, zval* factory);
+
+/* Keep commands on the blocking client until the matching unpin; calls nest */
+void valkey_glide_async_pin(const void* glide_client, bool pin);
+
+/* Route everything to the blocking client while a WATCH made on it is active */
+void valkey_glide_async_set_watching(const void* glide_client, bool watching);
+
+/* Let identical reads in flight at the same time share one request (OPT_COALESCE_READS) */
+void valkey_glide_async_set_coalesce_reads(const void* glide_client, bool coalesce);
+
+/* Replay a connection-state command (SELECT) on the companion, waiting in place.
+ * Returns true when it succeeded or there is no companion */
+bool valkey_glide_async_mirror(const void*          glide_client,
+                               enum RequestType     command_type,
+                               unsigned long        arg_count,
+                               const uintptr_t*     args,
+                               const unsigned long* args_len);
+
+/* Apply a password change to the companion as well; true when done or not needed */
+bool valkey_glide_async_mirror_password(const void* glide_client,
+                                        const char* password,
+                                        bool        immediate_auth);
+
+#endif /* VALKEY_GLIDE_ASYNC_H */
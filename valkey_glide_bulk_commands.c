@@ -0,0 +1,962 @@
+/*
+  +----------------------------------------------------------------------+
+  | Valkey Glide Bulk Commands                                           |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include <ext/spl/spl_iterators.h>
+#include <zend_exceptions.h>
+#include <zend_interfaces.h>
+
+#include "command_response.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_hrtime.h"
+
+#define BULK_LOAD_DEFAULT_CHUNK_SIZE 1000
+#define BULK_LOAD_DEFAULT_WINDOW 4
+#define BULK_LOAD_MAX_WINDOW 64
+
+typedef enum {
+    BULK_LOAD_SET,
+    BULK_LOAD_HSET,
+    BULK_LOAD_SADD,
+    BULK_LOAD_ZADD,
+    BULK_LOAD_RPUSH,
+} bulk_load_kind_t;
+
+static const struct {
+    const char*      name;
+    bulk_load_kind_t kind;
+    enum RequestType request_type;
+} bulk_load_commands[] = {
+    {"set", BULK_LOAD_SET, Set},
+    {"hset", BULK_LOAD_HSET, HSet},
+    {"sadd", BULK_LOAD_SADD, SAdd},
+    {"zadd", BULK_LOAD_ZADD, ZAdd},
+    {"rpush", BULK_LOAD_RPUSH, RPush},
+};
+
+/* One pipelined chunk, either being filled or in flight. Arguments point straight into
+ * the zend_strings held in strs, so row data is never copied before the core serializes
+ * it. Argument pointers are stored as offsets until submit because the arrays may grow. */
+typedef struct {
+    struct CmdInfo*        cmds;
+    const struct CmdInfo** cmd_ptrs;
+    size_t*                first_arg; /* Index of each command's first argument */
+    size_t                 cmd_count;
+    size_t                 cmd_cap;
+
+    const uint8_t** args;
+    uintptr_t*      args_len;
+    size_t          arg_count;
+    size_t          arg_cap;
+
+    zend_string** strs; /* References keeping the argument bytes alive */
+    size_t        str_count;
+    size_t        str_cap;
+
+    size_t                      rows;
+    zend_hrtime_t               started;
+    valkey_glide_async_request* pending; /* Submitted on the async client, not yet collected */
+} bulk_chunk_t;
+
+typedef struct {
+    valkey_glide_object*    valkey_glide;
+    valkey_glide_async_ctx* async_ctx; /* NULL: chunks run one at a time */
+    bulk_load_kind_t        kind;
+    enum RequestType        request_type;
+    zend_long               chunk_size;
+    zend_long               ttl;
+    bulk_chunk_t*           chunks; /* Ring of window chunks */
+    size_t                  window;
+    size_t                  current; /* Chunk being filled */
+
+    zval   chunk_stats;
+    size_t total_rows;
+    size_t total_commands;
+    size_t total_errors;
+    size_t chunk_count;
+} bulk_load_state_t;
+
+/* ====================================================================
+ * CHUNK BUFFERS
+ * ==================================================================== */
+
+static void bulk_chunk_reset(bulk_chunk_t* chunk) {
+    size_t i;
+
+    for (i = 0; i < chunk->str_count; i++) {
+        zend_string_release(chunk->strs[i]);
+    }
+    chunk->cmd_count = 0;
+    chunk->arg_count = 0;
+    chunk->str_count = 0;
+    chunk->rows      = 0;
+}
+
+static void bulk_chunk_free(bulk_chunk_t* chunk) {
+    bulk_chunk_reset(chunk);
+    if (chunk->cmds) {
+        efree(chunk->cmds);
+        efree(chunk->cmd_ptrs);
+        efree(chunk->first_arg);
+    }
+    if (chunk->args) {
+        efree(chunk->args);
+        efree(chunk->args_len);
+    }
+    if (chunk->strs) {
+        efree(chunk->strs);
+    }
+}
+
+static void bulk_chunk_begin_command(bulk_chunk_t* chunk, enum RequestType request_type) {
+    if (chunk->cmd_count == chunk->cmd_cap) {
+        chunk->cmd_cap   = chunk->cmd_cap ? chunk->cmd_cap * 2 : 64;
+        chunk->cmds      = safe_erealloc(chunk->cmds, chunk->cmd_cap, sizeof(struct CmdInfo), 0);
+        chunk->cmd_ptrs  = safe_erealloc(chunk->cmd_ptrs, chunk->cmd_cap, sizeof(void*), 0);
+        chunk->first_arg = safe_erealloc(chunk->first_arg, chunk->cmd_cap, sizeof(size_t), 0);
+    }
+    chunk->cmds[chunk->cmd_count].request_type = request_type;
+    chunk->cmds[chunk->cmd_count].arg_count    = 0;
+    chunk->first_arg[chunk->cmd_count]         = chunk->arg_count;
+    chunk->cmd_count++;
+}
+
+static void bulk_chunk_push_bytes(bulk_chunk_t* chunk, const char* data, size_t len) {
+    if (chunk->arg_count == chunk->arg_cap) {
+        chunk->arg_cap  = chunk->arg_cap ? chunk->arg_cap * 2 : 256;
+        chunk->args     = safe_erealloc(chunk->args, chunk->arg_cap, sizeof(uint8_t*), 0);
+        chunk->args_len = safe_erealloc(chunk->args_len, chunk->arg_cap, sizeof(uintptr_t), 0);
+    }
+    chunk->args[chunk->arg_count]     = (const uint8_t*) data;
+    chunk->args_len[chunk->arg_count] = len;
+    chunk->arg_count++;
+    chunk->cmds[chunk->cmd_count - 1].arg_count++;
+}
+
+/* Take a reference on str and pass its bytes as the next argument */
+static void bulk_chunk_push_string(bulk_chunk_t* chunk, zend_string* str) {
+    if (chunk->str_count == chunk->str_cap) {
+        chunk->str_cap = chunk->str_cap ? chunk->str_cap * 2 : 256;
+        chunk->strs    = safe_erealloc(chunk->strs, chunk->str_cap, sizeof(zend_string*), 0);
+    }
+    chunk->strs[chunk->str_count++] = str;
+    bulk_chunk_push_bytes(chunk, ZSTR_VAL(str), ZSTR_LEN(str));
+}
+
+static void bulk_chunk_push_zval(bulk_chunk_t* chunk, zval* value) {
+    bulk_chunk_push_string(chunk, zval_get_string(value));
+}
+
+/* Send the chunk as one non-atomic pipeline. With async_ctx the chunk is only submitted:
+ * NULL is returned and chunk->pending is set, unless the core answered on the spot. */
+static CommandResult* bulk_chunk_send(bulk_chunk_t*           chunk,
+                                      const void*             glide_client,
+                                      valkey_glide_async_ctx* async_ctx) {
+    CommandResult* result;
+    size_t         i;
+
+    for (i = 0; i < chunk->cmd_count; i++) {
+        chunk->cmds[i].args     = &chunk->args[chunk->first_arg[i]];
+        chunk->cmds[i].args_len = &chunk->args_len[chunk->first_arg[i]];
+        chunk->cmd_ptrs[i]      = &chunk->cmds[i];
+    }
+
+    struct BatchInfo batch_info = {.cmd_count = chunk->cmd_count,
+                                   .cmds      = (const struct CmdInfo* const*) chunk->cmd_ptrs,
+                                   .is_atomic = false};
+
+    chunk->started = zend_hrtime();
+    if (async_ctx) {
+        chunk->pending = valkey_glide_async_batch_submit(async_ctx, &batch_info, false, &result);
+        return result;
+    }
+    return batch(glide_client, 0, &batch_info, false, NULL, 0);
+}
+
+/* Count the error replies of a pipeline, remembering the first message */
+static size_t bulk_count_errors(CommandResult* result,
+                                size_t         cmd_count,
+                                const char**   first_err,
+                                size_t*        first_len) {
+    size_t errors = 0;
+    long   i;
+
+    *first_err = NULL;
+    *first_len = 0;
+
+    if (!result) {
+        *first_err = "No response";
+        *first_len = strlen(*first_err);
+        return cmd_count;
+    }
+    if (result->command_error) {
+        *first_err = result->command_error->command_error_message;
+        *first_len = *first_err ? strlen(*first_err) : 0;
+        return cmd_count;
+    }
+    if (!result->response || result->response->response_type != Array) {
+        return 0;
+    }
+
+    for (i = 0; i < result->response->array_value_len; i++) {
+        CommandResponse* element = &result->response->array_value[i];
+        if (element->response_type != Error) {
+            continue;
+        }
+        if (errors++ == 0 && element->string_value) {
+            *first_err = element->string_value;
+            *first_len = element->string_value_len;
+        }
+    }
+    return errors;
+}
+
+/* ====================================================================
+ * SUBMISSION AND RESULT ACCOUNTING
+ * ==================================================================== */
+
+static void bulk_load_record(bulk_load_state_t* state, bulk_chunk_t* chunk, CommandResult* result) {
+    const char* first_err;
+    size_t      first_len;
+    size_t      errors  = bulk_count_errors(result, chunk->cmd_count, &first_err, &first_len);
+    double      seconds = (double) (zend_hrtime() - chunk->started) / 1e9;
+    zval        chunk_stat;
+
+    array_init_size(&chunk_stat, 5);
+    add_assoc_long(&chunk_stat, "rows", (zend_long) chunk->rows);
+    add_assoc_long(&chunk_stat, "commands", (zend_long) chunk->cmd_count);
+    add_assoc_long(&chunk_stat, "errors", (zend_long) errors);
+    add_assoc_double(&chunk_stat, "seconds", seconds);
+    if (first_err) {
+        add_assoc_stringl(&chunk_stat, "error", first_err, first_len);
+    } else {
+        add_assoc_null(&chunk_stat, "error");
+    }
+    add_next_index_zval(&state->chunk_stats, &chunk_stat);
+
+    state->total_rows += chunk->rows;
+    state->total_commands += chunk->cmd_count;
+    state->total_errors += errors;
+    state->chunk_count++;
+
+    if (result) {
+        valkey_glide_free_command_result(result);
+    }
+}
+
+static void bulk_load_collect(bulk_load_state_t* state, bulk_chunk_t* chunk) {
+    if (chunk->pending) {
+        CommandResult* result = valkey_glide_async_wait(chunk->pending);
+        chunk->pending        = NULL;
+        bulk_load_record(state, chunk, result);
+        bulk_chunk_reset(chunk);
+    }
+}
+
+/* Send the current chunk and move on to the next free one */
+static void bulk_load_flush(bulk_load_state_t* state) {
+    bulk_chunk_t*  chunk = &state->chunks[state->current];
+    CommandResult* result;
+
+    if (chunk->cmd_count == 0) {
+        return;
+    }
+
+    result = bulk_chunk_send(chunk, state->valkey_glide->glide_client, state->async_ctx);
+    if (chunk->pending) {
+        /* Arguments stay referenced until the reply is collected */
+        state->current = (state->current + 1) % state->window;
+        bulk_load_collect(state, &state->chunks[state->current]);
+        return;
+    }
+
+    bulk_load_record(state, chunk, result);
+    bulk_chunk_reset(chunk);
+}
+
+/* ====================================================================
+ * ROW ENCODING
+ * ==================================================================== */
+
+/* Append the commands for one row to the current chunk */
+static bool bulk_load_add_row(bulk_load_state_t* state, zval* key, zval* value) {
+    bulk_chunk_t* chunk = &state->chunks[state->current];
+    zend_string*  key_str;
+    zval*         entry;
+    zend_string*  field;
+    zend_ulong    index;
+
+    ZVAL_DEREF(key);
+    ZVAL_DEREF(value);
+
+    /* Check the whole row first so a bad one leaves no half-built command behind */
+    if (state->kind == BULK_LOAD_SET) {
+        if (Z_TYPE_P(value) == IS_ARRAY) {
+            zend_type_error("bulkLoad: set values must be scalars, array given");
+            return false;
+        }
+    } else {
+        if (Z_TYPE_P(value) != IS_ARRAY || zend_hash_num_elements(Z_ARRVAL_P(value)) == 0) {
+            zend_throw_exception(get_valkey_glide_exception_ce(),
+                                 "bulkLoad: row values must be non-empty arrays for this command",
+                                 0);
+            return false;
+        }
+        ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(value), entry) {
+            ZVAL_DEREF(entry);
+            if (Z_TYPE_P(entry) == IS_ARRAY) {
+                zend_type_error("bulkLoad: row entries must be scalars, array given");
+                return false;
+            }
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+
+    key_str = zval_get_string(key);
+    bulk_chunk_begin_command(chunk, state->request_type);
+    bulk_chunk_push_string(chunk, zend_string_copy(key_str));
+
+    switch (state->kind) {
+        case BULK_LOAD_SET:
+            bulk_chunk_push_zval(chunk, value);
+            if (state->ttl > 0) {
+                bulk_chunk_push_bytes(chunk, "EX", 2);
+                bulk_chunk_push_string(chunk, zend_long_to_str(state->ttl));
+            }
+            break;
+
+        case BULK_LOAD_HSET:
+            ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(value), index, field, entry) {
+                bulk_chunk_push_string(
+                    chunk, field ? zend_string_copy(field) : zend_ulong_to_str(index));
+                bulk_chunk_push_zval(chunk, entry);
+            }
+            ZEND_HASH_FOREACH_END();
+            break;
+
+        case BULK_LOAD_ZADD:
+            /* member => score */
+            ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(value), index, field, entry) {
+                bulk_chunk_push_zval(chunk, entry);
+                bulk_chunk_push_string(
+                    chunk, field ? zend_string_copy(field) : zend_ulong_to_str(index));
+            }
+            ZEND_HASH_FOREACH_END();
+            break;
+
+        case BULK_LOAD_SADD:
+        case BULK_LOAD_RPUSH:
+            ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(value), entry) {
+                bulk_chunk_push_zval(chunk, entry);
+            }
+            ZEND_HASH_FOREACH_END();
+            break;
+    }
+
+    /* Only SET can carry its own expiry */
+    if (state->ttl > 0 && state->kind != BULK_LOAD_SET) {
+        bulk_chunk_begin_command(chunk, Expire);
+        bulk_chunk_push_string(chunk, zend_string_copy(key_str));
+        bulk_chunk_push_string(chunk, zend_long_to_str(state->ttl));
+    }
+    zend_string_release(key_str);
+
+    chunk->rows++;
+    if (chunk->rows >= (size_t) state->chunk_size) {
+        bulk_load_flush(state);
+    }
+    return true;
+}
+
+/*
+ * A [key, value] tuple is a two entry list whose second entry has the shape of a row value:
+ * a scalar for SET, an array for the others. The iterable's key cannot tell, since PHP
+ * turns numeric string keys such as '1001' into integers.
+ */
+static bool bulk_load_is_tuple(bulk_load_state_t* state, zval* row) {
+    zval* value;
+
+    if (Z_TYPE_P(row) != IS_ARRAY || zend_hash_num_elements(Z_ARRVAL_P(row)) != 2 ||
+        !zend_array_is_list(Z_ARRVAL_P(row))) {
+        return false;
+    }
+
+    value = zend_hash_index_find(Z_ARRVAL_P(row), 1);
+    ZVAL_DEREF(value);
+    return (state->kind == BULK_LOAD_SET) != (Z_TYPE_P(value) == IS_ARRAY);
+}
+
+/* Rows are either key => value pairs or list entries of the form [key, value] */
+static bool bulk_load_consume(bulk_load_state_t* state, zval* iter_key, zval* row) {
+    ZVAL_DEREF(row);
+
+    if (bulk_load_is_tuple(state, row)) {
+        return bulk_load_add_row(state,
+                                 zend_hash_index_find(Z_ARRVAL_P(row), 0),
+                                 zend_hash_index_find(Z_ARRVAL_P(row), 1));
+    }
+    return bulk_load_add_row(state, iter_key, row);
+}
+
+static int bulk_load_iterator_apply(zend_object_iterator* iter, void* puser) {
+    bulk_load_state_t* state = (bulk_load_state_t*) puser;
+    zval*              row   = iter->funcs->get_current_data(iter);
+    zval               key;
+
+    if (EG(exception) || !row) {
+        return ZEND_HASH_APPLY_STOP;
+    }
+
+    if (iter->funcs->get_current_key) {
+        iter->funcs->get_current_key(iter, &key);
+        if (EG(exception)) {
+            return ZEND_HASH_APPLY_STOP;
+        }
+    } else {
+        ZVAL_LONG(&key, (zend_long) iter->index);
+    }
+
+    bool ok = bulk_load_consume(state, &key, row);
+    zval_ptr_dtor(&key);
+    return ok ? ZEND_HASH_APPLY_KEEP : ZEND_HASH_APPLY_STOP;
+}
+
+/* ====================================================================
+ * SPEC PARSING
+ * ==================================================================== */
+
+static bool bulk_load_parse_spec(bulk_load_state_t* state, HashTable* spec) {
+    zval* opt;
+
+    state->kind         = BULK_LOAD_SET;
+    state->request_type = Set;
+    state->chunk_size   = BULK_LOAD_DEFAULT_CHUNK_SIZE;
+    state->window       = BULK_LOAD_DEFAULT_WINDOW;
+    state->ttl          = 0;
+
+    if ((opt = zend_hash_str_find(spec, "command", sizeof("command") - 1)) != NULL) {
+        zend_string* command = zval_get_string(opt);
+        size_t       i;
+        bool         found = false;
+
+        for (i = 0; i < sizeof(bulk_load_commands) / sizeof(bulk_load_commands[0]); i++) {
+            if (zend_binary_strcasecmp(ZSTR_VAL(command),
+                                       ZSTR_LEN(command),
+                                       bulk_load_commands[i].name,
+                                       strlen(bulk_load_commands[i].name)) == 0) {
+                state->kind         = bulk_load_commands[i].kind;
+                state->request_type = bulk_load_commands[i].request_type;
+                found               = true;
+                break;
+            }
+        }
+        zend_string_release(command);
+
+        if (!found) {
+            zend_throw_exception(get_valkey_glide_exception_ce(),
+                                 "bulkLoad: command must be one of set, hset, sadd, zadd, rpush",
+                                 0);
+            return false;
+        }
+    }
+
+    if ((opt = zend_hash_str_find(spec, "chunk_size", sizeof("chunk_size") - 1)) != NULL) {
+        state->chunk_size = zval_get_long(opt);
+    }
+    if ((opt = zend_hash_str_find(spec, "window", sizeof("window") - 1)) != NULL) {
+        zend_long window = zval_get_long(opt);
+        if (window > BULK_LOAD_MAX_WINDOW) {
+            window = BULK_LOAD_MAX_WINDOW;
+        }
+        state->window = window < 1 ? 0 : (size_t) window;
+    }
+    if ((opt = zend_hash_str_find(spec, "ttl", sizeof("ttl") - 1)) != NULL) {
+        state->ttl = zval_get_long(opt);
+    }
+
+    if (state->chunk_size < 1 || state->window < 1 || state->ttl < 0) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "bulkLoad: chunk_size and window must be positive, ttl non-negative",
+                             0);
+        return false;
+    }
+    return true;
+}
+
+/* ====================================================================
+ * BULK LOAD
+ * ==================================================================== */
+
+/* Execute bulkLoad: stream rows into pipelined chunks with a bounded number in flight */
+int execute_bulk_load_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    valkey_glide_object* valkey_glide;
+    zval*                rows;
+    zval*                spec = NULL;
+    bulk_load_state_t    state;
+    zend_hrtime_t        started;
+    size_t               i;
+
+    if (zend_parse_method_parameters(argc, object, "Oz|a", &object, ce, &rows, &spec) ==
+        FAILURE) {
+        return 0;
+    }
+
+    if (Z_TYPE_P(rows) != IS_ARRAY &&
+        !(Z_TYPE_P(rows) == IS_OBJECT &&
+          instanceof_function(Z_OBJCE_P(rows), zend_ce_traversable))) {
+        zend_argument_type_error(
+            1, "must be of type iterable, %s given", zend_zval_type_name(rows));
+        return 0;
+    }
+
+    valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "bulkLoad cannot be used inside multi()/pipeline()",
+                             0);
+        return 0;
+    }
+
+    memset(&state, 0, sizeof(state));
+    state.valkey_glide = valkey_glide;
+    if (!bulk_load_parse_spec(&state, spec ? Z_ARRVAL_P(spec) : &zend_empty_array)) {
+        return 0;
+    }
+
+    /* Keeping several chunks in flight needs the callback-driven client */
+    state.async_ctx = valkey_glide_async_lookup(valkey_glide->glide_client);
+    if (!state.async_ctx) {
+        state.window = 1;
+    }
+    state.chunks = ecalloc(state.window, sizeof(bulk_chunk_t));
+    array_init(&state.chunk_stats);
+
+    started = zend_hrtime();
+    if (Z_TYPE_P(rows) == IS_ARRAY) {
+        zend_string* str_key;
+        zend_ulong   num_key;
+        zval*        row;
+        zval         key;
+
+        ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(rows), num_key, str_key, row) {
+            if (str_key) {
+                ZVAL_STR(&key, str_key);
+            } else {
+                ZVAL_LONG(&key, (zend_long) num_key);
+            }
+            if (!bulk_load_consume(&state, &key, row)) {
+                break;
+            }
+        }
+        ZEND_HASH_FOREACH_END();
+    } else {
+        spl_iterator_apply(rows, bulk_load_iterator_apply, &state);
+    }
+
+    /* Send what is left and collect everything still in flight, oldest first */
+    if (!EG(exception)) {
+        bulk_load_flush(&state);
+    }
+    for (i = 1; i <= state.window; i++) {
+        bulk_load_collect(&state, &state.chunks[(state.current + i) % state.window]);
+    }
+    for (i = 0; i < state.window; i++) {
+        bulk_chunk_free(&state.chunks[i]);
+    }
+    efree(state.chunks);
+
+    if (EG(exception)) {
+        zval_ptr_dtor(&state.chunk_stats);
+        return 0;
+    }
+
+    double seconds = (double) (zend_hrtime() - started) / 1e9;
+    array_init_size(return_value, 7);
+    add_assoc_long(return_value, "rows", (zend_long) state.total_rows);
+    add_assoc_long(return_value, "commands", (zend_long) state.total_commands);
+    add_assoc_long(return_value, "chunks", (zend_long) state.chunk_count);
+    add_assoc_long(return_value, "errors", (zend_long) state.total_errors);
+    add_assoc_double(return_value, "seconds", seconds);
+    add_assoc_double(
+        return_value, "rows_per_sec", seconds > 0 ? (double) state.total_rows / seconds : 0.0);
+    add_assoc_zval(return_value, "chunk_stats", &state.chunk_stats);
+    return 1;
+}
+
+/* ====================================================================
+ * KEY MIGRATION
+ * ==================================================================== */
+
+#define MIGRATE_DEFAULT_BATCH_SIZE 100
+
+typedef struct {
+    valkey_glide_object*    src;
+    valkey_glide_object*    dst;
+    valkey_glide_async_ctx* dst_async; /* Lets RESTOREs overlap with the next DUMPs */
+    zend_long               batch_size;
+    bool                    replace;
+    bool                    delete_source;
+    zval*                   progress; /* Callable or NULL */
+
+    bulk_chunk_t   dump;           /* DUMP + PEXPIRETIME per key; strs[i] is key i */
+    bulk_chunk_t   restore;        /* RESTORE per dumped key, possibly in flight */
+    CommandResult* restore_source; /* DUMP replies the RESTORE payloads point into */
+    CommandResult* restore_result; /* Reply of a RESTORE pipeline sent synchronously */
+
+    size_t        keys;
+    size_t        migrated;
+    size_t        missing;
+    size_t        errors;
+    size_t        bytes;
+    size_t        batches;
+    zend_string*  last_error;
+    zend_hrtime_t started;
+} migrate_state_t;
+
+static void migrate_note_error(migrate_state_t* state, const char* message, size_t len) {
+    if (message) {
+        if (state->last_error) {
+            zend_string_release(state->last_error);
+        }
+        state->last_error = zend_string_init(message, len, 0);
+    }
+}
+
+static void migrate_stats(migrate_state_t* state, zval* out) {
+    double seconds = (double) (zend_hrtime() - state->started) / 1e9;
+
+    array_init_size(out, 10);
+    add_assoc_long(out, "keys", (zend_long) state->keys);
+    add_assoc_long(out, "migrated", (zend_long) state->migrated);
+    add_assoc_long(out, "missing", (zend_long) state->missing);
+    add_assoc_long(out, "errors", (zend_long) state->errors);
+    add_assoc_long(out, "bytes", (zend_long) state->bytes);
+    add_assoc_long(out, "batches", (zend_long) state->batches);
+    add_assoc_double(out, "seconds", seconds);
+    add_assoc_double(out, "keys_per_sec", seconds > 0 ? (double) state->migrated / seconds : 0.0);
+    if (state->last_error) {
+        add_assoc_str(out, "last_error", zend_string_copy(state->last_error));
+    } else {
+        add_assoc_null(out, "last_error");
+    }
+}
+
+/* Collect the outstanding RESTORE pipeline, drop migrated source keys if asked to, and
+ * report progress */
+static void migrate_finish_restore(migrate_state_t* state) {
+    CommandResult* result;
+    bulk_chunk_t   unlink_chunk = {0};
+    const char*    first_err;
+    size_t         first_len;
+    size_t         i;
+
+    if (state->restore.cmd_count == 0) {
+        return;
+    }
+
+    if (state->restore.pending) {
+        result                 = valkey_glide_async_wait(state->restore.pending);
+        state->restore.pending = NULL;
+    } else {
+        result                = state->restore_result;
+        state->restore_result = NULL;
+    }
+
+    size_t errors = bulk_count_errors(result, state->restore.cmd_count, &first_err, &first_len);
+    migrate_note_error(state, first_err, first_len);
+    state->errors += errors;
+
+    /* Per-key accounting only makes sense when every RESTORE got its own reply */
+    if (result && !result->command_error && result->response &&
+        result->response->response_type == Array &&
+        (size_t) result->response->array_value_len == state->restore.cmd_count) {
+        for (i = 0; i < state->restore.cmd_count; i++) {
+            const uint8_t* const* args     = &state->restore.args[state->restore.first_arg[i]];
+            const uintptr_t*      args_len = &state->restore.args_len[state->restore.first_arg[i]];
+
+            if (result->response->array_value[i].response_type == Error) {
+                continue;
+            }
+            state->migrated++;
+            state->bytes += args_len[2]; /* key, ttl, payload, ... */
+
+            if (state->delete_source) {
+                bulk_chunk_begin_command(&unlink_chunk, Unlink);
+                bulk_chunk_push_bytes(&unlink_chunk, (const char*) args[0], args_len[0]);
+            }
+        }
+    }
+
+    if (unlink_chunk.cmd_count > 0) {
+        CommandResult* unlinked = bulk_chunk_send(&unlink_chunk, state->src->glide_client, NULL);
+        state->errors +=
+            bulk_count_errors(unlinked, unlink_chunk.cmd_count, &first_err, &first_len);
+        migrate_note_error(state, first_err, first_len);
+        if (unlinked) {
+            valkey_glide_free_command_result(unlinked);
+        }
+    }
+    bulk_chunk_free(&unlink_chunk);
+
+    if (result) {
+        valkey_glide_free_command_result(result);
+    }
+    if (state->restore_source) {
+        valkey_glide_free_command_result(state->restore_source);
+        state->restore_source = NULL;
+    }
+    bulk_chunk_reset(&state->restore);
+    state->batches++;
+
+    if (state->progress) {
+        zval stats, retval;
+        migrate_stats(state, &stats);
+        call_user_function(NULL, NULL, state->progress, &retval, 1, &stats);
+        zval_ptr_dtor(&retval);
+        zval_ptr_dtor(&stats);
+    }
+}
+
+/* DUMP the buffered keys, then turn the payloads into a RESTORE pipeline on dst */
+static void migrate_step(migrate_state_t* state) {
+    CommandResult* dumped;
+    const char*    first_err;
+    size_t         first_len;
+    size_t         rows = state->dump.rows;
+    size_t         i;
+
+    if (rows == 0) {
+        return;
+    }
+
+    dumped = bulk_chunk_send(&state->dump, state->src->glide_client, NULL);
+
+    /* Only one RESTORE pipeline is outstanding at a time, which bounds memory */
+    migrate_finish_restore(state);
+    if (EG(exception)) {
+        if (dumped) {
+            valkey_glide_free_command_result(dumped);
+        }
+        bulk_chunk_reset(&state->dump);
+        return;
+    }
+
+    if (!dumped || dumped->command_error || !dumped->response ||
+        dumped->response->response_type != Array ||
+        (size_t) dumped->response->array_value_len != 2 * rows) {
+        state->errors += rows;
+        bulk_count_errors(dumped, rows, &first_err, &first_len);
+        migrate_note_error(state, first_err, first_len);
+        if (dumped) {
+            valkey_glide_free_command_result(dumped);
+        }
+        bulk_chunk_reset(&state->dump);
+        return;
+    }
+
+    for (i = 0; i < rows; i++) {
+        CommandResponse* payload = &dumped->response->array_value[2 * i];
+        CommandResponse* expiry  = &dumped->response->array_value[2 * i + 1];
+        zend_long        pexpire = expiry->response_type == Int ? expiry->int_value : -1;
+
+        if (payload->response_type == Null) {
+            state->missing++;
+            continue;
+        }
+        if (payload->response_type != String) {
+            state->errors++;
+            if (payload->response_type == Error) {
+                migrate_note_error(state, payload->string_value, payload->string_value_len);
+            }
+            continue;
+        }
+
+        /* RESTORE key ttl payload [REPLACE] ABSTTL; ttl 0 keeps the key persistent */
+        bulk_chunk_begin_command(&state->restore, Restore);
+        bulk_chunk_push_string(&state->restore, zend_string_copy(state->dump.strs[i]));
+        bulk_chunk_push_string(&state->restore, zend_long_to_str(pexpire > 0 ? pexpire : 0));
+        bulk_chunk_push_bytes(&state->restore, payload->string_value, payload->string_value_len);
+        if (state->replace) {
+            bulk_chunk_push_bytes(&state->restore, "REPLACE", 7);
+        }
+        bulk_chunk_push_bytes(&state->restore, "ABSTTL", 6);
+    }
+    bulk_chunk_reset(&state->dump);
+
+    if (state->restore.cmd_count == 0) {
+        valkey_glide_free_command_result(dumped);
+        return;
+    }
+
+    /* The payloads are read straight out of the DUMP replies */
+    state->restore_source = dumped;
+    state->restore_result =
+        bulk_chunk_send(&state->restore, state->dst->glide_client, state->dst_async);
+}
+
+static bool migrate_add_key(migrate_state_t* state, zval* key) {
+    zend_string* key_str = zval_get_string(key);
+
+    if (EG(exception)) {
+        zend_string_release(key_str);
+        return false;
+    }
+
+    bulk_chunk_begin_command(&state->dump, Dump);
+    bulk_chunk_push_string(&state->dump, key_str);
+    bulk_chunk_begin_command(&state->dump, PExpireTime);
+    bulk_chunk_push_bytes(&state->dump, ZSTR_VAL(key_str), ZSTR_LEN(key_str));
+    state->dump.rows++;
+    state->keys++;
+
+    if (state->dump.rows >= (size_t) state->batch_size) {
+        migrate_step(state);
+    }
+    return !EG(exception);
+}
+
+static int migrate_iterator_apply(zend_object_iterator* iter, void* puser) {
+    zval* key = iter->funcs->get_current_data(iter);
+
+    if (EG(exception) || !key) {
+        return ZEND_HASH_APPLY_STOP;
+    }
+    ZVAL_DEREF(key);
+    return migrate_add_key((migrate_state_t*) puser, key) ? ZEND_HASH_APPLY_KEEP
+                                                          : ZEND_HASH_APPLY_STOP;
+}
+
+/* Execute migrateKeys: pipelined DUMP on this client, RESTORE ... ABSTTL on the target */
+int execute_migrate_keys_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    zval*           dst;
+    zval*           keys;
+    zval*           opts = NULL;
+    zval*           opt;
+    migrate_state_t state;
+
+    if (zend_parse_method_parameters(argc, object, "Ooz|a", &object, ce, &dst, &keys, &opts) ==
+        FAILURE) {
+        return 0;
+    }
+
+    if (!instanceof_function(Z_OBJCE_P(dst), get_valkey_glide_ce()) &&
+        !instanceof_function(Z_OBJCE_P(dst), get_valkey_glide_cluster_ce())) {
+        zend_argument_type_error(1, "must be ValkeyGlide or ValkeyGlideCluster");
+        return 0;
+    }
+    if (Z_TYPE_P(keys) != IS_ARRAY &&
+        !(Z_TYPE_P(keys) == IS_OBJECT &&
+          instanceof_function(Z_OBJCE_P(keys), zend_ce_traversable))) {
+        zend_argument_type_error(
+            2, "must be of type iterable, %s given", zend_zval_type_name(keys));
+        return 0;
+    }
+
+    memset(&state, 0, sizeof(state));
+    state.src        = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    state.dst        = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, dst);
+    state.batch_size = MIGRATE_DEFAULT_BATCH_SIZE;
+    state.replace    = true;
+
+    if (!state.src || !state.src->glide_client || !state.dst || !state.dst->glide_client) {
+        zend_throw_exception(get_valkey_glide_exception_ce(), "Client not connected", 0);
+        return 0;
+    }
+    if (state.src->is_in_batch_mode || state.dst->is_in_batch_mode) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "migrateKeys cannot be used inside multi()/pipeline()",
+                             0);
+        return 0;
+    }
+
+    if (opts) {
+        HashTable* ht = Z_ARRVAL_P(opts);
+        if ((opt = zend_hash_str_find(ht, "batch_size", sizeof("batch_size") - 1)) != NULL) {
+            state.batch_size = zval_get_long(opt);
+        }
+        if ((opt = zend_hash_str_find(ht, "replace", sizeof("replace") - 1)) != NULL) {
+            state.replace = zend_is_true(opt);
+        }
+        if ((opt = zend_hash_str_find(ht, "delete", sizeof("delete") - 1)) != NULL) {
+            state.delete_source = zend_is_true(opt);
+        }
+        if ((opt = zend_hash_str_find(ht, "progress", sizeof("progress") - 1)) != NULL &&
+            Z_TYPE_P(opt) != IS_NULL) {
+            if (!zend_is_callable(opt, 0, NULL)) {
+                zend_throw_exception(get_valkey_glide_exception_ce(),
+                                     "migrateKeys: progress must be callable",
+                                     0);
+                return 0;
+            }
+            state.progress = opt;
+        }
+    }
+    if (state.batch_size < 1) {
+        zend_throw_exception(
+            get_valkey_glide_exception_ce(), "migrateKeys: batch_size must be positive", 0);
+        return 0;
+    }
+
+    state.dst_async = valkey_glide_async_lookup(state.dst->glide_client);
+    state.started   = zend_hrtime();
+
+    if (Z_TYPE_P(keys) == IS_ARRAY) {
+        zval* key;
+        ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key) {
+            ZVAL_DEREF(key);
+            if (!migrate_add_key(&state, key)) {
+                break;
+            }
+        }
+        ZEND_HASH_FOREACH_END();
+    } else {
+        spl_iterator_apply(keys, migrate_iterator_apply, &state);
+    }
+
+    if (!EG(exception)) {
+        migrate_step(&state);
+    }
+    if (!EG(exception)) {
+        migrate_finish_restore(&state);
+    }
+
+    /* On an exception the outstanding RESTORE is still collected so nothing dangles */
+    if (state.restore.pending) {
+        CommandResult* result = valkey_glide_async_wait(state.restore.pending);
+        if (result) {
+            valkey_glide_free_command_result(result);
+        }
+    }
+    if (state.restore_result) {
+        valkey_glide_free_command_result(state.restore_result);
+    }
+    if (state.restore_source) {
+        valkey_glide_free_command_result(state.restore_source);
+    }
+    bulk_chunk_free(&state.dump);
+    bulk_chunk_free(&state.restore);
+
+    if (!EG(exception)) {
+        migrate_stats(&state, return_value);
+    }
+    if (state.last_error) {
+        zend_string_release(state.last_error);
+    }
+    return EG(exception) ? 0 : 1;
+}
@@ -89,6 +89,8 @@ static int valkey_glide_cluster_create_connection(
     } else {
         VALKEY_LOG_INFO("cluster_construct", "ValkeyGlide cluster client created successfully");
         valkey_glide->glide_client = conn_resp->conn_ptr;
+        valkey_glide_async_set_coalesce_reads(valkey_glide->glide_client,
+                                              valkey_glide->opt_coalesce_reads);
     }
 
     free_connection_response((ConnectionResponse*) conn_resp);
@@ -272,6 +274,42 @@ PHP_METHOD(ValkeyGlideCluster, close) {
 GET_STATISTICS_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
+/* {{{ proto array ValkeyGlideCluster::getLatencyStats(?string command = null) */
+GET_LATENCY_STATS_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlideCluster::resetLatencyStats() */
+RESET_LATENCY_STATS_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto array ValkeyGlideCluster::getSlowLog(int count = -1) */
+GET_SLOW_LOG_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlideCluster::resetSlowLog() */
+RESET_SLOW_LOG_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto array ValkeyGlideCluster::getAllocStats() */
+GET_ALLOC_STATS_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlideCluster::resetAllocStats() */
+RESET_ALLOC_STATS_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto int ValkeyGlideCluster::poll(float timeout = 0.0) */
+POLL_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto bool ValkeyGlideCluster::setSuspensionFactory(?callable factory) */
+SET_SUSPENSION_FACTORY_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto resource ValkeyGlideCluster::getCompletionStream() */
+GET_COMPLETION_STREAM_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
 /* {{{ proto string ValkeyGlideCluster::get(string key) */
 GET_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
@@ -909,6 +947,22 @@ UNWATCH_METHOD_IMPL(ValkeyGlideCluster)
 /* {{{ proto array ValkeyGlideCluster::exec() */
 EXEC_METHOD_IMPL(ValkeyGlideCluster)
 
+/* {{{ proto array ValkeyGlideCluster::bulkLoad(iterable rows [, array spec]) */
+BULK_LOAD_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto array ValkeyGlideCluster::migrateKeys(object dst, iterable keys [, array opts]) */
+MIGRATE_KEYS_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto ValkeyGlideHashChunks ValkeyGlideCluster::hGetAllChunked(string key [, int chunk]) */
+HGETALL_CHUNKED_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
+/* {{{ proto ValkeyGlideFunction ValkeyGlideCluster::prepareFunction(string lib, string name) */
+PREPARE_FUNCTION_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
 /* {{{ proto bool ValkeyGlideCluster::discard() */
 DISCARD_METHOD_IMPL(ValkeyGlideCluster)
 
@@ -1002,6 +1056,10 @@ GEOSEARCH_METHOD_IMPL(ValkeyGlideCluster)
 
 GEOSEARCHSTORE_METHOD_IMPL(ValkeyGlideCluster)
 
+/* {{{ proto array ValkeyGlideCluster::geosearchMerge(array results [, int count, bool desc]) */
+GEOSEARCHMERGE_METHOD_IMPL(ValkeyGlideCluster)
+/* }}} */
+
 
 /* {{{ proto array ValkeyGlideCluster::time(string key)
  *     proto array ValkeyGlideCluster::time(array host_port) */
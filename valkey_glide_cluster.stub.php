@@ -280,6 +280,65 @@ class ValkeyGlideCluster
      */
     public const OPT_PACK_IGNORE_NUMBERS = UNKNOWN;
 
+    /**
+     * Runtime option: Coalesce identical read commands.
+     * When enabled, repeated idempotent reads (GET, HGETALL, SMEMBERS, ZRANGE, ...)
+     * with the same arguments inside multi()/pipeline() are sent once and share the
+     * decoded reply. Any other command in between starts a new coalescing window.
+     * On a client connected with advanced_config ['async_io' => true], a read issued
+     * from a Fiber while an identical read is still in flight waits for that reply
+     * instead of being sent again, so a cache stampede costs one round trip.
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_OPT_COALESCE_READS
+     */
+    public const OPT_COALESCE_READS = UNKNOWN;
+
+    /**
+     * Runtime option: Return numeric array replies as packed binary columns instead of
+     * PHP arrays. zMscore() returns one native-endian float64 per member and geopos() a
+     * longitude, latitude float64 pair per member; read them with unpack('d*', $reply).
+     * Missing members are NAN.
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_OPT_PACKED_NUMERICS
+     */
+    public const OPT_PACKED_NUMERICS = UNKNOWN;
+
+    /**
+     * eval()/fcall() $decode flag: Map replies (RESP3 tables) become key => value arrays.
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SCRIPT_DECODE_MAPS
+     */
+    public const SCRIPT_DECODE_MAPS = UNKNOWN;
+
+    /**
+     * eval()/fcall() $decode flag: Flat arrays of even length whose even elements are all
+     * strings or integers, [k1, v1, k2, v2], become [k1 => v1, k2 => v2].
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SCRIPT_DECODE_PAIRS
+     */
+    public const SCRIPT_DECODE_PAIRS = UNKNOWN;
+
+    /**
+     * eval()/fcall() $decode flag: Numeric strings become int or float. Only the canonical
+     * spelling decodes, so '007', '+1', ' 1' and out of range integers stay strings.
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SCRIPT_DECODE_NUMERIC
+     */
+    public const SCRIPT_DECODE_NUMERIC = UNKNOWN;
+
+    /**
+     * eval()/fcall() $decode flags: All of the SCRIPT_DECODE_* conversions.
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SCRIPT_DECODE_ALL
+     */
+    public const SCRIPT_DECODE_ALL = UNKNOWN;
+
     /**
      * @var int
      * @cvalue VALKEY_GLIDE_SERIALIZER_NONE
@@ -411,6 +470,8 @@ class ValkeyGlideCluster
      * @param array|null $advanced_config       Advanced configuration options:
      *                                          - 'connection_timeout' => 5000 (milliseconds)
      *                                          - 'tls_config' => ['use_insecure_tls' => false]
+     *                                          - 'async_io' => true to yield Fibers on I/O, see ValkeyGlide::poll().
+     *                                            Opens a second connection to every node.
      *                                          - 'refresh_topology_from_initial_nodes' => false (default: false)
      *                                            When true, topology updates use only initial nodes instead of internal cluster view.
      *                                          - 'otel' => OpenTelemetryConfig::builder()
@@ -580,6 +641,51 @@ class ValkeyGlideCluster
      */
     public function getStatistics(): array;
 
+    /**
+     * @see ValkeyGlide::getLatencyStats
+     */
+    public function getLatencyStats(?string $command = null): array;
+
+    /**
+     * @see ValkeyGlide::resetLatencyStats
+     */
+    public function resetLatencyStats(): bool;
+
+    /**
+     * @see ValkeyGlide::getSlowLog
+     */
+    public function getSlowLog(int $count = -1): array;
+
+    /**
+     * @see ValkeyGlide::resetSlowLog
+     */
+    public function resetSlowLog(): bool;
+
+    /**
+     * @see ValkeyGlide::getAllocStats
+     */
+    public function getAllocStats(): array;
+
+    /**
+     * @see ValkeyGlide::resetAllocStats
+     */
+    public function resetAllocStats(): bool;
+
+    /**
+     * @see ValkeyGlide::poll
+     */
+    public function poll(float $timeout = 0.0): int;
+
+    /**
+     * @see ValkeyGlide::setSuspensionFactory
+     */
+    public function setSuspensionFactory(?callable $factory): bool;
+
+    /**
+     * @see ValkeyGlide::getCompletionStream
+     */
+    public function getCompletionStream(): mixed;
+
     /**
      * @see ValkeyGlide::updateConnectionPassword
      */
@@ -666,6 +772,16 @@ class ValkeyGlideCluster
      */
     public function exec(): array|false;
 
+    /**
+     * @see ValkeyGlide::bulkLoad()
+     */
+    public function bulkLoad(iterable $rows, array $spec = []): array|false;
+
+    /**
+     * @see ValkeyGlide::migrateKeys()
+     */
+    public function migrateKeys(object $dst, iterable $keys, array $opts = []): array|false;
+
     /**
      * @see ValkeyGlide::exists
      */
@@ -731,6 +847,11 @@ class ValkeyGlideCluster
      */
     public function geosearch(string $key, array|string $position, array|int|float $shape, string $unit, array $options = []): ValkeyGlideCluster|array;
 
+    /**
+     * @see ValkeyGlide::geosearchMerge
+     */
+    public static function geosearchMerge(array $results, int $count = -1, bool $desc = false): array;
+
     /**
      * @see https://valkey.io/commands/geosearchstore
      */
@@ -791,6 +912,11 @@ class ValkeyGlideCluster
      */
     public function hGetAll(string $key): ValkeyGlideCluster|array|false;
 
+    /**
+     * @see ValkeyGlide::hGetAllChunked
+     */
+    public function hGetAllChunked(string $key, int $chunk = 1000, bool $novalues = false): ValkeyGlideHashChunks|false;
+
     /**
      * @see ValkeyGlide::hincrby
      */
@@ -1564,32 +1690,37 @@ class ValkeyGlideCluster
     /**
      * @see ValkeyGlide::eval
      */
-    public function eval(string $script, array $args = [], int $num_keys = 0): mixed;
+    public function eval(string $script, array $args = [], int $num_keys = 0, int $decode = 0): mixed;
 
     /**
      * @see ValkeyGlide::evalsha
      */
-    public function evalsha(string $sha1, array $args = [], int $num_keys = 0): mixed;
+    public function evalsha(string $sha1, array $args = [], int $num_keys = 0, int $decode = 0): mixed;
 
     /**
      * @see ValkeyGlide::eval_ro
      */
-    public function eval_ro(string $script, array $args = [], int $num_keys = 0): mixed;
+    public function eval_ro(string $script, array $args = [], int $num_keys = 0, int $decode = 0): mixed;
 
     /**
      * @see ValkeyGlide::evalsha_ro
      */
-    public function evalsha_ro(string $sha1, array $args = [], int $num_keys = 0): mixed;
+    public function evalsha_ro(string $sha1, array $args = [], int $num_keys = 0, int $decode = 0): mixed;
 
     /**
      * @see ValkeyGlide::fcall
      */
-    public function fcall(string $fn, array $keys = [], array $args = []): mixed;
+    public function fcall(string $fn, array $keys = [], array $args = [], int $decode = 0): mixed;
+
+    /**
+     * @see ValkeyGlide::prepareFunction
+     */
+    public function prepareFunction(string $lib, string $name): ValkeyGlideFunction|false;
 
     /**
      * @see ValkeyGlide::fcall_ro
      */
-    public function fcall_ro(string $fn, array $keys = [], array $args = []): mixed;
+    public function fcall_ro(string $fn, array $keys = [], array $args = [], int $decode = 0): mixed;
 
     /**
      * @see ValkeyGlide::scriptExists
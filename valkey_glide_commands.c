@@ -21,6 +21,7 @@
 #include "include/glide_bindings.h"
 #include "logger.h"
 #include "php.h"
+#include "valkey_glide_async.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
 #include "valkey_glide_z_common.h"
@@ -346,6 +347,10 @@ int execute_watch_command(zval* object, int argc, zval* return_value, zend_class
      * 2. watch('key1', 'key2', 'key3') - multiple string args
      */
 
+    /* The watch lives on the blocking client, so Fiber commands must not leave it until
+     * EXEC or UNWATCH; a failed WATCH only keeps them there a little longer */
+    valkey_glide_async_set_watching(valkey_glide->glide_client, true);
+
     if (arg_count == 1 && Z_TYPE(z_args[0]) == IS_ARRAY) {
         /* Pattern 1: Single array argument */
         int keys_count = zend_hash_num_elements(Z_ARRVAL(z_args[0]));
@@ -385,6 +390,7 @@ int execute_unwatch_command(zval* object, int argc, zval* return_value, zend_cla
     args.cmd_type            = UnWatch;
 
     if (execute_core_command(valkey_glide, &args, NULL, process_core_bool_result, return_value)) {
+        valkey_glide_async_set_watching(valkey_glide->glide_client, false);
         return 1;
     } else {
         return 0;
@@ -496,8 +502,14 @@ int execute_object_command_impl(valkey_glide_object* valkey_glide,
         char* subcommand_copy = estrndup(subcommand, subcommand_len);
 
         /* Buffer command for batch execution */
-        int result = buffer_command_for_batch(
-            valkey_glide, req_type, args, args_len, 1, subcommand_copy, process_object_result);
+        int result = buffer_command_for_batch(valkey_glide,
+                                              req_type,
+                                              args,
+                                              args_len,
+                                              1,
+                                              subcommand_copy,
+                                              process_object_result,
+                                              batch_result_efree);
 
         if (result) {
             /* In batch mode, return $this for method chaining */
@@ -524,7 +536,7 @@ int execute_object_command_impl(valkey_glide_object* valkey_glide,
     }
 
     /* Clean up */
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 
     return ret_val;
 }
@@ -837,12 +849,26 @@ int execute_select_command(zval* object, int argc, zval* return_value, zend_clas
         return 0;
     }
 
-    /* Execute the SELECT command using the Glide client */
-    if (execute_select_command_internal(valkey_glide, dbindex, return_value)) {
-        return 1;
+    /* Execute the SELECT command on the blocking client, even from inside a Fiber */
+    valkey_glide_async_pin(valkey_glide->glide_client, true);
+    int selected = execute_select_command_internal(valkey_glide, dbindex, return_value);
+    valkey_glide_async_pin(valkey_glide->glide_client, false);
+    if (!selected) {
+        return 0;
     }
 
-    return 0;
+    /* The async_io companion is a separate connection and must use the same database */
+    char          db_str[MAX_LENGTH_OF_LONG];
+    uintptr_t     db_arg[1] = {(uintptr_t) db_str};
+    unsigned long db_len[1] = {(unsigned long) snprintf(db_str, sizeof(db_str), "%ld", dbindex)};
+    if (!valkey_glide_async_mirror(valkey_glide->glide_client, Select, 1, db_arg, db_len)) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "SELECT failed on the async_io connection",
+                             0);
+        return 0;
+    }
+
+    return 1;
 }
 
 /* Execute a MOVE command using the Valkey Glide client */
@@ -19,18 +19,20 @@
 #include <zend.h>
 #include <zend_API.h>
 #include <zend_exceptions.h>
+#include <zend_smart_str.h>
 
 #include "command_response.h"
 #include "ext/standard/php_var.h"
 #include "include/glide_bindings.h"
+#include "valkey_glide_allocstats.h"
+#include "valkey_glide_async.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
 #include "valkey_glide_hash_common.h"
+#include "valkey_glide_otel.h"
 #include "valkey_glide_z_common.h"
 
 /* Helper functions for batch state management */
-static void clear_batch_state(valkey_glide_object* valkey_glide);
-
 static void expand_command_buffer(valkey_glide_object* valkey_glide);
 
 /* Helper function to process array arguments for FCALL commands */
@@ -129,8 +131,13 @@ int execute_wait_command(zval* object, int argc, zval* return_value, zend_class_
 
 /* Helper function implementations */
 
+/* Cleanup for a result_ptr that is a single emalloc'd block */
+void batch_result_efree(void* result_ptr) {
+    efree(result_ptr);
+}
+
 /* Clear batch state and free buffered commands */
-static void clear_batch_state(valkey_glide_object* valkey_glide) {
+void clear_batch_state(valkey_glide_object* valkey_glide) {
     if (!valkey_glide) {
         return;
     }
@@ -155,6 +162,12 @@ static void clear_batch_state(valkey_glide_object* valkey_glide) {
             if (cmd->arg_lengths) {
                 efree(cmd->arg_lengths);
             }
+
+            /* Still set only when the command never reached its processor (discard, failed
+             * exec), which would otherwise have taken ownership */
+            if (cmd->result_ptr && cmd->free_result) {
+                cmd->free_result(cmd->result_ptr);
+            }
         }
 
         efree(valkey_glide->buffered_commands);
@@ -200,7 +213,8 @@ int buffer_command_for_batch(valkey_glide_object* valkey_glide,
                              const unsigned long* arg_lengths,
                              uintptr_t            arg_count,
                              void*                result_ptr,
-                             z_result_processor_t process_result) {
+                             z_result_processor_t process_result,
+                             z_result_cleanup_t   free_result) {
     if (!valkey_glide || !valkey_glide->is_in_batch_mode) {
         return 0;
     }
@@ -220,6 +234,7 @@ int buffer_command_for_batch(valkey_glide_object* valkey_glide,
     cmd->arg_count      = arg_count;
     cmd->result_ptr     = result_ptr;
     cmd->process_result = process_result;
+    cmd->free_result    = free_result;
 
 
     /* Copy arguments */
@@ -514,9 +529,16 @@ static int process_function_command_reposonse(CommandResponse* response,
         response, return_value, COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP_FUNCTION, true);
 }
 
+/* output is NULL, or an emalloc'ed zend_long of VALKEY_GLIDE_SCRIPT_DECODE_* flags */
 static int process_fcall_command_reposonse(CommandResponse* response,
                                            void*            output,
                                            zval*            return_value) {
+    if (output) {
+        /* Maps already decode as key => value for FCALL */
+        int decode = (int) *(zend_long*) output | VALKEY_GLIDE_SCRIPT_DECODE_MAPS;
+        efree(output);
+        return command_response_to_script_zval(response, return_value, decode);
+    }
     return command_response_to_zval(
         response, return_value, COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP, false);
 }
@@ -619,13 +641,13 @@ int execute_function_command(zval* object, int argc, zval* return_value, zend_cl
 
             if (!result || result->command_error || !result->response) {
                 if (result) {
-                    free_command_result(result);
+                    valkey_glide_free_command_result(result);
                 }
                 return 0;
             }
 
             int status = process_core_bool_result(result->response, NULL, return_value);
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
             return status;
         } else if (strcasecmp(operation, "RESTORE") == 0) {
             /* RESTORE expects: payload */
@@ -649,13 +671,13 @@ int execute_function_command(zval* object, int argc, zval* return_value, zend_cl
 
             if (!result || result->command_error || !result->response) {
                 if (result) {
-                    free_command_result(result);
+                    valkey_glide_free_command_result(result);
                 }
                 return 0;
             }
 
             int status = process_core_bool_result(result->response, NULL, return_value);
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
             return status;
         }
     }
@@ -805,13 +827,13 @@ static int process_script_operation(valkey_glide_object* valkey_glide,
             // Check if command succeeded
             if (!result || result->command_error) {
                 if (result) {
-                    free_command_result(result);
+                    valkey_glide_free_command_result(result);
                 }
                 efree(hash);
                 return 0;
             }
 
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
             ZVAL_STRING(return_value, hash);
             efree(hash);
             return 1;
@@ -914,6 +936,114 @@ int execute_discard_command(zval* object, int argc, zval* return_value, zend_cla
     }
 }
 
+/* Read-only commands whose replies can be shared: by identical entries of one batch, and by
+ * identical async_io reads in flight at the same time */
+bool is_coalescable_read(enum RequestType request_type) {
+    switch (request_type) {
+        case Get:
+        case MGet:
+        case GetRange:
+        case Strlen:
+        case Exists:
+        case Type:
+        case TTL:
+        case PTTL:
+        case HGet:
+        case HGetAll:
+        case HMGet:
+        case HKeys:
+        case HVals:
+        case HLen:
+        case HExists:
+        case HStrlen:
+        case SMembers:
+        case SIsMember:
+        case SMIsMember:
+        case SCard:
+        case ZRange:
+        case ZScore:
+        case ZMScore:
+        case ZCard:
+        case ZRank:
+        case ZRevRank:
+        case ZCount:
+        case LRange:
+        case LLen:
+        case LIndex:
+        case XRange:
+        case XRevRange:
+        case XLen:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+ * Map every buffered command to the slot of the batch that carries its reply.
+ * With OPT_COALESCE_READS enabled, a read identical (type and argument bytes) to an
+ * earlier read is not sent again and reuses that read's slot; leader_of[i] names the
+ * command whose reply is shared. Any non-read command closes the window, since it may
+ * change what a later read would return. Returns the number of commands to send.
+ */
+static size_t coalesce_batch_reads(valkey_glide_object* valkey_glide,
+                                   size_t*              slot_of,
+                                   size_t*              leader_of) {
+    size_t i, j;
+
+    if (!valkey_glide->opt_coalesce_reads) {
+        for (i = 0; i < valkey_glide->command_count; i++) {
+            slot_of[i]   = i;
+            leader_of[i] = i;
+        }
+        return valkey_glide->command_count;
+    }
+
+    HashTable seen;
+    smart_str key   = {0};
+    size_t    slots = 0;
+
+    zend_hash_init(&seen, 8, NULL, NULL, 0);
+
+    for (i = 0; i < valkey_glide->command_count; i++) {
+        struct batch_command* cmd = &valkey_glide->buffered_commands[i];
+
+        leader_of[i] = i;
+        if (!is_coalescable_read(cmd->request_type)) {
+            zend_hash_clean(&seen);
+            slot_of[i] = slots++;
+            continue;
+        }
+
+        /* Length-prefixed arguments keep the key binary safe and unambiguous */
+        if (key.s) {
+            ZSTR_LEN(key.s) = 0;
+        }
+        smart_str_appendl(&key, (const char*) &cmd->request_type, sizeof(cmd->request_type));
+        for (j = 0; j < cmd->arg_count; j++) {
+            smart_str_appendl(&key, (const char*) &cmd->arg_lengths[j], sizeof(uintptr_t));
+            if (cmd->arg_lengths[j] > 0) {
+                smart_str_appendl(&key, (const char*) cmd->args[j], cmd->arg_lengths[j]);
+            }
+        }
+
+        zval* leader = zend_hash_str_find(&seen, ZSTR_VAL(key.s), ZSTR_LEN(key.s));
+        if (leader) {
+            leader_of[i] = (size_t) Z_LVAL_P(leader);
+            slot_of[i]   = slot_of[leader_of[i]];
+        } else {
+            zval idx;
+            ZVAL_LONG(&idx, (zend_long) i);
+            zend_hash_str_add(&seen, ZSTR_VAL(key.s), ZSTR_LEN(key.s), &idx);
+            slot_of[i] = slots++;
+        }
+    }
+
+    smart_str_free(&key);
+    zend_hash_destroy(&seen);
+    return slots;
+}
+
 /* Execute an EXEC command using the Valkey Glide client - UPDATED FOR BUFFERING */
 int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
@@ -936,27 +1066,37 @@ int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_
         return 0;
     }
 
+    /* Work out which commands actually go on the wire */
+    size_t* slot_of   = (size_t*) emalloc(2 * valkey_glide->command_count * sizeof(size_t));
+    size_t* leader_of = slot_of + valkey_glide->command_count;
+    size_t  slots     = coalesce_batch_reads(valkey_glide, slot_of, leader_of);
+
     /* Convert buffered commands to FFI BatchInfo structure */
-    struct CmdInfo** cmd_infos =
-        (struct CmdInfo**) emalloc(valkey_glide->command_count * sizeof(struct CmdInfo*));
+    struct CmdInfo** cmd_infos = (struct CmdInfo**) emalloc(slots * sizeof(struct CmdInfo*));
     if (!cmd_infos) {
+        efree(slot_of);
         clear_batch_state(valkey_glide);
         ZVAL_FALSE(return_value);
         return 0;
     }
 
-    /* Create CmdInfo structures for each buffered command */
+    /* Create CmdInfo structures for each command that is sent */
     size_t i;
     for (i = 0; i < valkey_glide->command_count; i++) {
+        if (leader_of[i] != i) {
+            continue;
+        }
+
         struct batch_command* buffered = &valkey_glide->buffered_commands[i];
         struct CmdInfo*       cmd_info = (struct CmdInfo*) emalloc(sizeof(struct CmdInfo));
 
         if (!cmd_info) {
             /* Cleanup on error */
-            for (size_t j = 0; j < i; j++) {
+            for (size_t j = 0; j < slot_of[i]; j++) {
                 efree(cmd_infos[j]);
             }
             efree(cmd_infos);
+            efree(slot_of);
             clear_batch_state(valkey_glide);
             ZVAL_FALSE(return_value);
             return 0;
@@ -967,25 +1107,43 @@ int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_
         cmd_info->arg_count    = buffered->arg_count;
         cmd_info->args_len     = (const uintptr_t*) buffered->arg_lengths;
 
-        cmd_infos[i] = cmd_info;
+        cmd_infos[slot_of[i]] = cmd_info;
     }
 
     /* Create BatchInfo structure */
-    struct BatchInfo batch_info = {.cmd_count = valkey_glide->command_count,
+    struct BatchInfo batch_info = {.cmd_count = slots,
                                    .cmds      = (const struct CmdInfo* const*) cmd_infos,
                                    .is_atomic = (valkey_glide->batch_type == MULTI)};
 
-    /* Execute via FFI batch() function */
-    struct CommandResult* result = batch(valkey_glide->glide_client,
-                                         0, /* callback_index (not used for sync) */
-                                         &batch_info,
-                                         false, /* raise_on_error */
-                                         NULL,  /* options */
-                                         0      /* span_ptr */
-    );
+    valkey_glide_alloc_stats_phase(Exec, VALKEY_GLIDE_ALLOC_EXECUTE);
+
+    /* Trace the batch as a whole, with one child span per command it carries */
+    uint64_t  span_ptr    = valkey_glide_create_batch_span();
+    uint64_t* child_spans = valkey_glide_create_batch_child_spans(span_ptr, batch_info.cmds, slots);
+
+    /* Execute via FFI batch() function, yielding the current Fiber when async I/O is enabled */
+    struct CommandResult*   result;
+    valkey_glide_async_ctx* async_ctx = valkey_glide_async_route(valkey_glide->glide_client);
+    if (async_ctx) {
+        result = valkey_glide_async_batch(async_ctx, &batch_info, false, span_ptr);
+    } else {
+        result = batch(valkey_glide->glide_client,
+                       0, /* callback_index (not used for sync) */
+                       &batch_info,
+                       false, /* raise_on_error */
+                       NULL,  /* options */
+                       span_ptr);
+    }
+    valkey_glide_drop_batch_spans(span_ptr, child_spans, slots);
+    valkey_glide_alloc_stats_phase(Exec, VALKEY_GLIDE_ALLOC_CONVERT);
+
+    /* A transaction that reached the server ended any WATCH on the blocking client */
+    if (batch_info.is_atomic && result && !result->command_error) {
+        valkey_glide_async_set_watching(valkey_glide->glide_client, false);
+    }
 
     /* Free CmdInfo structures */
-    for (i = 0; i < valkey_glide->command_count; i++) {
+    for (i = 0; i < slots; i++) {
         efree(cmd_infos[i]);
     }
     efree(cmd_infos);
@@ -995,7 +1153,8 @@ int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_
     if (result) {
         if (result->command_error) {
             /* Command failed */
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
+            efree(slot_of);
             clear_batch_state(valkey_glide);
             ZVAL_FALSE(return_value);
             return 0;
@@ -1003,20 +1162,33 @@ int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_
         status = 1; /* Assume success unless we find issues */
         if (result->response) {
             if (result->response->response_type != Array ||
-                result->response->array_value_len != valkey_glide->command_count) {
+                (size_t) result->response->array_value_len != slots) {
                 ZVAL_FALSE(return_value);
                 status = 0;
-                free_command_result(result);
+                valkey_glide_free_command_result(result);
+                efree(slot_of);
                 clear_batch_state(valkey_glide);
                 return status;
             }
             array_init(return_value);
-            for (int64_t idx = 0; idx < result->response->array_value_len; idx++) {
-                zval value;
-                int  process_status = valkey_glide->buffered_commands[idx].process_result(
-                    &result->response->array_value[idx],
-                    valkey_glide->buffered_commands[idx].result_ptr,
-                    &value);
+            for (size_t idx = 0; idx < valkey_glide->command_count; idx++) {
+                struct batch_command* buffered = &valkey_glide->buffered_commands[idx];
+                struct batch_command* leader   = &valkey_glide->buffered_commands[leader_of[idx]];
+                zval                  value;
+
+                /* A coalesced read decoded the same way shares the leader's zval */
+                if (leader != buffered && leader->process_result == buffered->process_result &&
+                    !leader->result_ptr && !buffered->result_ptr) {
+                    zval* shared = zend_hash_index_find(Z_ARRVAL_P(return_value), leader_of[idx]);
+                    if (shared) {
+                        ZVAL_COPY(&value, shared);
+                        add_next_index_zval(return_value, &value);
+                        continue;
+                    }
+                }
+
+                int process_status = buffered->process_result(
+                    &result->response->array_value[slot_of[idx]], buffered->result_ptr, &value);
 
                 if (process_status) {
                     /* Add the processed result to return array */
@@ -1029,6 +1201,12 @@ int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_
                     add_next_index_zval(return_value, &value);
                 }
             }
+
+            /* Every processor has run and owns its result_ptr now; clear them only after the
+             * loop, as the coalescing check above still reads the leader's */
+            for (size_t idx = 0; idx < valkey_glide->command_count; idx++) {
+                valkey_glide->buffered_commands[idx].result_ptr = NULL;
+            }
         } else {
             /* Failed to get responses array, return false */
             ZVAL_FALSE(return_value);
@@ -1036,7 +1214,8 @@ int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_
         }
     }
 
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
+    efree(slot_of);
     clear_batch_state(valkey_glide);
     return status;
 }
@@ -1048,6 +1227,7 @@ static int execute_fcall_command_internal(zval*                object,
                                           size_t               name_len,
                                           zval*                keys_array,
                                           zval*                args_array,
+                                          zend_long            decode,
                                           enum RequestType     command_type,
                                           zval*                return_value) {
     /* Check if name is valid */
@@ -1094,14 +1274,21 @@ static int execute_fcall_command_internal(zval*                object,
     CommandResult* result = NULL;
     /* Check for batch mode */
     if (valkey_glide->is_in_batch_mode) {
+        zend_long* decode_ptr = NULL;
+        if (decode) {
+            decode_ptr  = emalloc(sizeof(zend_long));
+            *decode_ptr = decode;
+        }
+
         /* Create batch-compatible processor wrapper */
         int res = buffer_command_for_batch(valkey_glide,
                                            command_type,
                                            cmd_args,
                                            args_len,
                                            arg_count,
-                                           NULL,
-                                           process_fcall_command_reposonse);
+                                           decode_ptr,
+                                           process_fcall_command_reposonse,
+                                           batch_result_efree);
     } else {
         result = execute_command(valkey_glide->glide_client,
                                  command_type, /* command type */
@@ -1133,19 +1320,24 @@ static int execute_fcall_command_internal(zval*                object,
     if (result->command_error) {
         zend_throw_exception(
             get_valkey_glide_exception_ce(), result->command_error->command_error_message, 0);
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
         return 0;
     }
 
     if (!result->response) {
         zend_throw_exception(get_valkey_glide_exception_ce(), "FCall: No response received", 0);
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
         return 0;
     }
 
     /* FCALL can return various types */
-    status = process_fcall_command_reposonse(result->response, NULL, return_value);
-    free_command_result(result);
+    if (decode) {
+        status = command_response_to_script_zval(
+            result->response, return_value, (int) decode | VALKEY_GLIDE_SCRIPT_DECODE_MAPS);
+    } else {
+        status = process_fcall_command_reposonse(result->response, NULL, return_value);
+    }
+    valkey_glide_free_command_result(result);
     return status;
 }
 
@@ -1156,11 +1348,19 @@ int execute_fcall_command(zval* object, int argc, zval* return_value, zend_class
     size_t               name_len;
     zval*                keys_array = NULL;
     zval*                args_array = NULL;
+    zend_long            decode     = 0;
 
     /* Parse parameters */
-    if (zend_parse_method_parameters(
-            argc, object, "Osa|a", &object, ce, &name, &name_len, &keys_array, &args_array) ==
-        FAILURE) {
+    if (zend_parse_method_parameters(argc,
+                                     object,
+                                     "Osa|al",
+                                     &object,
+                                     ce,
+                                     &name,
+                                     &name_len,
+                                     &keys_array,
+                                     &args_array,
+                                     &decode) == FAILURE) {
         return 0;
     }
 
@@ -1169,8 +1369,15 @@ int execute_fcall_command(zval* object, int argc, zval* return_value, zend_class
 
     /* If we have a Glide client, use it */
     if (valkey_glide->glide_client) {
-        return execute_fcall_command_internal(
-            object, valkey_glide, name, name_len, keys_array, args_array, FCall, return_value);
+        return execute_fcall_command_internal(object,
+                                              valkey_glide,
+                                              name,
+                                              name_len,
+                                              keys_array,
+                                              args_array,
+                                              decode,
+                                              FCall,
+                                              return_value);
     }
 
     return 0;
@@ -1183,11 +1390,19 @@ int execute_fcall_ro_command(zval* object, int argc, zval* return_value, zend_cl
     size_t               name_len;
     zval*                keys_array = NULL;
     zval*                args_array = NULL;
+    zend_long            decode     = 0;
 
     /* Parse parameters */
-    if (zend_parse_method_parameters(
-            argc, object, "Osa|a", &object, ce, &name, &name_len, &keys_array, &args_array) ==
-        FAILURE) {
+    if (zend_parse_method_parameters(argc,
+                                     object,
+                                     "Osa|al",
+                                     &object,
+                                     ce,
+                                     &name,
+                                     &name_len,
+                                     &keys_array,
+                                     &args_array,
+                                     &decode) == FAILURE) {
         return 0;
     }
 
@@ -1202,6 +1417,7 @@ int execute_fcall_ro_command(zval* object, int argc, zval* return_value, zend_cl
                                               name_len,
                                               keys_array,
                                               args_array,
+                                              decode,
                                               FCallReadOnly,
                                               return_value);
     }
@@ -1394,8 +1610,14 @@ int execute_restore_command(zval* object, int argc, zval* return_value, zend_cla
         CommandResult* result = NULL;
         if (valkey_glide->is_in_batch_mode) {
             /* Create batch-compatible processor wrapper */
-            int res = buffer_command_for_batch(
-                valkey_glide, Restore, args, args_len, arg_count, NULL, process_h_ok_result_async);
+            int res = buffer_command_for_batch(valkey_glide,
+                                               Restore,
+                                               args,
+                                               args_len,
+                                               arg_count,
+                                               NULL,
+                                               process_h_ok_result_async,
+                                               NULL);
         } else {
             /* Execute the command */
             result = execute_command(valkey_glide->glide_client,
@@ -1429,11 +1651,11 @@ int execute_restore_command(zval* object, int argc, zval* return_value, zend_cla
             if (result) {
                 if (result->command_error) {
                     /* Command failed */
-                    free_command_result(result);
+                    valkey_glide_free_command_result(result);
                     return 0;
                 }
                 status = process_h_ok_result_async(result->response, NULL, return_value);
-                free_command_result(result);
+                valkey_glide_free_command_result(result);
             }
         }
 
@@ -1662,7 +1884,8 @@ int execute_config_command(zval* object, int argc, zval* return_value, zend_clas
                                          arg_count,
 
                                          command_type_ptr,
-                                         process_config_command_respose)) {
+                                         process_config_command_respose,
+                                         batch_result_efree)) {
                 /* Return $this */
                 ZVAL_COPY(return_value, object);
                 status = 1;
@@ -1681,7 +1904,7 @@ int execute_config_command(zval* object, int argc, zval* return_value, zend_clas
             if (result) {
                 if (result->command_error) {
                     /* Command failed */
-                    free_command_result(result);
+                    valkey_glide_free_command_result(result);
                     return 0;
                 }
 
@@ -1691,7 +1914,7 @@ int execute_config_command(zval* object, int argc, zval* return_value, zend_clas
                     status                             = process_config_command_respose(
                         result->response, command_type_ptr, return_value);
                 }
-                free_command_result(result);
+                valkey_glide_free_command_result(result);
             }
         }
 
@@ -1782,7 +2005,7 @@ int execute_client_command_internal(
     if (result) {
         if (result->command_error) {
             /* Command failed */
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
             return 0;
         }
         if (result->response) {
@@ -1792,7 +2015,7 @@ int execute_client_command_internal(
             *ctx                  = command_type;
             status = command_response_to_zval_wrapper(result->response, ctx, return_value);
         }
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
     }
     return status;
 }
@@ -1881,7 +2104,7 @@ int execute_rawcommand_command_internal(
     if (result) {
         if (result->command_error) {
             /* Command failed */
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
             return 0;
         }
 
@@ -1890,7 +2113,7 @@ int execute_rawcommand_command_internal(
             status = command_response_to_zval(
                 result->response, return_value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
         }
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
     }
 
     return status;
@@ -1953,7 +2176,8 @@ int execute_client_command(zval* object, int argc, zval* return_value, zend_clas
                                                      args_len,
                                                      arg_count - 1, /* number of args */
                                                      output,        /* result_ptr */
-                                                     command_response_to_zval_wrapper);
+                                                     command_response_to_zval_wrapper,
+                                                     batch_result_efree);
 
         /* Free the argument arrays */
         if (cmd_args)
@@ -2060,7 +2284,6 @@ int execute_dbsize_command(zval* object, int argc, zval* return_value, zend_clas
     valkey_glide_object* valkey_glide;
     zval*                args       = NULL;
     int                  args_count = 0;
-    long                 dbsize;
     zend_bool            is_cluster = (ce == get_valkey_glide_cluster_ce());
 
     /* Get ValkeyGlide object */
@@ -2102,7 +2325,7 @@ int execute_dbsize_command(zval* object, int argc, zval* return_value, zend_clas
     }
     /* Execute using unified core framework */
     if (execute_core_command(
-            valkey_glide, &core_args, &dbsize, process_core_int_result, return_value)) {
+            valkey_glide, &core_args, NULL, process_core_int_result, return_value)) {
         if (valkey_glide->is_in_batch_mode) {
             /* In batch mode, return $this for method chaining */
             ZVAL_COPY(return_value, object);
@@ -25,6 +25,10 @@
 
 #include "command_response.h"
 #include "common.h"
+#include "valkey_glide_allocstats.h"
+#include "valkey_glide_async.h"
+#include "valkey_glide_latency.h"
+#include "valkey_glide_slowlog.h"
 #include "include/glide/connection_request.pb-c.h"
 #include "include/glide_bindings.h"
 
@@ -76,7 +80,7 @@ static inline void handle_command_result_or_throw(CommandResult* result,
     if (result->command_error) {
         zend_throw_exception(
             get_valkey_glide_exception_ce(), result->command_error->command_error_message, 0);
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
         return;
     }
     if (!result->response) {
@@ -84,11 +88,11 @@ static inline void handle_command_result_or_throw(CommandResult* result,
         sprintf(error_msg, "%s: No response received", command_name);
         zend_throw_exception(get_valkey_glide_exception_ce(), error_msg, 0);
         efree(error_msg);
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
         return;
     }
     command_response_to_zval(result->response, return_value, 0, false);
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 }
 
 // Helper that returns false on errors instead of throwing exceptions
@@ -97,12 +101,12 @@ static inline int handle_function_command_result_or_return_false(CommandResult*
     if (!result || result->command_error || !result->response) {
         ZVAL_FALSE(return_value);
         if (result) {
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
         }
         return 0;
     }
     int status = command_response_to_zval(result->response, return_value, 0, false);
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
     return status;
 }
 
@@ -238,6 +242,17 @@ int execute_multi_command(zval* object, int argc, zval* return_value, zend_class
 int execute_pipeline_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_discard_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+bool is_coalescable_read(enum RequestType request_type);
+int execute_bulk_load_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_migrate_keys_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_hgetall_chunked_command(zval*             object,
+                                    int               argc,
+                                    zval*             return_value,
+                                    zend_class_entry* ce);
+int execute_prepare_function_command(zval*             object,
+                                     int               argc,
+                                     zval*             return_value,
+                                     zend_class_entry* ce);
 int execute_fcall_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_fcall_ro_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 
@@ -1181,6 +1196,62 @@ int execute_unlink_command(zval* object, int argc, zval* return_value, zend_clas
         RETURN_FALSE;                                                           \
     }
 
+#define BULK_LOAD_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, bulkLoad) {                                              \
+        if (execute_bulk_load_command(getThis(),                                     \
+                                      ZEND_NUM_ARGS(),                               \
+                                      return_value,                                  \
+                                      strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                          ? get_valkey_glide_cluster_ce()            \
+                                          : get_valkey_glide_ce())) {                \
+            return;                                                                  \
+        }                                                                            \
+        zval_dtor(return_value);                                                     \
+        RETURN_FALSE;                                                                \
+    }
+
+#define MIGRATE_KEYS_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, migrateKeys) {                                              \
+        if (execute_migrate_keys_command(getThis(),                                     \
+                                         ZEND_NUM_ARGS(),                               \
+                                         return_value,                                  \
+                                         strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                             ? get_valkey_glide_cluster_ce()            \
+                                             : get_valkey_glide_ce())) {                \
+            return;                                                                     \
+        }                                                                               \
+        zval_dtor(return_value);                                                        \
+        RETURN_FALSE;                                                                   \
+    }
+
+#define HGETALL_CHUNKED_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, hGetAllChunked) {                                              \
+        if (execute_hgetall_chunked_command(getThis(),                                     \
+                                            ZEND_NUM_ARGS(),                               \
+                                            return_value,                                  \
+                                            strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                                ? get_valkey_glide_cluster_ce()            \
+                                                : get_valkey_glide_ce())) {                \
+            return;                                                                        \
+        }                                                                                  \
+        zval_dtor(return_value);                                                           \
+        RETURN_FALSE;                                                                      \
+    }
+
+#define PREPARE_FUNCTION_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, prepareFunction) {                                              \
+        if (execute_prepare_function_command(getThis(),                                     \
+                                             ZEND_NUM_ARGS(),                               \
+                                             return_value,                                  \
+                                             strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                                 ? get_valkey_glide_cluster_ce()            \
+                                                 : get_valkey_glide_ce())) {                \
+            return;                                                                         \
+        }                                                                                   \
+        zval_dtor(return_value);                                                            \
+        RETURN_FALSE;                                                                       \
+    }
+
 #define FCALL_METHOD_IMPL(class_name)                                            \
     PHP_METHOD(class_name, fcall) {                                              \
         if (execute_fcall_command(getThis(),                                     \
@@ -1538,6 +1609,15 @@ void execute_script_command(zval* object, int argc, zval* return_value, zend_cla
             case VALKEY_GLIDE_OPT_SCAN:                                       \
                 valkey_glide->opt_scan = zval_get_long(value);                \
                 RETURN_TRUE;                                                  \
+            case VALKEY_GLIDE_OPT_COALESCE_READS:                             \
+                valkey_glide->opt_coalesce_reads = zval_is_true(value);       \
+                valkey_glide_async_set_coalesce_reads(                        \
+                    valkey_glide->glide_client,                               \
+                    valkey_glide->opt_coalesce_reads);                        \
+                RETURN_TRUE;                                                  \
+            case VALKEY_GLIDE_OPT_PACKED_NUMERICS:                            \
+                valkey_glide->opt_packed_numerics = zval_is_true(value);      \
+                RETURN_TRUE;                                                  \
             case VALKEY_GLIDE_OPT_READ_TIMEOUT:                               \
             case VALKEY_GLIDE_OPT_FAILOVER:                                   \
             case VALKEY_GLIDE_OPT_TCP_KEEPALIVE:                              \
@@ -1583,6 +1663,10 @@ void execute_script_command(zval* object, int argc, zval* return_value, zend_cla
                 RETURN_LONG(valkey_glide->opt_serializer);                                  \
             case VALKEY_GLIDE_OPT_SCAN:                                                     \
                 RETURN_LONG(valkey_glide->opt_scan);                                        \
+            case VALKEY_GLIDE_OPT_COALESCE_READS:                                           \
+                RETURN_LONG(valkey_glide->opt_coalesce_reads);                              \
+            case VALKEY_GLIDE_OPT_PACKED_NUMERICS:                                          \
+                RETURN_LONG(valkey_glide->opt_packed_numerics);                             \
             case VALKEY_GLIDE_OPT_READ_TIMEOUT:                                             \
             case VALKEY_GLIDE_OPT_FAILOVER:                                                 \
             case VALKEY_GLIDE_OPT_TCP_KEEPALIVE:                                            \
@@ -1651,4 +1735,112 @@ unsigned long get_min_compressed_size(void);
             return_value, "compression_skipped_count", stats.compression_skipped_count);          \
     }
 
+#define GET_LATENCY_STATS_METHOD_IMPL(class_name)          \
+    PHP_METHOD(class_name, getLatencyStats) {              \
+        zend_string* command = NULL;                       \
+                                                           \
+        ZEND_PARSE_PARAMETERS_START(0, 1)                  \
+        Z_PARAM_OPTIONAL                                   \
+        Z_PARAM_STR_OR_NULL(command)                       \
+        ZEND_PARSE_PARAMETERS_END();                       \
+                                                           \
+        valkey_glide_latency_stats(command, return_value); \
+    }
+
+#define RESET_LATENCY_STATS_METHOD_IMPL(class_name) \
+    PHP_METHOD(class_name, resetLatencyStats) {     \
+        ZEND_PARSE_PARAMETERS_NONE();               \
+                                                    \
+        valkey_glide_latency_reset();               \
+        RETURN_TRUE;                                \
+    }
+
+#define GET_SLOW_LOG_METHOD_IMPL(class_name)           \
+    PHP_METHOD(class_name, getSlowLog) {               \
+        zend_long count = -1;                          \
+                                                       \
+        ZEND_PARSE_PARAMETERS_START(0, 1)              \
+        Z_PARAM_OPTIONAL                               \
+        Z_PARAM_LONG(count)                            \
+        ZEND_PARSE_PARAMETERS_END();                   \
+                                                       \
+        valkey_glide_slowlog_get(count, return_value); \
+    }
+
+#define RESET_SLOW_LOG_METHOD_IMPL(class_name) \
+    PHP_METHOD(class_name, resetSlowLog) {     \
+        ZEND_PARSE_PARAMETERS_NONE();          \
+                                               \
+        valkey_glide_slowlog_reset();          \
+        RETURN_TRUE;                           \
+    }
+
+#define GET_ALLOC_STATS_METHOD_IMPL(class_name)     \
+    PHP_METHOD(class_name, getAllocStats) {         \
+        ZEND_PARSE_PARAMETERS_NONE();               \
+                                                    \
+        valkey_glide_alloc_stats_get(return_value); \
+    }
+
+#define RESET_ALLOC_STATS_METHOD_IMPL(class_name) \
+    PHP_METHOD(class_name, resetAllocStats) {     \
+        ZEND_PARSE_PARAMETERS_NONE();             \
+                                                  \
+        valkey_glide_alloc_stats_reset();         \
+        RETURN_TRUE;                              \
+    }
+
+/* ====================================================================
+ * FIBER SCHEDULING METHOD IMPLEMENTATION MACROS
+ * ==================================================================== */
+
+#define POLL_METHOD_IMPL(class_name)                                               \
+    PHP_METHOD(class_name, poll) {                                                 \
+        double timeout = 0.0;                                                      \
+                                                                                   \
+        ZEND_PARSE_PARAMETERS_START(0, 1)                                          \
+        Z_PARAM_OPTIONAL                                                           \
+        Z_PARAM_DOUBLE(timeout)                                                    \
+        ZEND_PARSE_PARAMETERS_END();                                               \
+                                                                                   \
+        valkey_glide_object* valkey_glide =                                        \
+            VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, getThis());      \
+        if (!valkey_glide || !valkey_glide->glide_client) {                        \
+            RETURN_LONG(0);                                                        \
+        }                                                                          \
+                                                                                   \
+        RETURN_LONG(valkey_glide_async_poll(valkey_glide->glide_client, timeout)); \
+    }
+
+#define SET_SUSPENSION_FACTORY_METHOD_IMPL(class_name)                                           \
+    PHP_METHOD(class_name, setSuspensionFactory) {                                               \
+        zend_fcall_info       fci = empty_fcall_info;                                            \
+        zend_fcall_info_cache fcc = empty_fcall_info_cache;                                      \
+                                                                                                 \
+        ZEND_PARSE_PARAMETERS_START(1, 1)                                                        \
+        Z_PARAM_FUNC_OR_NULL(fci, fcc)                                                           \
+        ZEND_PARSE_PARAMETERS_END();                                                             \
+                                                                                                 \
+        valkey_glide_object* valkey_glide =                                                      \
+            VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, getThis());                    \
+        if (!valkey_glide || !valkey_glide->glide_client) {                                      \
+            RETURN_FALSE;                                                                        \
+        }                                                                                        \
+                                                                                                 \
+        RETURN_BOOL(valkey_glide_async_set_suspension_factory(                                   \
+            valkey_glide->glide_client, ZEND_FCI_INITIALIZED(fci) ? &fci.function_name : NULL)); \
+    }
+
+#define GET_COMPLETION_STREAM_METHOD_IMPL(class_name)                                          \
+    PHP_METHOD(class_name, getCompletionStream) {                                              \
+        ZEND_PARSE_PARAMETERS_NONE();                                                          \
+                                                                                               \
+        valkey_glide_object* valkey_glide =                                                    \
+            VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, getThis());                  \
+        if (!valkey_glide || !valkey_glide->glide_client ||                                    \
+            !valkey_glide_async_completion_stream(valkey_glide->glide_client, return_value)) { \
+            RETURN_FALSE;                                                                      \
+        }                                                                                      \
+    }
+
 #endif /* VALKEY_GLIDE_COMMANDS_COMMON_H */
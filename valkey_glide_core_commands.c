@@ -28,6 +28,7 @@
 #include "common.h"
 #include "include/glide_bindings.h"
 #include "logger.h"
+#include "valkey_glide_async.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
 #include "valkey_glide_list_common.h"
@@ -258,14 +259,21 @@ static const ConnectionResponse* create_base_glide_client(
     const ConnectionResponse* conn_resp =
         create_client(request_bytes, len, &client_type, valkey_glide_pubsub_callback);
 
-    /* Free the request bytes as they're no longer needed */
-    efree(request_bytes);
-
     /* Check if there was an error */
     if (conn_resp->connection_error_message) {
         VALKEY_LOG_ERROR("client_creation", conn_resp->connection_error_message);
+    } else if (config->advanced_config && config->advanced_config->async_io) {
+        /* Callback-driven companion used by commands issued from Fibers */
+        if (!valkey_glide_async_attach(conn_resp->conn_ptr, request_bytes, len)) {
+            php_error_docref(NULL,
+                             E_WARNING,
+                             "Failed to enable async_io, commands in Fibers will block");
+        }
     }
 
+    /* Free the request bytes as they're no longer needed */
+    efree(request_bytes);
+
     return conn_resp;
 }
 
@@ -876,7 +884,8 @@ void close_glide_client(const void* glide_client) {
     if (!glide_client) {
         return;
     }
-    /* Close the client using the close_client function from glide_bindings.h */
+    /* Close the Fiber-aware companion first, then the client itself */
+    valkey_glide_async_detach(glide_client);
     close_client(glide_client);
 }
 
@@ -1254,7 +1263,8 @@ int execute_info_command(zval* object, int argc, zval* return_value, zend_class_
                                                      cmd_args_len,
                                                      processed_args,
                                                      NULL, /* result_ptr */
-                                                     process_info_result);
+                                                     process_info_result,
+                                                     NULL);
 
         /* Free the argument arrays */
         for (int i = 0; i < section_count; i++) {
@@ -1335,12 +1345,12 @@ int execute_info_command(zval* object, int argc, zval* return_value, zend_class_
     /* Process the result */
     if (cmd_result && cmd_result->response != NULL) {
         process_info_result(cmd_result->response, NULL, return_value);
-        free_command_result(cmd_result);
+        valkey_glide_free_command_result(cmd_result);
         return 1;
     }
 
     if (cmd_result) {
-        free_command_result(cmd_result);
+        valkey_glide_free_command_result(cmd_result);
     }
     return 0;
 }
@@ -1606,7 +1616,7 @@ int execute_del_array(const void* glide_client,
             execute_command(args.glide_client, args.cmd_type, arg_count, cmd_args, cmd_args_len);
         if (cmd_result) {
             result = process_core_int_result(cmd_result->response, output_value, return_value);
-            free_command_result(cmd_result);
+            valkey_glide_free_command_result(cmd_result);
         }
     }
     zval_ptr_dtor(&keys_array);
@@ -1693,7 +1703,7 @@ int execute_unlink_array(const void* glide_client,
             execute_command(args.glide_client, args.cmd_type, arg_count, cmd_args, cmd_args_len);
         if (cmd_result) {
             result = process_core_int_result(cmd_result->response, output_value, return_value);
-            free_command_result(cmd_result);
+            valkey_glide_free_command_result(cmd_result);
         }
     }
     zval_ptr_dtor(&keys_array);
@@ -2142,7 +2152,7 @@ int execute_lcs_command(zval* object, int argc, zval* return_value, zend_class_e
     if (valkey_glide->is_in_batch_mode) {
         /* Create batch-compatible processor wrapper */
         int res = buffer_command_for_batch(
-            valkey_glide, LCS, args, args_len, arg_count, NULL, process_lcs_result);
+            valkey_glide, LCS, args, args_len, arg_count, NULL, process_lcs_result, NULL);
     } else {
         cmd_result = execute_command(valkey_glide->glide_client,
                                      LCS,       /* command type */
@@ -2170,7 +2180,7 @@ int execute_lcs_command(zval* object, int argc, zval* return_value, zend_class_e
     }
 
     /* Free the result */
-    free_command_result(cmd_result);
+    valkey_glide_free_command_result(cmd_result);
 
     return ret_val;
 }
@@ -2234,13 +2244,13 @@ void execute_update_connection_password(zval*             object,
                                  : "Unknown error");
         zend_throw_exception(
             get_valkey_glide_exception_ce(), result->command_error->command_error_message, 0);
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
         return;
     }
 
     if (!result->response) {
         VALKEY_LOG_ERROR("update_connection_password", "No response received from server");
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
         zend_throw_exception(
             get_valkey_glide_exception_ce(), "No response received from server", 0);
         return;
@@ -2249,6 +2259,14 @@ void execute_update_connection_password(zval*             object,
     /* Process response */
     if (result->response->response_type == Ok) {
         ZVAL_STRING(return_value, "OK");
+
+        /* Keep the async_io companion connection on the same credentials */
+        if (!valkey_glide_async_mirror_password(
+                valkey_glide->glide_client, password, immediate_auth)) {
+            zend_throw_exception(get_valkey_glide_exception_ce(),
+                                 "Password update failed on the async_io connection",
+                                 0);
+        }
     } else if (result->response->response_type == Error) {
         VALKEY_LOG_ERROR_FMT(
             "update_connection_password",
@@ -2265,5 +2283,5 @@ void execute_update_connection_password(zval*             object,
         zend_throw_exception(get_valkey_glide_exception_ce(), "Unexpected response from server", 0);
     }
 
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 }
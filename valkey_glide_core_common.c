@@ -107,7 +107,8 @@ int execute_core_command(valkey_glide_object* valkey_glide,
                                        arg_count,
 
                                        result_ptr,
-                                       processor);
+                                       processor,
+                                       batch_result_efree);
 
         free_core_args(cmd_args, cmd_args_len, allocated_strings, allocated_count);
         if (res == 0) {
@@ -145,7 +146,7 @@ int execute_core_command(valkey_glide_object* valkey_glide,
     if (result) {
         if (result->response) {
             /* Non-routed commands use standard processor */
-            res = processor(result->response, result_ptr, return_value);
+            res = valkey_glide_async_decode(result, processor, result_ptr, return_value);
         } else {
             VALKEY_LOG_ERROR("execute_core_command", "Command execution returned no response");
             efree(result_ptr);
@@ -153,7 +154,7 @@ int execute_core_command(valkey_glide_object* valkey_glide,
         }
 
         /* Free the result - handle_string_response doesn't free it */
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
     } else {
         VALKEY_LOG_ERROR("execute_core_command", "Command execution failed - NULL result");
         efree(result_ptr);
@@ -0,0 +1,525 @@
+/*
+  +----------------------------------------------------------------------+
+  | ValkeyGlide Function                                                 |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_function.h"
+
+#include <zend_exceptions.h>
+
+#include "command_response.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_function_arginfo.h"
+#include "valkey_glide_z_common.h"
+
+/* Global variables */
+static zend_class_entry*    function_ce;
+static zend_object_handlers function_object_handlers;
+
+#define FUNCTION_FROM_OBJ(o) VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_function_object, o)
+#define Z_FUNCTION_P(zv) FUNCTION_FROM_OBJ(Z_OBJ_P(zv))
+
+/* ====================================================================
+ * OBJECT LIFECYCLE
+ * ==================================================================== */
+
+static zend_object* create_function_object(zend_class_entry* ce) {
+    valkey_glide_function_object* function =
+        zend_object_alloc(sizeof(valkey_glide_function_object), ce);
+
+    zend_object_std_init(&function->std, ce);
+    object_properties_init(&function->std, ce);
+    function->std.handlers = &function_object_handlers;
+
+    return &function->std;
+}
+
+static void free_function_object(zend_object* object) {
+    valkey_glide_function_object* function = FUNCTION_FROM_OBJ(object);
+
+    zval_ptr_dtor(&function->client);
+    if (function->library) {
+        zend_string_release(function->library);
+    }
+    if (function->name) {
+        zend_string_release(function->name);
+    }
+    zend_object_std_dtor(object);
+}
+
+/* Expose the client so a cycle through it can still be collected */
+static HashTable* function_get_gc(zend_object* object, zval** table, int* n) {
+    valkey_glide_function_object* function = FUNCTION_FROM_OBJ(object);
+
+    *table = &function->client;
+    *n     = Z_TYPE(function->client) == IS_OBJECT ? 1 : 0;
+    return zend_std_get_properties(object);
+}
+
+/* Fetch the client of a prepared function, throwing if there is none to use */
+static valkey_glide_object* function_client(valkey_glide_function_object* function) {
+    if (Z_TYPE(function->client) != IS_OBJECT) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "ValkeyGlideFunction must be created with prepareFunction()",
+                             0);
+        return NULL;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &function->client);
+    if (!valkey_glide->glide_client) {
+        zend_throw_exception(get_valkey_glide_exception_ce(), "Client is not connected", 0);
+        return NULL;
+    }
+    return valkey_glide;
+}
+
+/* ====================================================================
+ * FUNCTION LIST METADATA
+ * ==================================================================== */
+
+static bool function_list_string_is(const CommandResponse* value, const char* str, size_t len) {
+    return value && value->response_type == String && (size_t) value->string_value_len == len &&
+           memcmp(value->string_value, str, len) == 0;
+}
+
+/* Field of a FUNCTION LIST entry: a RESP3 map, or the flat [key, value, ...] array of RESP2 */
+static CommandResponse* function_list_field(CommandResponse* entry, const char* name) {
+    size_t len = strlen(name);
+
+    if (entry->response_type == Map) {
+        for (long i = 0; i < entry->array_value_len; i++) {
+            if (function_list_string_is(entry->array_value[i].map_key, name, len)) {
+                return entry->array_value[i].map_value;
+            }
+        }
+    } else if (entry->response_type == Array) {
+        for (long i = 0; i + 1 < entry->array_value_len; i += 2) {
+            if (function_list_string_is(&entry->array_value[i], name, len)) {
+                return &entry->array_value[i + 1];
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Find function `name` of library `lib` in a FUNCTION LIST reply and report whether it has the
+ * no-writes flag. A reply a cluster client collected from one node comes wrapped in a
+ * node address => libraries map. Returns false if the function is not in the reply.
+ */
+static bool function_list_lookup(CommandResponse* response,
+                                 zend_string*     lib,
+                                 zend_string*     name,
+                                 bool*            read_only) {
+    if (response && response->response_type == Map && response->array_value_len > 0) {
+        response = response->array_value[0].map_value;
+    }
+    if (!response || response->response_type != Array) {
+        return false;
+    }
+
+    for (long i = 0; i < response->array_value_len; i++) {
+        CommandResponse* library   = &response->array_value[i];
+        CommandResponse* functions = function_list_field(library, "functions");
+
+        if (!function_list_string_is(
+                function_list_field(library, "library_name"), ZSTR_VAL(lib), ZSTR_LEN(lib)) ||
+            !functions || functions->response_type != Array) {
+            continue;
+        }
+
+        for (long j = 0; j < functions->array_value_len; j++) {
+            CommandResponse* function = &functions->array_value[j];
+            if (!function_list_string_is(
+                    function_list_field(function, "name"), ZSTR_VAL(name), ZSTR_LEN(name))) {
+                continue;
+            }
+
+            CommandResponse* flags = function_list_field(function, "flags");
+            CommandResponse* items = NULL;
+            long             count = 0;
+            if (flags && flags->response_type == Sets) {
+                items = flags->sets_value;
+                count = flags->sets_value_len;
+            } else if (flags && flags->response_type == Array) {
+                items = flags->array_value;
+                count = flags->array_value_len;
+            }
+
+            *read_only = false;
+            for (long k = 0; k < count; k++) {
+                if (function_list_string_is(&items[k], ZEND_STRL("no-writes"))) {
+                    *read_only = true;
+                }
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * prepareFunction(string lib, string name)
+ *
+ * Resolve a function with FUNCTION LIST LIBRARYNAME lib and return a ValkeyGlideFunction
+ * handle for it. Throws if the function is not loaded.
+ */
+int execute_prepare_function_command(zval*             object,
+                                     int               argc,
+                                     zval*             return_value,
+                                     zend_class_entry* ce) {
+    valkey_glide_object* valkey_glide;
+    zend_string*         lib;
+    zend_string*         name;
+    bool                 read_only = false;
+
+    if (zend_parse_method_parameters(argc, object, "OSS", &object, ce, &lib, &name) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "prepareFunction cannot be used inside multi()/pipeline()",
+                             0);
+        return 0;
+    }
+
+    uintptr_t      args[2]     = {(uintptr_t) "LIBRARYNAME", (uintptr_t) ZSTR_VAL(lib)};
+    unsigned long  args_len[2] = {sizeof("LIBRARYNAME") - 1, ZSTR_LEN(lib)};
+    CommandResult* result =
+        execute_command(valkey_glide->glide_client, FunctionList, 2, args, args_len);
+
+    if (!result || result->command_error) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             result ? result->command_error->command_error_message
+                                    : "FUNCTION LIST failed",
+                             0);
+        if (result) {
+            valkey_glide_free_command_result(result);
+        }
+        return 0;
+    }
+
+    bool found = function_list_lookup(result->response, lib, name, &read_only);
+    valkey_glide_free_command_result(result);
+    if (!found) {
+        zend_throw_exception_ex(get_valkey_glide_exception_ce(),
+                                0,
+                                "Function '%s' not found in library '%s'",
+                                ZSTR_VAL(name),
+                                ZSTR_VAL(lib));
+        return 0;
+    }
+
+    object_init_ex(return_value, function_ce);
+    valkey_glide_function_object* function = Z_FUNCTION_P(return_value);
+
+    ZVAL_COPY(&function->client, object);
+    function->library   = zend_string_copy(lib);
+    function->name      = zend_string_copy(name);
+    function->read_only = read_only;
+    return 1;
+}
+
+/* ====================================================================
+ * CALLS
+ * ==================================================================== */
+
+/* FCALL[_RO] name numkeys key... arg... String values are passed without a copy; anything
+ * else is converted once and released with the vector */
+typedef struct {
+    uintptr_t*     args;
+    unsigned long* args_len;
+    zend_string**  owned;
+    uint32_t       count;
+    uint32_t       owned_count;
+    char           numkeys[MAX_LENGTH_OF_LONG];
+} function_argv_t;
+
+static void function_argv_add(function_argv_t* argv, zval* value) {
+    ZVAL_DEREF(value);
+    if (Z_TYPE_P(value) == IS_STRING) {
+        argv->args[argv->count]       = (uintptr_t) Z_STRVAL_P(value);
+        argv->args_len[argv->count++] = Z_STRLEN_P(value);
+        return;
+    }
+
+    zend_string* str                 = zval_get_string(value);
+    argv->owned[argv->owned_count++] = str;
+    argv->args[argv->count]          = (uintptr_t) ZSTR_VAL(str);
+    argv->args_len[argv->count++]    = ZSTR_LEN(str);
+}
+
+static void function_argv_init(function_argv_t*              argv,
+                               valkey_glide_function_object* function,
+                               HashTable*                    keys,
+                               HashTable*                    args) {
+    uint32_t key_count = keys ? zend_hash_num_elements(keys) : 0;
+    uint32_t arg_count = args ? zend_hash_num_elements(args) : 0;
+    uint32_t total     = 2 + key_count + arg_count;
+    zval*    value;
+
+    argv->args        = safe_emalloc(total, sizeof(uintptr_t), 0);
+    argv->args_len    = safe_emalloc(total, sizeof(unsigned long), 0);
+    argv->owned       = safe_emalloc(key_count + arg_count + 1, sizeof(zend_string*), 0);
+    argv->owned_count = 0;
+
+    argv->args[0]     = (uintptr_t) ZSTR_VAL(function->name);
+    argv->args_len[0] = ZSTR_LEN(function->name);
+    argv->args_len[1] = snprintf(argv->numkeys, sizeof(argv->numkeys), "%u", key_count);
+    argv->args[1]     = (uintptr_t) argv->numkeys;
+    argv->count       = 2;
+
+    if (keys) {
+        ZEND_HASH_FOREACH_VAL(keys, value) {
+            function_argv_add(argv, value);
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+    if (args) {
+        ZEND_HASH_FOREACH_VAL(args, value) {
+            function_argv_add(argv, value);
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+}
+
+static void function_argv_free(function_argv_t* argv) {
+    for (uint32_t i = 0; i < argv->owned_count; i++) {
+        zend_string_release(argv->owned[i]);
+    }
+    efree(argv->owned);
+    efree(argv->args);
+    efree(argv->args_len);
+}
+
+/* Same decoding as fcall(); a nil reply is a valid result, not a failure */
+static int process_function_call_result(CommandResponse* response,
+                                        void*            output,
+                                        zval*            return_value) {
+    command_response_to_zval(response, return_value, COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP, false);
+    return 1;
+}
+
+/* Queue one call on the client's batch */
+static bool function_queue(valkey_glide_object*          valkey_glide,
+                           valkey_glide_function_object* function,
+                           HashTable*                    keys,
+                           HashTable*                    args) {
+    function_argv_t argv;
+
+    function_argv_init(&argv, function, keys, args);
+    int status = buffer_command_for_batch(valkey_glide,
+                                          function->read_only ? FCallReadOnly : FCall,
+                                          argv.args,
+                                          argv.args_len,
+                                          argv.count,
+                                          NULL,
+                                          process_function_call_result,
+                                          NULL);
+    function_argv_free(&argv);
+    return status != 0;
+}
+
+/* Keys and args of one callMany() set: [keys, args] or ['keys' => ..., 'args' => ...] */
+static bool function_arg_set(zval* set, HashTable** keys, HashTable** args) {
+    zval* z_keys;
+    zval* z_args;
+
+    ZVAL_DEREF(set);
+    if (Z_TYPE_P(set) != IS_ARRAY) {
+        return false;
+    }
+    z_keys = zend_hash_str_find(Z_ARRVAL_P(set), ZEND_STRL("keys"));
+    z_args = zend_hash_str_find(Z_ARRVAL_P(set), ZEND_STRL("args"));
+    if (!z_keys && !z_args) {
+        z_keys = zend_hash_index_find(Z_ARRVAL_P(set), 0);
+        z_args = zend_hash_index_find(Z_ARRVAL_P(set), 1);
+    }
+    if (z_keys) {
+        ZVAL_DEREF(z_keys);
+    }
+    if (z_args) {
+        ZVAL_DEREF(z_args);
+    }
+    if ((z_keys && Z_TYPE_P(z_keys) != IS_ARRAY) || (z_args && Z_TYPE_P(z_args) != IS_ARRAY)) {
+        return false;
+    }
+
+    *keys = z_keys ? Z_ARRVAL_P(z_keys) : NULL;
+    *args = z_args ? Z_ARRVAL_P(z_args) : NULL;
+    return true;
+}
+
+/* {{{ proto mixed ValkeyGlideFunction::call([array keys, array args]) */
+PHP_METHOD(ValkeyGlideFunction, call) {
+    HashTable* keys = NULL;
+    HashTable* args = NULL;
+
+    ZEND_PARSE_PARAMETERS_START(0, 2)
+    Z_PARAM_OPTIONAL
+    Z_PARAM_ARRAY_HT(keys)
+    Z_PARAM_ARRAY_HT(args)
+    ZEND_PARSE_PARAMETERS_END();
+
+    valkey_glide_function_object* function     = Z_FUNCTION_P(ZEND_THIS);
+    valkey_glide_object*          valkey_glide = function_client(function);
+    if (!valkey_glide) {
+        RETURN_THROWS();
+    }
+
+    if (valkey_glide->is_in_batch_mode) {
+        if (!function_queue(valkey_glide, function, keys, args)) {
+            zend_throw_exception(get_valkey_glide_exception_ce(), "Failed to queue the call", 0);
+            RETURN_THROWS();
+        }
+        RETURN_COPY(&function->client);
+    }
+
+    function_argv_t argv;
+    function_argv_init(&argv, function, keys, args);
+    CommandResult* result = execute_command(valkey_glide->glide_client,
+                                            function->read_only ? FCallReadOnly : FCall,
+                                            argv.count,
+                                            argv.args,
+                                            argv.args_len);
+    function_argv_free(&argv);
+
+    if (!result) {
+        zend_throw_exception(
+            get_valkey_glide_exception_ce(), "FCall: Failed to execute command", 0);
+        RETURN_THROWS();
+    }
+    if (result->command_error) {
+        zend_throw_exception(
+            get_valkey_glide_exception_ce(), result->command_error->command_error_message, 0);
+        valkey_glide_free_command_result(result);
+        RETURN_THROWS();
+    }
+
+    process_function_call_result(result->response, NULL, return_value);
+    valkey_glide_free_command_result(result);
+}
+/* }}} */
+
+/* {{{ proto array ValkeyGlideFunction::callMany(array argSets) */
+PHP_METHOD(ValkeyGlideFunction, callMany) {
+    HashTable* sets;
+    HashTable* keys;
+    HashTable* args;
+    zval*      set;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_ARRAY_HT(sets)
+    ZEND_PARSE_PARAMETERS_END();
+
+    valkey_glide_function_object* function     = Z_FUNCTION_P(ZEND_THIS);
+    valkey_glide_object*          valkey_glide = function_client(function);
+    if (!valkey_glide) {
+        RETURN_THROWS();
+    }
+
+    /* Reject malformed sets before anything is queued */
+    ZEND_HASH_FOREACH_VAL(sets, set) {
+        if (!function_arg_set(set, &keys, &args)) {
+            zend_throw_exception(get_valkey_glide_exception_ce(),
+                                 "callMany expects a list of [keys, args] arrays",
+                                 0);
+            RETURN_THROWS();
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+
+    /* Already batching: queue the calls on the caller's multi()/pipeline() */
+    bool own_batch = !valkey_glide->is_in_batch_mode;
+    if (own_batch) {
+        if (zend_hash_num_elements(sets) == 0) {
+            RETURN_EMPTY_ARRAY();
+        }
+
+        zval ignored;
+        ZVAL_UNDEF(&ignored);
+        int started =
+            execute_pipeline_command(&function->client, 0, &ignored, Z_OBJCE(function->client));
+        zval_ptr_dtor(&ignored);
+        if (!started) {
+            zend_throw_exception(
+                get_valkey_glide_exception_ce(), "Failed to start the pipeline", 0);
+            RETURN_THROWS();
+        }
+    }
+
+    ZEND_HASH_FOREACH_VAL(sets, set) {
+        function_arg_set(set, &keys, &args);
+        if (!function_queue(valkey_glide, function, keys, args)) {
+            if (own_batch) {
+                clear_batch_state(valkey_glide);
+            }
+            zend_throw_exception(get_valkey_glide_exception_ce(), "Failed to queue the call", 0);
+            RETURN_THROWS();
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+
+    if (!own_batch) {
+        RETURN_COPY(&function->client);
+    }
+
+    if (!execute_exec_command(&function->client, 0, return_value, Z_OBJCE(function->client))) {
+        if (!EG(exception)) {
+            zend_throw_exception(get_valkey_glide_exception_ce(), "callMany pipeline failed", 0);
+        }
+        RETURN_THROWS();
+    }
+}
+/* }}} */
+
+/* {{{ proto bool ValkeyGlideFunction::isReadOnly() */
+PHP_METHOD(ValkeyGlideFunction, isReadOnly) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    RETURN_BOOL(Z_FUNCTION_P(ZEND_THIS)->read_only);
+}
+/* }}} */
+
+/* {{{ proto string ValkeyGlideFunction::getName() */
+PHP_METHOD(ValkeyGlideFunction, getName) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    valkey_glide_function_object* function = Z_FUNCTION_P(ZEND_THIS);
+    if (!function->name) {
+        RETURN_EMPTY_STRING();
+    }
+    RETURN_STR_COPY(function->name);
+}
+/* }}} */
+
+/* ====================================================================
+ * REGISTRATION
+ * ==================================================================== */
+
+void register_function_class(void) {
+    function_ce                = register_class_ValkeyGlideFunction();
+    function_ce->create_object = create_function_object;
+
+    memcpy(&function_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(function_object_handlers));
+    function_object_handlers.offset    = XtOffsetOf(valkey_glide_function_object, std);
+    function_object_handlers.free_obj  = free_function_object;
+    function_object_handlers.get_gc    = function_get_gc;
+    function_object_handlers.clone_obj = NULL;
+}
@@ -0,0 +1,33 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_FUNCTION_H
+#define VALKEY_GLIDE_FUNCTION_H
+
+#include "common.h"
+#include "php.h"
+
+/* ValkeyGlideFunction object structure */
+typedef struct {
+    zval         client;    /* ValkeyGlide or ValkeyGlideCluster the function is called through */
+    zend_string* library;   /* Library the function was resolved in */
+    zend_string* name;      /* Function name, sent as is with every call */
+    bool         read_only; /* Registered with the no-writes flag: called with FCALL_RO */
+    zend_object  std;       /* MUST be last */
+} valkey_glide_function_object;
+
+/* Register ValkeyGlideFunction */
+void register_function_class(void);
+
+#endif /* VALKEY_GLIDE_FUNCTION_H */
@@ -0,0 +1,63 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * A server function resolved once by ValkeyGlide::prepareFunction().
+ *
+ * The function's flags are read with FUNCTION LIST when the handle is created. Functions
+ * registered with the 'no-writes' flag are called with FCALL_RO, which cluster clients may
+ * route to replicas, and every other function with FCALL. Calls pass string arguments
+ * to the core without copying them.
+ */
+final class ValkeyGlideFunction
+{
+    /**
+     * Call the function.
+     *
+     * @param array $keys Key names, keys in the function.
+     * @param array $args Other arguments, args in the function.
+     *
+     * @return mixed The function's reply, or the client when it is in multi() or pipeline().
+     * @throws ValkeyGlideException If the function fails.
+     */
+    public function call(array $keys = [], array $args = []): mixed
+    {
+    }
+
+    /**
+     * Call the function once per argument set, all in one pipeline.
+     *
+     * @param array $argSets A list of [keys, args] pairs, or of ['keys' => [...], 'args' => [...]].
+     *
+     * @return array|ValkeyGlide|ValkeyGlideCluster One reply per argument set, in order, or the
+     *                                              client when it is already in multi() or
+     *                                              pipeline() and the calls were queued there.
+     * @throws ValkeyGlideException If an argument set is malformed or the pipeline fails.
+     *
+     * @example
+     * $limiter = $valkey_glide->prepareFunction('ratelimit', 'take');
+     * $allowed = $limiter->callMany([[['rl:user:1'], [10]], [['rl:user:2'], [10]]]);
+     */
+    public function callMany(array $argSets): array|ValkeyGlide|ValkeyGlideCluster
+    {
+    }
+
+    /**
+     * @return bool True if the function is called with FCALL_RO.
+     */
+    public function isReadOnly(): bool
+    {
+    }
+
+    /**
+     * @return string The function name.
+     */
+    public function getName(): string
+    {
+    }
+}
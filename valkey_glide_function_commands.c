@@ -19,13 +19,13 @@ static int handle_function_bool_result(CommandResult* result, zval* return_value
     if (!result || result->command_error || !result->response) {
         ZVAL_FALSE(return_value);
         if (result) {
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
         }
         return 0;
     }
 
     int status = process_core_bool_result(result->response, NULL, return_value);
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
     return status;
 }
 
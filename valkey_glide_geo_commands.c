@@ -221,8 +221,12 @@ int execute_geopos_command(zval* object, int argc, zval* return_value, zend_clas
 
 
     /* Execute the generic command with appropriate result processor */
-    int result = execute_geo_generic_command(
-        valkey_glide, GeoPos, &args, NULL, process_geo_pos_result_async, return_value);
+    geo_result_processor_t processor = valkey_glide->opt_packed_numerics
+                                           ? process_geo_pos_float64_column_result
+                                           : process_geo_pos_result_async;
+
+    int result =
+        execute_geo_generic_command(valkey_glide, GeoPos, &args, NULL, processor, return_value);
 
     /* Handle batch mode return value */
     if (valkey_glide->is_in_batch_mode) {
@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <zend_exceptions.h>
 
 #include "command_response.h"
 #include "valkey_glide_commands_common.h"
@@ -281,129 +282,211 @@ int process_geo_pos_result_async(CommandResponse* response, void* output, zval*
 }
 
 /**
- * Batch-compatible async result processor for GEOSEARCH responses
+ * GEOPOS as a packed float64 string of longitude, latitude pairs (OPT_PACKED_NUMERICS)
  */
-int process_geo_search_result_async(CommandResponse* response, void* output, zval* return_value) {
-    struct {
-        int withcoord;
-        int withdist;
-        int withhash;
-    }* search_data = (void*) output;
+int process_geo_pos_float64_column_result(CommandResponse* response,
+                                          void*            output,
+                                          zval*            return_value) {
+    if (!response || !return_value) {
+        ZVAL_EMPTY_STRING(return_value);
+        return 0;
+    }
+    return command_response_to_float64_column(response, return_value, 2);
+}
 
-    if (!response || !return_value || !search_data) {
-        efree(search_data);
-        array_init(return_value);
+/* WITH* values of one GEOSEARCH element */
+typedef struct {
+    double    dist;
+    double    lon;
+    double    lat;
+    zend_long hash;
+    bool      has_dist;
+    bool      has_hash;
+    bool      has_coord;
+} geo_search_row_t;
+
+/* Split a GEOSEARCH element [name, [dist?, hash?, [lon, lat]?]] into its member name and
+ * WITH* values. The values come in the order of the reply, not of the request options.
+ * Returns 0 if the element has no member name. */
+static int geo_search_read_element(CommandResponse*         element,
+                                   const geo_search_data_t* search_data,
+                                   CommandResponse**        name,
+                                   geo_search_row_t*        row) {
+    memset(row, 0, sizeof(*row));
+
+    if (element->response_type != Array || element->array_value_len < 1 ||
+        element->array_value[0].response_type != String) {
         return 0;
     }
+    *name = &element->array_value[0];
+
+    if (element->array_value_len < 2 || element->array_value[1].response_type != Array) {
+        return 1;
+    }
 
-    int withcoord = search_data->withcoord;
-    int withdist  = search_data->withdist;
-    int withhash  = search_data->withhash;
+    CommandResponse* values = element->array_value[1].array_value;
+    long             count  = element->array_value[1].array_value_len;
+    long             idx    = 0;
 
-    /* If no WITH* options, just return the array of names */
-    if (!withcoord && !withdist && !withhash) {
-        /* Simple case - just return the array */
-        efree(search_data);
-        return command_response_to_zval(
-            response, return_value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+    if (search_data->withdist && idx < count) {
+        row->has_dist = command_response_to_double(&values[idx], &row->dist);
+        idx++;
+    }
+    if (search_data->withhash && idx < count) {
+        row->has_hash = values[idx].response_type == Int;
+        row->hash     = values[idx].int_value;
+        idx++;
     }
+    if (search_data->withcoord && idx < count && values[idx].response_type == Array &&
+        values[idx].array_value_len == 2) {
+        row->has_coord = command_response_to_double(&values[idx].array_value[0], &row->lon) &&
+                         command_response_to_double(&values[idx].array_value[1], &row->lat);
+    }
+    return 1;
+}
 
-    /* Process the result and build an associative array */
-    if (response->response_type == Array) {
-        array_init(return_value);
+/* Parallel columns: ['names' => [...], 'distances' => [...], 'hash' => [...], 'lon' => [...],
+ * 'lat' => [...]], with only the columns that were requested. A value missing from an element
+ * is null so rows stay aligned across columns. */
+static void geo_search_to_columns(CommandResponse*         response,
+                                  const geo_search_data_t* search_data,
+                                  zval*                    return_value) {
+    long n = response->array_value_len;
+    zval names, dist, hash, lon, lat;
+
+    array_init_size(&names, n);
+    if (search_data->withdist) {
+        array_init_size(&dist, n);
+    }
+    if (search_data->withhash) {
+        array_init_size(&hash, n);
+    }
+    if (search_data->withcoord) {
+        array_init_size(&lon, n);
+        array_init_size(&lat, n);
+    }
 
-        for (size_t i = 0; i < response->array_value_len; i++) {
-            struct CommandResponse* element = &response->array_value[i];
+    for (long i = 0; i < n; i++) {
+        CommandResponse* element = &response->array_value[i];
+        CommandResponse* name    = element;
+        geo_search_row_t row     = {0};
 
-            /* Process elements with member name and WITH* data */
-            if (element->response_type == Array && element->array_value_len > 0) {
-                /* First element is always the member name */
-                if (element->array_value[0].response_type == String) {
-                    char*  member_name = element->array_value[0].string_value;
-                    size_t member_len  = element->array_value[0].string_value_len;
-
-                    /* Create an array for this member's data */
-                    zval member_data;
-                    array_init(&member_data);
-                    CommandResponse* inner_element = &element->array_value[1];
-
-                    int idx = 0;
-                    /* Distance if requested */
-                    if (withdist && idx < inner_element->array_value_len) {
-                        if (inner_element->array_value[idx].response_type == String) {
-                            add_next_index_double(
-                                &member_data, atof(inner_element->array_value[idx].string_value));
-                        } else if (inner_element->array_value[idx].response_type == Float) {
-                            add_next_index_double(&member_data,
-                                                  inner_element->array_value[idx].float_value);
-                        }
-                        idx++;
-                    }
-
-                    /* Hash if requested */
-                    if (withhash && idx < inner_element->array_value_len) {
-                        if (inner_element->array_value[idx].response_type == Int) {
-                            add_next_index_long(&member_data,
-                                                inner_element->array_value[idx].int_value);
-                        }
-                        idx++;
-                    }
-
-                    /* Coordinates if requested */
-                    if (withcoord && idx < inner_element->array_value_len) {
-                        if (inner_element->array_value[idx].response_type == Array &&
-                            inner_element->array_value[idx].array_value_len == 2) {
-                            /* Create a coordinates array */
-                            zval coordinates;
-                            array_init(&coordinates);
-
-                            /* Add longitude */
-                            if (inner_element->array_value[idx].array_value[0].response_type ==
-                                String) {
-                                add_next_index_double(&coordinates,
-                                                      atof(inner_element->array_value[idx]
-                                                               .array_value[0]
-                                                               .string_value));
-                            } else if (inner_element->array_value[idx]
-                                           .array_value[0]
-                                           .response_type == Float) {
-                                add_next_index_double(
-                                    &coordinates,
-                                    inner_element->array_value[idx].array_value[0].float_value);
-                            }
-
-                            /* Add latitude */
-                            if (inner_element->array_value[idx].array_value[1].response_type ==
-                                String) {
-                                add_next_index_double(&coordinates,
-                                                      atof(inner_element->array_value[idx]
-                                                               .array_value[1]
-                                                               .string_value));
-                            } else if (inner_element->array_value[idx]
-                                           .array_value[1]
-                                           .response_type == Float) {
-                                add_next_index_double(
-                                    &coordinates,
-                                    inner_element->array_value[idx].array_value[1].float_value);
-                            }
-
-                            add_next_index_zval(&member_data, &coordinates);
-                        }
-                    }
-
-                    /* Add the member data to the result array with member name as key */
-                    add_assoc_zval_ex(return_value, member_name, member_len, &member_data);
-                }
+        if (element->response_type == String) {
+            /* No WITH* option: the element is the member name itself */
+        } else if (!geo_search_read_element(element, search_data, &name, &row)) {
+            continue;
+        }
+
+        add_next_index_stringl(&names, name->string_value, name->string_value_len);
+        if (search_data->withdist) {
+            if (row.has_dist) {
+                add_next_index_double(&dist, row.dist);
+            } else {
+                add_next_index_null(&dist);
+            }
+        }
+        if (search_data->withhash) {
+            if (row.has_hash) {
+                add_next_index_long(&hash, row.hash);
+            } else {
+                add_next_index_null(&hash);
+            }
+        }
+        if (search_data->withcoord) {
+            if (row.has_coord) {
+                add_next_index_double(&lon, row.lon);
+                add_next_index_double(&lat, row.lat);
+            } else {
+                add_next_index_null(&lon);
+                add_next_index_null(&lat);
             }
         }
-        efree(search_data);
-        return 1;
     }
 
-    /* If not an array, initialize empty array and return */
-    array_init(return_value);
+    array_init_size(return_value, 5);
+    add_assoc_zval_ex(return_value, ZEND_STRL("names"), &names);
+    if (search_data->withdist) {
+        add_assoc_zval_ex(return_value, ZEND_STRL("distances"), &dist);
+    }
+    if (search_data->withhash) {
+        add_assoc_zval_ex(return_value, ZEND_STRL("hash"), &hash);
+    }
+    if (search_data->withcoord) {
+        add_assoc_zval_ex(return_value, ZEND_STRL("lon"), &lon);
+        add_assoc_zval_ex(return_value, ZEND_STRL("lat"), &lat);
+    }
+}
+
+/* Rows keyed by member name: member => [dist?, hash?, [lon, lat]?] */
+static void geo_search_to_rows(CommandResponse*         response,
+                               const geo_search_data_t* search_data,
+                               zval*                    return_value) {
+    uint32_t width = search_data->withdist + search_data->withhash + search_data->withcoord;
+
+    array_init_size(return_value, response->array_value_len);
+
+    for (long i = 0; i < response->array_value_len; i++) {
+        CommandResponse* name;
+        geo_search_row_t row;
+        zval             member_data;
+
+        if (!geo_search_read_element(&response->array_value[i], search_data, &name, &row)) {
+            continue;
+        }
+
+        array_init_size(&member_data, width);
+        if (row.has_dist) {
+            add_next_index_double(&member_data, row.dist);
+        }
+        if (row.has_hash) {
+            add_next_index_long(&member_data, row.hash);
+        }
+        if (row.has_coord) {
+            zval coordinates;
+            array_init_size(&coordinates, 2);
+            add_next_index_double(&coordinates, row.lon);
+            add_next_index_double(&coordinates, row.lat);
+            add_next_index_zval(&member_data, &coordinates);
+        }
+
+        zend_symtable_str_update(
+            Z_ARRVAL_P(return_value), name->string_value, name->string_value_len, &member_data);
+    }
+}
+
+/**
+ * Batch-compatible async result processor for GEOSEARCH responses
+ */
+int process_geo_search_result_async(CommandResponse* response, void* output, zval* return_value) {
+    geo_search_data_t* search_data = (geo_search_data_t*) output;
+    int                status      = 0;
+
+    if (!response || !return_value || !search_data) {
+        if (search_data) {
+            efree(search_data);
+        }
+        array_init(return_value);
+        return 0;
+    }
+
+    bool with_any = search_data->withcoord || search_data->withdist || search_data->withhash;
+
+    if (response->response_type != Array) {
+        array_init(return_value);
+    } else if (search_data->columns) {
+        geo_search_to_columns(response, search_data, return_value);
+        status = 1;
+    } else if (!with_any) {
+        /* If no WITH* options, just return the array of names */
+        status = command_response_to_zval(
+            response, return_value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+    } else {
+        geo_search_to_rows(response, search_data, return_value);
+        status = 1;
+    }
+
     efree(search_data);
-    return 0;
+    return status;
 }
 
 
@@ -472,7 +555,8 @@ int execute_geo_generic_command(valkey_glide_object*   valkey_glide,
                                               arg_lens,
                                               arg_count,
                                               result_ptr,
-                                              (z_result_processor_t) process_result);
+                                              (z_result_processor_t) process_result,
+                                              NULL);
 
         /* Free allocated strings */
         for (int i = 0; i < allocated_count; i++) {
@@ -520,7 +604,7 @@ int execute_geo_generic_command(valkey_glide_object*   valkey_glide,
 
     /* Check if there was an error */
     if (result->command_error) {
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
         return 0;
     }
 
@@ -528,7 +612,7 @@ int execute_geo_generic_command(valkey_glide_object*   valkey_glide,
     success = process_result(result->response, result_ptr, return_value);
 
     /* Free the result */
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 
     return success;
 }
@@ -733,6 +817,13 @@ int parse_geosearch_parameters(int                  argc,
             }
         }
 
+        /* Return parallel columns instead of rows keyed by member (GEOSEARCH only) */
+        if (!is_store_variant) {
+            if ((opt_val = zend_hash_str_find(ht, "columns", sizeof("columns") - 1)) != NULL) {
+                params->options.columns = zval_is_true(opt_val);
+            }
+        }
+
         /* STOREDIST option (GEOSEARCHSTORE only) */
         if (is_store_variant) {
             if ((opt_val = zend_hash_str_find(ht, "storedist", sizeof("storedist") - 1)) != NULL) {
@@ -943,17 +1034,12 @@ int execute_geosearch_unified(
 
         if (!is_store_variant) {
             /* Create search data for GEOSEARCH result processing */
-            typedef struct {
-                int withcoord;
-                int withdist;
-                int withhash;
-            } search_data_t;
-
-            search_data_t* search_data = emalloc(sizeof(search_data_t));
-            search_data->withcoord     = params.options.with_opts.withcoord;
-            search_data->withdist      = params.options.with_opts.withdist;
-            search_data->withhash      = params.options.with_opts.withhash;
-            result_ptr                 = search_data;
+            geo_search_data_t* search_data = emalloc(sizeof(geo_search_data_t));
+            search_data->withcoord         = params.options.with_opts.withcoord;
+            search_data->withdist          = params.options.with_opts.withdist;
+            search_data->withhash          = params.options.with_opts.withhash;
+            search_data->columns           = params.options.columns;
+            result_ptr                     = search_data;
         }
 
         int status = buffer_command_for_batch(valkey_glide,
@@ -962,7 +1048,8 @@ int execute_geosearch_unified(
                                               arg_lens,
                                               arg_count,
                                               result_ptr,
-                                              (z_result_processor_t) processor);
+                                              (z_result_processor_t) processor,
+                                              batch_result_efree);
 
         /* Cleanup */
         for (int i = 0; i < allocated_count; i++) {
@@ -998,7 +1085,7 @@ int execute_geosearch_unified(
 
     if (!result || result->command_error) {
         if (result)
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
         return 0;
     }
 
@@ -1008,20 +1095,245 @@ int execute_geosearch_unified(
         success = process_geo_int_result_async(result->response, NULL, return_value);
     } else {
         /* Create search data for result processing */
-        typedef struct {
-            int withcoord;
-            int withdist;
-            int withhash;
-        } search_data_t;
-
-        search_data_t* search_data = emalloc(sizeof(search_data_t));
-        search_data->withcoord     = params.options.with_opts.withcoord;
-        search_data->withdist      = params.options.with_opts.withdist;
-        search_data->withhash      = params.options.with_opts.withhash;
+        geo_search_data_t* search_data = emalloc(sizeof(geo_search_data_t));
+        search_data->withcoord         = params.options.with_opts.withcoord;
+        search_data->withdist          = params.options.with_opts.withdist;
+        search_data->withhash          = params.options.with_opts.withhash;
+        search_data->columns           = params.options.columns;
 
         success = process_geo_search_result_async(result->response, search_data, return_value);
     }
 
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
     return success;
 }
+
+/* ====================================================================
+ * SHARD RESULT MERGING
+ * ==================================================================== */
+
+/* Read position of one GEOSEARCH result in geosearchMerge() */
+typedef struct {
+    HashTable*   result; /* The result array */
+    HashTable*   names;  /* Column results: names and distances columns */
+    HashTable*   dists;
+    HashPosition pos; /* Row results: position of the current row */
+    uint32_t     next;
+    uint32_t     count;
+    double       dist; /* Distance of the current entry */
+} geo_merge_cursor_t;
+
+/* Load the distance of the cursor's current entry. Rows carry it first, as WITHDIST puts it
+ * ahead of the hash and the coordinates. Returns 0 if the entry has no distance; an integer
+ * there is the WITHHASH geohash of a search without WITHDIST. */
+static int geo_merge_load(geo_merge_cursor_t* cursor) {
+    zval* dist;
+
+    if (cursor->names) {
+        dist = zend_hash_index_find(cursor->dists, cursor->next);
+    } else {
+        zval* row = zend_hash_get_current_data_ex(cursor->result, &cursor->pos);
+        ZVAL_DEREF(row);
+        dist = row && Z_TYPE_P(row) == IS_ARRAY ? zend_hash_index_find(Z_ARRVAL_P(row), 0) : NULL;
+    }
+
+    if (dist) {
+        ZVAL_DEREF(dist);
+        if (Z_TYPE_P(dist) == IS_DOUBLE) {
+            cursor->dist = Z_DVAL_P(dist);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Append the current row, unless an earlier result already had the member */
+static int geo_merge_take_row(geo_merge_cursor_t* cursor, zval* return_value) {
+    zend_string* name;
+    zend_ulong   index;
+    zval*        row = zend_hash_get_current_data_ex(cursor->result, &cursor->pos);
+    zval*        added;
+
+    if (zend_hash_get_current_key_ex(cursor->result, &name, &index, &cursor->pos) ==
+        HASH_KEY_IS_STRING) {
+        added = zend_hash_add(Z_ARRVAL_P(return_value), name, row);
+    } else {
+        added = zend_hash_index_add(Z_ARRVAL_P(return_value), index, row);
+    }
+    if (!added) {
+        return 0;
+    }
+    Z_TRY_ADDREF_P(row);
+    return 1;
+}
+
+/* Append entry `next` of a column result to every output column, unless an earlier result
+ * already had the member */
+static int geo_merge_take_column(geo_merge_cursor_t* cursor, HashTable* seen, zval* return_value) {
+    zend_string* column;
+    zval*        out;
+    zval*        name = zend_hash_index_find(cursor->names, cursor->next);
+
+    if (name && Z_TYPE_P(name) == IS_STRING && !zend_hash_add_empty_element(seen, Z_STR_P(name))) {
+        return 0;
+    }
+
+    ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(return_value), column, out) {
+        zval* source = zend_hash_find(cursor->result, column);
+        zval* value  = NULL;
+
+        if (source && Z_TYPE_P(source) == IS_ARRAY) {
+            value = zend_hash_index_find(Z_ARRVAL_P(source), cursor->next);
+        }
+        if (value) {
+            Z_TRY_ADDREF_P(value);
+            zend_hash_next_index_insert_new(Z_ARRVAL_P(out), value);
+        } else {
+            add_next_index_null(out);
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+    return 1;
+}
+
+/**
+ * geosearchMerge(array results, int count = -1, bool desc = false)
+ *
+ * k-way merge of GEOSEARCH ... WITHDIST results that are each sorted by distance, e.g. one per
+ * shard. Takes either rows keyed by member or the parallel columns of the 'columns' option,
+ * returns the same shape. A member found in several results is kept once, at its first position.
+ */
+int execute_geosearch_merge_command(int argc, zval* return_value) {
+    HashTable*          results;
+    zend_long           count = -1;
+    zend_bool           desc  = 0;
+    geo_merge_cursor_t* cursors;
+    HashTable           seen;
+    zval*               result;
+    zend_string*        column;
+    zval*               value;
+    uint32_t            n       = 0;
+    uint32_t            total   = 0;
+    int                 columns = -1;
+    HashTable*          first   = NULL;
+
+    if (zend_parse_parameters(argc, "h|lb", &results, &count, &desc) == FAILURE) {
+        return 0;
+    }
+    if (count == 0 || count < -1) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "geosearchMerge() count must be positive, or -1 for all members",
+                             0);
+        return 0;
+    }
+
+    cursors = safe_emalloc(zend_hash_num_elements(results) + 1, sizeof(geo_merge_cursor_t), 0);
+
+    ZEND_HASH_FOREACH_VAL(results, result) {
+        ZVAL_DEREF(result);
+        if (Z_TYPE_P(result) != IS_ARRAY) {
+            zend_throw_exception(
+                get_valkey_glide_exception_ce(), "geosearchMerge() expects an array of results", 0);
+            efree(cursors);
+            return 0;
+        }
+
+        geo_merge_cursor_t* cursor = &cursors[n++];
+        HashTable*          entry  = Z_ARRVAL_P(result);
+        zval*               names  = zend_hash_str_find(entry, ZEND_STRL("names"));
+        zval*               dists  = zend_hash_str_find(entry, ZEND_STRL("distances"));
+
+        int is_columns =
+            names && dists && Z_TYPE_P(names) == IS_ARRAY && Z_TYPE_P(dists) == IS_ARRAY;
+
+        if (columns < 0) {
+            columns = is_columns;
+            first   = entry;
+        } else if (columns != is_columns) {
+            zend_throw_exception(get_valkey_glide_exception_ce(),
+                                 "geosearchMerge() cannot mix rows and columns results",
+                                 0);
+            efree(cursors);
+            return 0;
+        }
+
+        memset(cursor, 0, sizeof(*cursor));
+        cursor->result = entry;
+        if (is_columns) {
+            cursor->names = Z_ARRVAL_P(names);
+            cursor->dists = Z_ARRVAL_P(dists);
+            cursor->count = zend_hash_num_elements(cursor->names);
+        } else {
+            zend_hash_internal_pointer_reset_ex(cursor->result, &cursor->pos);
+            cursor->count = zend_hash_num_elements(cursor->result);
+        }
+        total += cursor->count;
+
+        if (cursor->count && !geo_merge_load(cursor)) {
+            zend_throw_exception(get_valkey_glide_exception_ce(),
+                                 "geosearchMerge() needs results searched WITHDIST",
+                                 0);
+            efree(cursors);
+            return 0;
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+
+    uint32_t limit = count != -1 && (zend_ulong) count < total ? (uint32_t) count : total;
+
+    if (columns > 0) {
+        array_init_size(return_value, zend_hash_num_elements(first));
+        ZEND_HASH_FOREACH_STR_KEY(first, column) {
+            if (column) {
+                zval out;
+                array_init_size(&out, limit);
+                zend_hash_add_new(Z_ARRVAL_P(return_value), column, &out);
+            }
+        }
+        ZEND_HASH_FOREACH_END();
+        zend_hash_init(&seen, limit, NULL, NULL, 0);
+    } else {
+        array_init_size(return_value, limit);
+    }
+
+    for (uint32_t taken = 0; taken < limit;) {
+        geo_merge_cursor_t* best = NULL;
+
+        for (uint32_t i = 0; i < n; i++) {
+            geo_merge_cursor_t* cursor = &cursors[i];
+            if (cursor->next < cursor->count &&
+                (!best || (desc ? cursor->dist > best->dist : cursor->dist < best->dist))) {
+                best = cursor;
+            }
+        }
+        if (!best) {
+            break;
+        }
+
+        taken += columns > 0 ? geo_merge_take_column(best, &seen, return_value)
+                             : geo_merge_take_row(best, return_value);
+
+        best->next++;
+        if (!best->names) {
+            zend_hash_move_forward_ex(best->result, &best->pos);
+        }
+        if (best->next < best->count && !geo_merge_load(best)) {
+            zend_throw_exception(get_valkey_glide_exception_ce(),
+                                 "geosearchMerge() needs results searched WITHDIST",
+                                 0);
+            break;
+        }
+    }
+
+    if (columns > 0) {
+        zend_hash_destroy(&seen);
+    }
+    efree(cursors);
+
+    if (EG(exception)) {
+        zval_ptr_dtor(return_value);
+        ZVAL_NULL(return_value);
+        return 0;
+    }
+    return 1;
+}
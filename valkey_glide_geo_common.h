@@ -46,9 +46,20 @@ typedef struct _geo_radius_options_t {
     long               count;      /* COUNT option */
     int                any;        /* ANY flag for COUNT option */
     int                store_dist; /* STOREDIST option (for GEOSEARCHSTORE) */
+    int                columns;    /* Return parallel columns (GEOSEARCH) */
     geo_with_options_t with_opts;  /* WITH* options */
 } geo_radius_options_t;
 
+/**
+ * Reply layout and output format handed to the GEOSEARCH result processor, which frees it
+ */
+typedef struct _geo_search_data_t {
+    int withcoord; /* Reply elements carry [lon, lat] */
+    int withdist;  /* Reply elements carry the distance */
+    int withhash;  /* Reply elements carry the geohash */
+    int columns;   /* Decode into parallel columns instead of rows keyed by member */
+} geo_search_data_t;
+
 /**
  * Unified parameters structure for GEOSEARCH/GEOSEARCHSTORE commands
  */
@@ -143,6 +154,9 @@ int process_geo_int_result_async(CommandResponse* response, void* output, zval*
 int process_geo_double_result_async(CommandResponse* response, void* output, zval* return_value);
 int process_geo_hash_result_async(CommandResponse* response, void* output, zval* return_value);
 int process_geo_pos_result_async(CommandResponse* response, void* output, zval* return_value);
+int process_geo_pos_float64_column_result(CommandResponse* response,
+                                          void*            output,
+                                          zval*            return_value);
 int process_geo_search_result_async(CommandResponse* response, void* output, zval* return_value);
 
 int execute_geoadd_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
@@ -155,6 +169,7 @@ int execute_geosearchstore_command(zval*             object,
                                    int               argc,
                                    zval*             return_value,
                                    zend_class_entry* ce);
+int execute_geosearch_merge_command(int argc, zval* return_value);
 
 /* New unified functions */
 int parse_geosearch_parameters(int                  argc,
@@ -300,4 +315,13 @@ int execute_geo_generic_command(valkey_glide_object*   valkey_glide,
         RETURN_FALSE;                                                                     \
     }
 
+/* Macro for the static geosearchMerge() helper */
+#define GEOSEARCHMERGE_METHOD_IMPL(class_name)                                \
+    PHP_METHOD(class_name, geosearchMerge) {                                  \
+        if (execute_geosearch_merge_command(ZEND_NUM_ARGS(), return_value)) { \
+            return;                                                           \
+        }                                                                     \
+        RETURN_THROWS();                                                      \
+    }
+
 #endif /* VALKEY_GLIDE_GEO_COMMON_H */
@@ -0,0 +1,373 @@
+/*
+  +----------------------------------------------------------------------+
+  | ValkeyGlide Hash Chunks                                              |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_hash_chunks.h"
+
+#include <zend_exceptions.h>
+#include <zend_interfaces.h>
+
+#include "command_response.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_hash_chunks_arginfo.h"
+
+#define HASH_CHUNKS_DEFAULT_COUNT 1000
+
+/* Global variables */
+static zend_class_entry*    hash_chunks_ce;
+static zend_object_handlers hash_chunks_object_handlers;
+
+#define HASH_CHUNKS_FROM_OBJ(o) VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_hash_chunks_object, o)
+#define Z_HASH_CHUNKS_P(zv) HASH_CHUNKS_FROM_OBJ(Z_OBJ_P(zv))
+
+/* ====================================================================
+ * OBJECT LIFECYCLE
+ * ==================================================================== */
+
+static void hash_chunks_release(valkey_glide_hash_chunks_object* chunks) {
+    /* The core still owns the arguments of an HSCAN in flight, so wait for it */
+    if (chunks->page.in_flight) {
+        const zend_function* previous = valkey_glide_attribute_to(chunks->method);
+        CommandResult*       result =
+            execute_command_collect(&chunks->page, chunks->argc, chunks->args, chunks->args_len);
+        valkey_glide_attribute_to(previous);
+        if (result) {
+            valkey_glide_free_command_result(result);
+        }
+    }
+
+    zval_ptr_dtor(&chunks->client);
+    zval_ptr_dtor(&chunks->current);
+    ZVAL_UNDEF(&chunks->client);
+    ZVAL_UNDEF(&chunks->current);
+
+    zend_string** strings[] = {&chunks->key, &chunks->count, &chunks->cursor};
+    for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++) {
+        if (*strings[i]) {
+            zend_string_release(*strings[i]);
+            *strings[i] = NULL;
+        }
+    }
+}
+
+static zend_object* create_hash_chunks_object(zend_class_entry* ce) {
+    valkey_glide_hash_chunks_object* chunks =
+        zend_object_alloc(sizeof(valkey_glide_hash_chunks_object), ce);
+
+    zend_object_std_init(&chunks->std, ce);
+    object_properties_init(&chunks->std, ce);
+    chunks->std.handlers = &hash_chunks_object_handlers;
+
+    return &chunks->std;
+}
+
+static void free_hash_chunks_object(zend_object* object) {
+    hash_chunks_release(HASH_CHUNKS_FROM_OBJ(object));
+    zend_object_std_dtor(object);
+}
+
+/* Expose the client so a cycle through it can still be collected */
+static HashTable* hash_chunks_get_gc(zend_object* object, zval** table, int* n) {
+    valkey_glide_hash_chunks_object* chunks = HASH_CHUNKS_FROM_OBJ(object);
+
+    *table = &chunks->client;
+    *n     = Z_TYPE(chunks->client) == IS_OBJECT ? 1 : 0;
+    return zend_std_get_properties(object);
+}
+
+/* ====================================================================
+ * PAGE FETCHING
+ * ==================================================================== */
+
+/*
+ * Send HSCAN for chunks->cursor through the shared execute path, so pages show up in the
+ * latency stats, slow log and traces under hGetAllChunked. With the client's async_io
+ * companion the command is only submitted, so the server works on the next page while PHP
+ * consumes the current one. Otherwise the reply is read right away.
+ */
+static void hash_chunks_send(valkey_glide_hash_chunks_object* chunks) {
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &chunks->client);
+    unsigned long        argc = 0;
+    const zend_function* previous;
+
+    if (!valkey_glide->glide_client) {
+        zend_throw_exception(get_valkey_glide_exception_ce(), "Client is not connected", 0);
+        return;
+    }
+
+#define HASH_CHUNKS_ARG(data, len)                   \
+    do {                                             \
+        chunks->args[argc]     = (uintptr_t) (data); \
+        chunks->args_len[argc] = (len);              \
+        argc++;                                      \
+    } while (0)
+
+    HASH_CHUNKS_ARG(ZSTR_VAL(chunks->key), ZSTR_LEN(chunks->key));
+    HASH_CHUNKS_ARG(ZSTR_VAL(chunks->cursor), ZSTR_LEN(chunks->cursor));
+    HASH_CHUNKS_ARG("COUNT", sizeof("COUNT") - 1);
+    HASH_CHUNKS_ARG(ZSTR_VAL(chunks->count), ZSTR_LEN(chunks->count));
+    if (chunks->novalues) {
+        HASH_CHUNKS_ARG("NOVALUES", sizeof("NOVALUES") - 1);
+    }
+#undef HASH_CHUNKS_ARG
+    chunks->argc = argc;
+
+    previous = valkey_glide_attribute_to(chunks->method);
+    execute_command_prefetch(valkey_glide->glide_client,
+                             HScan,
+                             chunks->argc,
+                             chunks->args,
+                             chunks->args_len,
+                             &chunks->page);
+    valkey_glide_attribute_to(previous);
+}
+
+/* Decode one HSCAN page: [field => value] pairs, or the list of fields with NOVALUES */
+static void hash_chunks_decode_page(CommandResponse* fields, bool novalues, zval* page) {
+    long step = novalues ? 1 : 2;
+
+    array_init_size(page, (uint32_t) (fields->array_value_len / step));
+    for (long i = 0; i + step - 1 < fields->array_value_len; i += step) {
+        CommandResponse* field = &fields->array_value[i];
+        zval             z_value;
+
+        if (field->response_type != String) {
+            continue;
+        }
+        if (novalues) {
+            ZVAL_STRINGL_FAST(&z_value, field->string_value, field->string_value_len);
+            zend_hash_next_index_insert_new(Z_ARRVAL_P(page), &z_value);
+            continue;
+        }
+
+        command_response_to_zval(
+            &fields->array_value[i + 1], &z_value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+        zend_symtable_str_update(
+            Z_ARRVAL_P(page), field->string_value, field->string_value_len, &z_value);
+    }
+}
+
+/* Take the reply of the outstanding HSCAN, throwing if it failed. Returns the
+ * [cursor, fields] reply or NULL; *result must be freed by the caller either way */
+static CommandResponse* hash_chunks_collect(valkey_glide_hash_chunks_object* chunks,
+                                            CommandResult**                  result) {
+    const zend_function* previous = valkey_glide_attribute_to(chunks->method);
+
+    *result = execute_command_collect(&chunks->page, chunks->argc, chunks->args, chunks->args_len);
+    valkey_glide_attribute_to(previous);
+
+    if (!*result) {
+        zend_throw_exception(get_valkey_glide_exception_ce(), "HSCAN failed: no response", 0);
+        return NULL;
+    }
+    if ((*result)->command_error) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             (*result)->command_error->command_error_message,
+                             0);
+        return NULL;
+    }
+
+    CommandResponse* reply = (*result)->response;
+    if (!reply || reply->response_type != Array || reply->array_value_len != 2 ||
+        reply->array_value[0].response_type != String ||
+        reply->array_value[1].response_type != Array) {
+        zend_throw_exception(
+            get_valkey_glide_exception_ce(), "HSCAN failed: unexpected reply", 0);
+        return NULL;
+    }
+    return reply;
+}
+
+/*
+ * Move to the next non-empty page. The HSCAN for the page after it is sent before the page
+ * is decoded, so one request is always in flight while the caller works through a page.
+ */
+static void hash_chunks_advance(valkey_glide_hash_chunks_object* chunks) {
+    zval_ptr_dtor(&chunks->current);
+    ZVAL_UNDEF(&chunks->current);
+
+    while (chunks->page.in_flight) {
+        CommandResult*   result;
+        CommandResponse* reply = hash_chunks_collect(chunks, &result);
+
+        if (!reply) {
+            if (result) {
+                valkey_glide_free_command_result(result);
+            }
+            zend_string_release(chunks->cursor);
+            chunks->cursor = NULL;
+            return;
+        }
+
+        /* The previous request has been collected, so its cursor can be replaced */
+        CommandResponse* cursor = &reply->array_value[0];
+        zend_string_release(chunks->cursor);
+        chunks->cursor = NULL;
+        if (cursor->string_value_len != 1 || cursor->string_value[0] != '0') {
+            chunks->cursor = zend_string_init(cursor->string_value, cursor->string_value_len, 0);
+            hash_chunks_send(chunks);
+        }
+
+        /* HSCAN may return empty pages before the scan is complete */
+        if (reply->array_value[1].array_value_len > 0) {
+            hash_chunks_decode_page(&reply->array_value[1], chunks->novalues, &chunks->current);
+            valkey_glide_free_command_result(result);
+            return;
+        }
+        valkey_glide_free_command_result(result);
+    }
+}
+
+/* Fetch the first page on the first call */
+static valkey_glide_hash_chunks_object* hash_chunks_started(zval* object) {
+    valkey_glide_hash_chunks_object* chunks = Z_HASH_CHUNKS_P(object);
+
+    if (!chunks->started) {
+        chunks->started = true;
+        if (Z_TYPE(chunks->client) == IS_OBJECT) {
+            hash_chunks_advance(chunks);
+        }
+    }
+    return chunks;
+}
+
+/* ====================================================================
+ * CLIENT METHOD
+ * ==================================================================== */
+
+/* Execute hGetAllChunked: return a ValkeyGlideHashChunks iterator over HSCAN pages */
+int execute_hgetall_chunked_command(zval*             object,
+                                    int               argc,
+                                    zval*             return_value,
+                                    zend_class_entry* ce) {
+    valkey_glide_object* valkey_glide;
+    char*                key      = NULL;
+    size_t               key_len  = 0;
+    zend_long            count    = HASH_CHUNKS_DEFAULT_COUNT;
+    bool                 novalues = false;
+
+    if (zend_parse_method_parameters(
+            argc, object, "Os|lb", &object, ce, &key, &key_len, &count, &novalues) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "hGetAllChunked cannot be used inside multi()/pipeline()",
+                             0);
+        return 0;
+    }
+    if (count < 1) {
+        zend_throw_exception(
+            get_valkey_glide_exception_ce(), "hGetAllChunked: chunk must be positive", 0);
+        return 0;
+    }
+
+    object_init_ex(return_value, hash_chunks_ce);
+    valkey_glide_hash_chunks_object* chunks = Z_HASH_CHUNKS_P(return_value);
+
+    ZVAL_COPY(&chunks->client, object);
+    chunks->key      = zend_string_init(key, key_len, 0);
+    chunks->count    = zend_long_to_str(count);
+    chunks->cursor   = zend_string_init("0", 1, 0);
+    chunks->novalues = novalues;
+    chunks->method   = valkey_glide_calling_method();
+
+    /* Start the first page right away */
+    hash_chunks_send(chunks);
+    return 1;
+}
+
+/* ====================================================================
+ * ITERATOR METHODS
+ * ==================================================================== */
+
+/* {{{ proto void ValkeyGlideHashChunks::rewind() */
+PHP_METHOD(ValkeyGlideHashChunks, rewind) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    valkey_glide_hash_chunks_object* chunks = Z_HASH_CHUNKS_P(ZEND_THIS);
+    if (chunks->started && chunks->index > 0) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "Cannot rewind ValkeyGlideHashChunks after it has advanced",
+                             0);
+        RETURN_THROWS();
+    }
+    hash_chunks_started(ZEND_THIS);
+}
+/* }}} */
+
+/* {{{ proto bool ValkeyGlideHashChunks::valid() */
+PHP_METHOD(ValkeyGlideHashChunks, valid) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    RETURN_BOOL(Z_TYPE(hash_chunks_started(ZEND_THIS)->current) == IS_ARRAY);
+}
+/* }}} */
+
+/* {{{ proto array|null ValkeyGlideHashChunks::current() */
+PHP_METHOD(ValkeyGlideHashChunks, current) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    valkey_glide_hash_chunks_object* chunks = hash_chunks_started(ZEND_THIS);
+    if (Z_TYPE(chunks->current) != IS_ARRAY) {
+        RETURN_NULL();
+    }
+    RETURN_COPY(&chunks->current);
+}
+/* }}} */
+
+/* {{{ proto int|null ValkeyGlideHashChunks::key() */
+PHP_METHOD(ValkeyGlideHashChunks, key) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    valkey_glide_hash_chunks_object* chunks = hash_chunks_started(ZEND_THIS);
+    if (Z_TYPE(chunks->current) != IS_ARRAY) {
+        RETURN_NULL();
+    }
+    RETURN_LONG(chunks->index);
+}
+/* }}} */
+
+/* {{{ proto void ValkeyGlideHashChunks::next() */
+PHP_METHOD(ValkeyGlideHashChunks, next) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    valkey_glide_hash_chunks_object* chunks = hash_chunks_started(ZEND_THIS);
+    if (Z_TYPE(chunks->current) == IS_ARRAY) {
+        hash_chunks_advance(chunks);
+        chunks->index++;
+    }
+}
+/* }}} */
+
+/* ====================================================================
+ * REGISTRATION
+ * ==================================================================== */
+
+void register_hash_chunks_class(void) {
+    hash_chunks_ce                = register_class_ValkeyGlideHashChunks(zend_ce_iterator);
+    hash_chunks_ce->create_object = create_hash_chunks_object;
+
+    memcpy(&hash_chunks_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(hash_chunks_object_handlers));
+    hash_chunks_object_handlers.offset    = XtOffsetOf(valkey_glide_hash_chunks_object, std);
+    hash_chunks_object_handlers.free_obj  = free_hash_chunks_object;
+    hash_chunks_object_handlers.get_gc    = hash_chunks_get_gc;
+    hash_chunks_object_handlers.clone_obj = NULL;
+}
@@ -0,0 +1,49 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_HASH_CHUNKS_H
+#define VALKEY_GLIDE_HASH_CHUNKS_H
+
+#include "command_response.h"
+#include "common.h"
+#include "php.h"
+
+/* HSCAN key cursor COUNT n [NOVALUES] */
+#define HASH_CHUNKS_MAX_ARGS 5
+
+/* ValkeyGlideHashChunks object structure */
+typedef struct {
+    zval         client;   /* ValkeyGlide or ValkeyGlideCluster the pages are read through */
+    zend_string* key;      /* Hash key */
+    zend_string* count;    /* HSCAN COUNT hint */
+    zend_string* cursor;   /* Cursor of the next HSCAN, NULL once the scan is complete */
+    bool         novalues; /* Send NOVALUES and yield lists of fields */
+
+    /* The HSCAN sent ahead of the consumer; its arguments point into key, count, cursor */
+    valkey_glide_prefetch page;
+    uintptr_t             args[HASH_CHUNKS_MAX_ARGS];
+    unsigned long         args_len[HASH_CHUNKS_MAX_ARGS];
+    unsigned long         argc;
+    const zend_function*  method; /* hGetAllChunked, which every HSCAN is counted under */
+
+    zval        current; /* Page handed out by current(), UNDEF when exhausted */
+    zend_long   index;   /* Number of the current page */
+    bool        started;
+    zend_object std; /* MUST be last */
+} valkey_glide_hash_chunks_object;
+
+/* Register ValkeyGlideHashChunks */
+void register_hash_chunks_class(void);
+
+#endif /* VALKEY_GLIDE_HASH_CHUNKS_H */
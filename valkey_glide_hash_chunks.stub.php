@@ -0,0 +1,54 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * Pages of a hash read with HSCAN, returned by ValkeyGlide::hGetAllChunked().
+ *
+ * Iterating yields one array per page: field => value, or a list of fields with NOVALUES.
+ * Only the current page and the next one are held at a time. When the client was connected
+ * with advanced_config ['async_io' => true] the HSCAN for the next page is already in flight
+ * while the current one is consumed. Without async_io, next() sends that HSCAN and blocks
+ * until it returns. Like a generator, it can only be iterated once.
+ */
+final class ValkeyGlideHashChunks implements Iterator
+{
+    /**
+     * Fetch the first page. Throws if the iterator has already advanced.
+     */
+    public function rewind(): void
+    {
+    }
+
+    public function valid(): bool
+    {
+    }
+
+    /**
+     * @return array|null The current page.
+     */
+    public function current(): ?array
+    {
+    }
+
+    /**
+     * @return int|null Number of the current page, starting at 0.
+     */
+    public function key(): ?int
+    {
+    }
+
+    /**
+     * Move to the next non-empty page. Without async_io this fetches the page after it
+     * synchronously.
+     *
+     * @throws ValkeyGlideException If HSCAN fails, e.g. because the key is not a hash.
+     */
+    public function next(): void
+    {
+    }
+}
@@ -42,6 +42,10 @@ int execute_h_generic_command(valkey_glide_object* valkey_glide,
     int            arg_count         = 0;
     int            status            = 0;
 
+    /* HMGET and HGETEX hand their field strings over with args, the rest a single block */
+    z_result_cleanup_t free_result =
+        (cmd_type == HMGet || cmd_type == HGetEx) ? free_h_fields_args : batch_result_efree;
+
     /* Validate basic arguments */
     VALIDATE_HASH_ARGS(valkey_glide->glide_client, args->key);
 
@@ -115,8 +119,7 @@ int execute_h_generic_command(valkey_glide_object* valkey_glide,
         default:
 
             if (result_ptr) {
-                efree(args->fields);
-                efree(result_ptr);
+                free_result(result_ptr);
             }
 
             return 0;
@@ -124,8 +127,7 @@ int execute_h_generic_command(valkey_glide_object* valkey_glide,
 
     if (arg_count <= 0) {
         if (result_ptr) {
-            efree(args->fields);
-            efree(result_ptr);
+            free_result(result_ptr);
         }
         goto cleanup;
     }
@@ -133,8 +135,17 @@ int execute_h_generic_command(valkey_glide_object* valkey_glide,
     /* Check for batch mode */
 
     if (valkey_glide->is_in_batch_mode) {
-        status = buffer_command_for_batch(
-            valkey_glide, cmd_type, cmd_args, args_len, arg_count, result_ptr, process_result);
+        status = buffer_command_for_batch(valkey_glide,
+                                          cmd_type,
+                                          cmd_args,
+                                          args_len,
+                                          arg_count,
+                                          result_ptr,
+                                          process_result,
+                                          result_ptr ? free_result : NULL);
+        if (!status && result_ptr) {
+            free_result(result_ptr);
+        }
         goto cleanup;
     }
 
@@ -145,18 +156,16 @@ int execute_h_generic_command(valkey_glide_object* valkey_glide,
     /* Process result */
     if (result && Z_TYPE_P(return_value) != IS_FALSE) {
         if (!result->command_error && result->response && process_result) {
-            status = process_result(result->response, result_ptr, return_value);
+            status = valkey_glide_async_decode(result, process_result, result_ptr, return_value);
         } else {
             if (result_ptr) {
-                efree(args->fields);
-                efree(result_ptr);
+                free_result(result_ptr);
             }
         }
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
     } else {
         if (result_ptr) {
-            efree(args->fields);
-            efree(result_ptr);
+            free_result(result_ptr);
         }
     }
 
@@ -262,8 +271,9 @@ int execute_h_simple_command(valkey_glide_object* valkey_glide,
         goto cleanup;
     }
     if (valkey_glide->is_in_batch_mode) {
+        /* result_ptr is the caller's (HLen, HExists); nothing for the batch to release */
         status = buffer_command_for_batch(
-            valkey_glide, cmd_type, cmd_args, args_len, arg_count, result_ptr, processor);
+            valkey_glide, cmd_type, cmd_args, args_len, arg_count, result_ptr, processor, NULL);
         goto cleanup;
     }
 
@@ -275,9 +285,9 @@ int execute_h_simple_command(valkey_glide_object* valkey_glide,
     /* Process result using standard handlers */
     if (result && Z_TYPE_P(return_value) != IS_FALSE) {
         if (!result->command_error && result->response && processor) {
-            status = processor(result->response, result_ptr, return_value);
+            status = valkey_glide_async_decode(result, processor, result_ptr, return_value);
         }
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
     } else {
         status = 0;
     }
@@ -1004,51 +1014,30 @@ int process_h_map_result_async(CommandResponse* response, void* output, zval* re
 }
 
 /**
- * Custom processor for HGETEX that maps field names to values
+ * Custom processor for HGETEX that maps field names to values. Like HMGET, args->fields
+ * holds the field strings from h_field_to_string(), and args is released here.
  */
 int process_h_getex_result_async(CommandResponse* response, void* output, zval* return_value) {
     h_command_args_t* args = (h_command_args_t*) output;
 
-    if (!response || !args || !args->fields) {
-        ZVAL_FALSE(return_value);
-        return 0;
-    }
-
-    // First get the array of values
-    zval temp_array;
-    if (!command_response_to_zval(response, &temp_array, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false)) {
+    if (!response) {
+        free_h_fields_args(args);
         ZVAL_FALSE(return_value);
         return 0;
     }
 
-    // Create associative array mapping fields to values
-    array_init(return_value);
-
-    if (Z_TYPE(temp_array) == IS_ARRAY) {
-        HashTable* values_ht = Z_ARRVAL(temp_array);
-        int        value_idx = 0;
-
-        for (int i = 0; i < args->field_count && value_idx < zend_hash_num_elements(values_ht);
-             i++) {
-            zval* value = zend_hash_index_find(values_ht, value_idx);
-            if (value) {
-                // Convert field zval to string key
-                zval*        field_zval = &args->fields[i];
-                zend_string* field_str  = zval_get_string(field_zval);
-
-                // Add to associative array
-                zval value_copy;
-                ZVAL_COPY(&value_copy, value);
-                add_assoc_zval_ex(
-                    return_value, ZSTR_VAL(field_str), ZSTR_LEN(field_str), &value_copy);
-
-                zend_string_release(field_str);
-                value_idx++;
-            }
+    /* Map values to the field strings the command was sent with */
+    array_init_size(return_value, (uint32_t) args->field_count);
+    if (response->response_type == Array) {
+        for (int i = 0; i < args->field_count && i < response->array_value_len; i++) {
+            zval value;
+            command_response_to_zval(
+                &response->array_value[i], &value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
+            zend_symtable_update(Z_ARRVAL_P(return_value), Z_STR(args->fields[i]), &value);
         }
     }
 
-    zval_dtor(&temp_array);
+    free_h_fields_args(args);
     return 1;
 }
 
@@ -1082,8 +1071,6 @@ z_result_processor_t get_processor_for_response_type(int response_type) {
             return process_h_array_result_async;
         case H_RESPONSE_MAP:
             return process_h_map_result_async;
-        case H_RESPONSE_GETEX:
-            return process_h_getex_result_async;
         case H_RESPONSE_OK:
             return process_h_ok_result_async;
         default:
@@ -1096,67 +1083,57 @@ z_result_processor_t get_processor_for_response_type(int response_type) {
  * ==================================================================== */
 
 /**
- * Process results for HMGET (associative field mapping) - legacy version
+ * Release a heap h_command_args_t together with the field strings it owns (HMGET, HGETEX)
+ */
+void free_h_fields_args(void* output) {
+    h_command_args_t* args = (h_command_args_t*) output;
+
+    for (int i = 0; i < args->field_count; i++) {
+        zval_ptr_dtor(&args->fields[i]);
+    }
+    efree(args->fields);
+    efree(args);
+}
+
+/**
+ * Process results for HMGET (associative field mapping). args->fields holds the field
+ * strings the command was sent with, see h_field_to_string(); they become the result keys
+ * as they are.
  */
 int process_h_mget_result(CommandResponse* response, void* output, zval* return_value) {
     h_command_args_t* args = (h_command_args_t*) output;
 
     /* Check if the command was successful */
     if (!response) {
-        efree(args->fields);
-        efree(args);
+        free_h_fields_args(args);
         return 0;
     }
 
 
-    /* Process the result - map back to original field names */
+    /* Map values back to the field strings the command was sent with */
     int ret_val = 0;
     if (response && response->response_type == Array) {
-        /* Initialize return array */
-        array_init(return_value);
+        array_init_size(return_value, (uint32_t) args->field_count);
         for (int i = 0; i < args->field_count && i < response->array_value_len; i++) {
-            zval*  field = &args->fields[i];
-            zval   field_value;
-            char*  field_str    = NULL;
-            size_t field_len    = 0;
-            int    need_to_free = 0;
-
-            /* Convert field to string for associative array key */
-            field_str = zval_to_string_safe(field, &field_len, &need_to_free);
-
-            if (!field_str) {
-                continue;
-            }
-
-            /* Set value in result array */
             struct CommandResponse* element = &response->array_value[i];
+            zval                    field_value;
 
             if (element->response_type == String) {
-                ZVAL_STRINGL(&field_value, element->string_value, element->string_value_len);
+                ZVAL_STRINGL_FAST(&field_value, element->string_value, element->string_value_len);
             } else if (element->response_type == Null) {
                 ZVAL_FALSE(&field_value);
             } else {
                 ZVAL_NULL(&field_value);
             }
 
-            add_assoc_zval_ex(return_value, field_str, field_len, &field_value);
-
-            /* Free the field string if we allocated it */
-            if (need_to_free) {
-                efree(field_str);
-            }
+            zend_symtable_update(Z_ARRVAL_P(return_value), Z_STR(args->fields[i]), &field_value);
         }
         ret_val = 1;
     } else {
         ZVAL_NULL(return_value);
     }
 
-    /* Free field array */
-    for (int j = 0; j < args->field_count; j++) {
-        zval_ptr_dtor(&args->fields[j]);
-    }
-    efree(args->fields);
-    efree(args);
+    free_h_fields_args(args);
 
     return ret_val;
 }
@@ -1914,6 +1891,31 @@ int execute_hincrbyfloat_command(zval* object, int argc, zval* return_value, zen
     return 0;
 }
 
+/**
+ * Stringify an HMGET/HGETEX field once, with the same formatting zval_to_string_safe()
+ * sends. The string's hash is computed here so inserting the reply under it is a plain lookup.
+ */
+static zend_string* h_field_to_string(zval* field) {
+    zend_string* str;
+
+    ZVAL_DEREF(field);
+    if (Z_TYPE_P(field) == IS_STRING) {
+        str = zend_string_copy(Z_STR_P(field));
+    } else if (Z_TYPE_P(field) == IS_LONG) {
+        str = zend_long_to_str(Z_LVAL_P(field));
+    } else if (Z_TYPE_P(field) == IS_DOUBLE) {
+        size_t len;
+        char*  buf = double_to_string(Z_DVAL_P(field), &len);
+        str        = zend_string_init(buf, len, 0);
+        efree(buf);
+    } else {
+        str = zval_get_string(field);
+    }
+
+    zend_string_hash_val(str);
+    return str;
+}
+
 /**
  * Execute HMGET command with unified signature
  */
@@ -1969,19 +1971,18 @@ int execute_hmget_command(zval* object, int argc, zval* return_value, zend_class
         return 0;
     }
 
-    /* Fill field array */
+    /* Fill field array with strings that are both sent and reused as result keys */
     int i = 0;
     ZEND_HASH_FOREACH_KEY_VAL(fields_hash, num_idx, hash_key, data) {
         zval* real_data = Z_ISREF_P(data) ? Z_REFVAL_P(data) : data;
         if (hash_key) {
+            /* Hash table keys already carry their hash */
             ZVAL_STR_COPY(&field_array[i], hash_key);
             i++;
-        } else if (Z_TYPE_P(real_data) == IS_STRING && Z_STRLEN_P(real_data) > 0) {
-            ZVAL_COPY(&field_array[i], real_data);
-            i++;
-        } else if (Z_TYPE_P(real_data) == IS_LONG || Z_TYPE_P(real_data) == IS_DOUBLE ||
+        } else if ((Z_TYPE_P(real_data) == IS_STRING && Z_STRLEN_P(real_data) > 0) ||
+                   Z_TYPE_P(real_data) == IS_LONG || Z_TYPE_P(real_data) == IS_DOUBLE ||
                    Z_TYPE_P(real_data) == IS_TRUE) {
-            ZVAL_COPY(&field_array[i], real_data);
+            ZVAL_STR(&field_array[i], h_field_to_string(real_data));
             i++;
         }
     }
@@ -3057,26 +3058,27 @@ int execute_hgetex_command(zval* object, int argc, zval* return_value, zend_clas
         return 0;
     }
 
-    h_command_args_t args = {0};
-    args.key              = key;
-    args.key_len          = key_len;
+    h_command_args_t* args = ecalloc(1, sizeof(h_command_args_t));
+    args->glide_client     = valkey_glide->glide_client;
+    args->key              = key;
+    args->key_len          = key_len;
 
     // Extract fields from the array parameter
     int   field_count = zend_array_count(Z_ARRVAL_P(fields));
     zval* field_array = emalloc(field_count * sizeof(zval));
 
-    // Copy fields from the PHP array to our zval array
+    // Stringify the fields once; the strings are sent and become the result keys
     HashTable* fields_ht = Z_ARRVAL_P(fields);
     zval*      field_val;
     int        i = 0;
     ZEND_HASH_FOREACH_VAL(fields_ht, field_val) {
-        ZVAL_COPY(&field_array[i], field_val);
+        ZVAL_STR(&field_array[i], h_field_to_string(field_val));
         i++;
     }
     ZEND_HASH_FOREACH_END();
 
-    args.fields      = field_array;
-    args.field_count = field_count;
+    args->fields      = field_array;
+    args->field_count = field_count;
 
     // Parse options array if provided (consistent with getEx)
     if (options && Z_TYPE_P(options) == IS_ARRAY) {
@@ -3085,38 +3087,33 @@ int execute_hgetex_command(zval* object, int argc, zval* return_value, zend_clas
 
         // Check for EX (seconds)
         if ((z_val = zend_hash_str_find(opts_ht, "EX", 2)) != NULL) {
-            args.expiry      = (int) zval_get_long(z_val);
-            args.expiry_type = "EX";
+            args->expiry      = (int) zval_get_long(z_val);
+            args->expiry_type = "EX";
         }
         // Check for PX (milliseconds)
         else if ((z_val = zend_hash_str_find(opts_ht, "PX", 2)) != NULL) {
-            args.expiry      = (int) zval_get_long(z_val);
-            args.expiry_type = "PX";
+            args->expiry      = (int) zval_get_long(z_val);
+            args->expiry_type = "PX";
         }
         // Check for EXAT (unix timestamp)
         else if ((z_val = zend_hash_str_find(opts_ht, "EXAT", 4)) != NULL) {
-            args.expiry      = (int) zval_get_long(z_val);
-            args.expiry_type = "EXAT";
+            args->expiry      = (int) zval_get_long(z_val);
+            args->expiry_type = "EXAT";
         }
         // Check for PXAT (unix timestamp in milliseconds)
         else if ((z_val = zend_hash_str_find(opts_ht, "PXAT", 4)) != NULL) {
-            args.expiry      = (int) zval_get_long(z_val);
-            args.expiry_type = "PXAT";
+            args->expiry      = (int) zval_get_long(z_val);
+            args->expiry_type = "PXAT";
         }
         // Check for PERSIST
         else if (zend_hash_str_exists(opts_ht, "PERSIST", 7)) {
-            args.expiry_type = "PERSIST";
+            args->expiry_type = "PERSIST";
         }
     }
 
-    int result = execute_h_simple_command(
-        valkey_glide, HGetEx, &args, &args, H_RESPONSE_GETEX, return_value);
-
-    // Cleanup allocated field array
-    for (int j = 0; j < field_count; j++) {
-        zval_dtor(&field_array[j]);
-    }
-    efree(field_array);
+    // args and the field strings are released by the result processor
+    int result = execute_h_generic_command(
+        valkey_glide, HGetEx, args, args, process_h_getex_result_async, return_value);
 
     if (result) {
         if (valkey_glide->is_in_batch_mode) {
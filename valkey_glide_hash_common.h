@@ -304,7 +304,6 @@ void cleanup_h_command_args(char**         allocated_strings,
 #define H_RESPONSE_MAP 5
 #define H_RESPONSE_OK 6
 #define H_RESPONSE_CUSTOM 7
-#define H_RESPONSE_GETEX 8
 
 /* ====================================================================
  * HASH COMMAND EXECUTION FUNCTIONS
@@ -362,6 +361,9 @@ int execute_h_randfield_command(valkey_glide_object* valkey_glide,
 int process_h_ok_result_async(CommandResponse* response, void* output, zval* return_value);
 
 int process_h_getex_result_async(CommandResponse* response, void* output, zval* return_value);
+
+void free_h_fields_args(void* output);
+
 /* ====================================================================
  * HASH COMMAND MACROS
  * ==================================================================== */
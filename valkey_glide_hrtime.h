@@ -0,0 +1,32 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_HRTIME_H
+#define VALKEY_GLIDE_HRTIME_H
+
+#include "php.h"
+
+/* zend_hrtime() and zend_hrtime_t arrived in PHP 8.3; older versions get the same monotonic
+ * nanosecond clock from ext/standard/hrtime.h */
+#if PHP_VERSION_ID >= 80300
+#include <zend_hrtime.h>
+#else
+#include <ext/standard/hrtime.h>
+
+typedef php_hrtime_t zend_hrtime_t;
+
+#define zend_hrtime() php_hrtime_current()
+#endif
+
+#endif /* VALKEY_GLIDE_HRTIME_H */
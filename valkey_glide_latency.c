@@ -0,0 +1,249 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_latency.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+
+#define LATENCY_SUB_BITS 4
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BITS)
+#define LATENCY_BUCKETS (64 * LATENCY_SUB_BUCKETS)
+#define LATENCY_MAX_TYPES 2048 /* Upper bound on RequestType values we index directly */
+#define LATENCY_NAME_LEN 64
+
+typedef struct {
+    uint64_t             counts[LATENCY_BUCKETS];
+    uint64_t             count;
+    uint64_t             sum_ns;
+    uint64_t             min_ns;
+    uint64_t             max_ns;
+    const zend_function* method;       /* Method recording here, NULL outside any method */
+    int                  command_type; /* Request type, only told apart when method is NULL */
+    char                 name[LATENCY_NAME_LEN];
+} latency_histogram_t;
+
+/* One histogram per calling method: a request type alone is not a label, as CustomCommand
+ * carries eval, rawCommand, SCRIPT LOAD and more */
+ZEND_TLS latency_histogram_t** latency_hists;
+ZEND_TLS size_t                latency_hist_count;
+ZEND_TLS size_t                latency_hist_cap;
+
+/* Histogram each request type last recorded into, so the usual lookup is one compare */
+ZEND_TLS latency_histogram_t* latency_by_type[LATENCY_MAX_TYPES];
+
+/* Values below 16ns map 1:1; above, the top LATENCY_SUB_BITS bits after the leading one
+ * select the sub-bucket of that power of two */
+static inline size_t latency_bucket(uint64_t ns) {
+    if (ns < LATENCY_SUB_BUCKETS) {
+        return (size_t) ns;
+    }
+    unsigned msb   = 63 - (unsigned) __builtin_clzll(ns);
+    unsigned shift = msb - LATENCY_SUB_BITS;
+    return (size_t) (shift + 1) * LATENCY_SUB_BUCKETS +
+           (size_t) ((ns >> shift) & (LATENCY_SUB_BUCKETS - 1));
+}
+
+/* Largest value that lands in bucket */
+static uint64_t latency_bucket_upper(size_t bucket) {
+    if (bucket < LATENCY_SUB_BUCKETS) {
+        return bucket;
+    }
+    unsigned shift = (unsigned) (bucket / LATENCY_SUB_BUCKETS) - 1;
+    uint64_t sub   = (uint64_t) (bucket % LATENCY_SUB_BUCKETS) | LATENCY_SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+static latency_histogram_t* latency_histogram_find(const zend_function* method,
+                                                   enum RequestType     command_type) {
+    latency_histogram_t* hist;
+    size_t               i;
+
+    for (i = 0; i < latency_hist_count; i++) {
+        hist = latency_hists[i];
+        if (hist->method == method && (method || hist->command_type == (int) command_type)) {
+            return hist;
+        }
+    }
+
+    if (latency_hist_count == latency_hist_cap) {
+        size_t                cap  = latency_hist_cap ? latency_hist_cap * 2 : 32;
+        latency_histogram_t** grow = realloc(latency_hists, cap * sizeof(*grow));
+        if (!grow) {
+            return NULL;
+        }
+        latency_hists    = grow;
+        latency_hist_cap = cap;
+    }
+    if (!(hist = calloc(1, sizeof(latency_histogram_t)))) {
+        return NULL;
+    }
+    hist->min_ns       = UINT64_MAX;
+    hist->method       = method;
+    hist->command_type = (int) command_type;
+
+    /* Request types have no names on this side of the FFI; the calling method is the
+     * natural label (get, hGetAll, ValkeyGlideScript::run, ...) */
+    if (method) {
+        valkey_glide_method_label(method, hist->name, LATENCY_NAME_LEN);
+    } else {
+        snprintf(hist->name, LATENCY_NAME_LEN, "request_%d", (int) command_type);
+    }
+
+    latency_hists[latency_hist_count++] = hist;
+    return hist;
+}
+
+void valkey_glide_latency_record(enum RequestType command_type, zend_hrtime_t start) {
+    uint64_t             ns     = (uint64_t) (zend_hrtime() - start);
+    const zend_function* method = valkey_glide_calling_method();
+    latency_histogram_t* hist;
+
+    if (UNEXPECTED((unsigned) command_type >= LATENCY_MAX_TYPES)) {
+        return;
+    }
+    hist = latency_by_type[command_type];
+    if (UNEXPECTED(!hist || hist->method != method)) {
+        if (!(hist = latency_histogram_find(method, command_type))) {
+            return;
+        }
+        latency_by_type[command_type] = hist;
+    }
+
+    hist->counts[latency_bucket(ns)]++;
+    hist->count++;
+    hist->sum_ns += ns;
+    if (ns < hist->min_ns) {
+        hist->min_ns = ns;
+    }
+    if (ns > hist->max_ns) {
+        hist->max_ns = ns;
+    }
+}
+
+/* Value at quantile q (0..1), reported as the upper edge of its bucket in microseconds */
+static double latency_quantile_us(const latency_histogram_t* hist, double q) {
+    uint64_t rank = (uint64_t) (q * (double) hist->count + 0.5);
+    uint64_t seen = 0;
+    size_t   i;
+
+    if (rank < 1) {
+        rank = 1;
+    }
+    for (i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += hist->counts[i];
+        if (seen >= rank) {
+            uint64_t upper = latency_bucket_upper(i);
+            return (double) MIN(upper, hist->max_ns) / 1000.0;
+        }
+    }
+    return (double) hist->max_ns / 1000.0;
+}
+
+static void latency_histogram_to_zval(const latency_histogram_t* hist, zval* out) {
+    array_init_size(out, 8);
+    add_assoc_long(out, "count", (zend_long) hist->count);
+    add_assoc_double(out, "min_us", (double) hist->min_ns / 1000.0);
+    add_assoc_double(out, "mean_us", (double) hist->sum_ns / (double) hist->count / 1000.0);
+    add_assoc_double(out, "p50_us", latency_quantile_us(hist, 0.50));
+    add_assoc_double(out, "p90_us", latency_quantile_us(hist, 0.90));
+    add_assoc_double(out, "p99_us", latency_quantile_us(hist, 0.99));
+    add_assoc_double(out, "p999_us", latency_quantile_us(hist, 0.999));
+    add_assoc_double(out, "max_us", (double) hist->max_ns / 1000.0);
+}
+
+/* Sum every histogram labelled name (client and cluster methods share one), starting the
+ * scan at index first */
+static void latency_merge_named(latency_histogram_t* into, const char* name, size_t first) {
+    size_t i, b;
+
+    memset(into, 0, sizeof(*into));
+    into->min_ns = UINT64_MAX;
+    for (i = first; i < latency_hist_count; i++) {
+        const latency_histogram_t* hist = latency_hists[i];
+        if (hist->count == 0 || strcmp(hist->name, name) != 0) {
+            continue;
+        }
+        for (b = 0; b < LATENCY_BUCKETS; b++) {
+            into->counts[b] += hist->counts[b];
+        }
+        into->count += hist->count;
+        into->sum_ns += hist->sum_ns;
+        into->min_ns = MIN(into->min_ns, hist->min_ns);
+        into->max_ns = MAX(into->max_ns, hist->max_ns);
+    }
+}
+
+void valkey_glide_latency_stats(zend_string* command, zval* return_value) {
+    latency_histogram_t* merged = emalloc(sizeof(latency_histogram_t));
+    size_t               i;
+
+    array_init(return_value);
+    for (i = 0; i < latency_hist_count; i++) {
+        latency_histogram_t* hist = latency_hists[i];
+        size_t               name_len;
+        zval                 stats;
+
+        if (hist->count == 0) {
+            continue;
+        }
+        name_len = strlen(hist->name);
+
+        if (command) {
+            if (zend_binary_strcasecmp(
+                    ZSTR_VAL(command), ZSTR_LEN(command), hist->name, name_len) != 0) {
+                continue;
+            }
+            latency_merge_named(merged, hist->name, i);
+            zval_ptr_dtor(return_value);
+            latency_histogram_to_zval(merged, return_value);
+            break;
+        }
+        if (zend_hash_str_exists(Z_ARRVAL_P(return_value), hist->name, name_len)) {
+            continue;
+        }
+        latency_merge_named(merged, hist->name, i);
+        latency_histogram_to_zval(merged, &stats);
+        zend_hash_str_add_new(Z_ARRVAL_P(return_value), hist->name, name_len, &stats);
+    }
+    efree(merged);
+}
+
+void valkey_glide_latency_reset(void) {
+    size_t i;
+
+    for (i = 0; i < latency_hist_count; i++) {
+        latency_histogram_t* hist = latency_hists[i];
+        memset(hist->counts, 0, sizeof(hist->counts));
+        hist->count  = 0;
+        hist->sum_ns = 0;
+        hist->min_ns = UINT64_MAX;
+        hist->max_ns = 0;
+    }
+}
+
+void valkey_glide_latency_shutdown(void) {
+    size_t i;
+
+    for (i = 0; i < latency_hist_count; i++) {
+        free(latency_hists[i]);
+    }
+    free(latency_hists);
+    latency_hists      = NULL;
+    latency_hist_count = 0;
+    latency_hist_cap   = 0;
+    memset(latency_by_type, 0, sizeof(latency_by_type));
+}
@@ -0,0 +1,42 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_LATENCY_H
+#define VALKEY_GLIDE_LATENCY_H
+
+#include "include/glide_bindings.h"
+#include "php.h"
+#include "valkey_glide_hrtime.h"
+
+/*
+ * Client-side latency histograms, one per RequestType.
+ *
+ * Buckets are log-linear (16 linear sub-buckets per power of two, so at most ~6% relative
+ * error), which makes recording a shift, a mask and an increment. Histograms live in
+ * process (thread, under ZTS) local storage and are never locked.
+ */
+
+/* Record the time since start (from zend_hrtime()) against command_type */
+void valkey_glide_latency_record(enum RequestType command_type, zend_hrtime_t start);
+
+/* Fill return_value with the stats of one command (by method name), or of all of them */
+void valkey_glide_latency_stats(zend_string* command, zval* return_value);
+
+/* Forget everything recorded so far */
+void valkey_glide_latency_reset(void);
+
+/* Release the histograms at module shutdown */
+void valkey_glide_latency_shutdown(void);
+
+#endif /* VALKEY_GLIDE_LATENCY_H */
@@ -265,8 +265,14 @@ int execute_list_generic_command(valkey_glide_object* valkey_glide,
         /* For batch mode, we need to use batch-compatible result processors */
 
 
-        status = buffer_command_for_batch(
-            valkey_glide, cmd_type, cmd_args, args_len, arg_count, result_ptr, process_result);
+        status = buffer_command_for_batch(valkey_glide,
+                                          cmd_type,
+                                          cmd_args,
+                                          args_len,
+                                          arg_count,
+                                          result_ptr,
+                                          process_result,
+                                          NULL);
 
         goto cleanup;
     }
@@ -278,9 +284,9 @@ int execute_list_generic_command(valkey_glide_object* valkey_glide,
     /* Process result */
     if (result) {
         if (!result->command_error && result->response && process_result) {
-            status = process_result(result->response, result_ptr, return_value);
+            status = valkey_glide_async_decode(result, process_result, result_ptr, return_value);
         }
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
     }
 
 cleanup:
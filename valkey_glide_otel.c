@@ -15,6 +15,7 @@
 
 #include "valkey_glide_otel.h"
 
+#include <inttypes.h>
 #include <string.h>
 #include <zend_API.h>
 #include <zend_exceptions.h>
@@ -24,14 +25,52 @@
 
 /* Forward declarations for static functions */
 static void                               cleanup_otel_config(void);
-static bool                               valkey_glide_otel_should_sample(void);
+static bool valkey_glide_otel_should_sample(enum RequestType request_type, bool batch);
 static struct OpenTelemetryConfig*        parse_otel_config(zval* config_obj);
 static struct OpenTelemetryTracesConfig*  parse_traces_config_object(zval* traces_obj);
+static void                               parse_command_sample_rules(HashTable* rules);
 static struct OpenTelemetryMetricsConfig* parse_metrics_config_object(zval* metrics_obj);
 
 /* Global OTEL configuration */
 struct OpenTelemetryConfig* g_otel_config = NULL;
 
+/* W3C trace context of the surrounding PHP trace, set with setOtelTraceParent(). The core
+ * can only parent spans to spans it created itself, so only the sampled flag is acted on */
+#define TRACE_PARENT_LEN 55 /* version 00: 2 + 1 + 32 + 1 + 16 + 1 + 2 */
+
+ZEND_TLS bool g_trace_parent_set;
+ZEND_TLS bool g_trace_parent_sampled;
+ZEND_TLS char g_trace_parent[TRACE_PARENT_LEN + 1];
+
+/* Sampling rates are probabilities scaled to 2^32, so 100% is 1 << 32 */
+#define SAMPLE_SCALE (UINT64_C(1) << 32)
+#define SAMPLE_MAX_TYPES 2048 /* Upper bound on RequestType values we index directly */
+#define SAMPLE_RULE_NAME_LEN 64
+
+typedef struct {
+    char     name[SAMPLE_RULE_NAME_LEN]; /* PHP method name, as in getLatencyStats() */
+    uint64_t rate;
+} otel_sample_rule_t;
+
+typedef struct {
+    const zend_function* method; /* Method the rule was resolved for */
+    uint16_t             rule;   /* 0 = not looked up yet, 1 = none, n = rule n - 2 */
+} otel_rule_cache_t;
+
+/* Per-command rates from TracesConfig::getCommandSamplePercentages() */
+static otel_sample_rule_t* g_sample_rules      = NULL;
+static size_t              g_sample_rule_count = 0;
+
+/* Commands slower than this always produce a span (0 disables tail sampling) */
+static uint64_t g_slow_threshold_ns = 0;
+
+/* Rule last resolved for each request type. Rules name methods and several methods share a
+ * request type (eval and rawCommand both send CustomCommand), so the method is checked too */
+ZEND_TLS otel_rule_cache_t g_rule_by_type[SAMPLE_MAX_TYPES];
+
+/* xorshift64* state, seeded on first use */
+ZEND_TLS uint64_t g_sample_prng;
+
 /**
  * Initialize OpenTelemetry with the given configuration
  * Can only be initialized once per process
@@ -116,17 +155,164 @@ static void valkey_glide_otel_shutdown(void) {
     }
 }
 
+/**
+ * Decide whether the next command or batch is traced. Runs before anything is allocated:
+ * an unsampled upstream trace or a losing head-sampling draw costs no FFI call at all.
+ */
+static bool valkey_glide_otel_trace_next(enum RequestType request_type, bool batch) {
+    if (!g_otel_config) {
+        return false;
+    }
+    if (g_trace_parent_set && !g_trace_parent_sampled) {
+        return false;
+    }
+    return valkey_glide_otel_should_sample(request_type, batch);
+}
+
 /**
  * Create a span for command tracing
  */
 uint64_t valkey_glide_create_span(enum RequestType request_type) {
-    if (!g_otel_config) {
+    if (!valkey_glide_otel_trace_next(request_type, false)) {
         return 0;
     }
-    if (!valkey_glide_otel_should_sample()) {
+    return create_otel_span(request_type);
+}
+
+/**
+ * Tail sampling: report a command that head sampling skipped but that took longer than the
+ * configured threshold. The span name stays fixed per command so traces group by it; the
+ * core cannot backdate a span or attach attributes, so the duration is logged instead.
+ */
+void valkey_glide_otel_tail_sample(enum RequestType request_type,
+                                   uint64_t         span_ptr,
+                                   zend_hrtime_t    started) {
+    uint64_t             elapsed_ns;
+    const zend_function* method;
+    char                 label[SAMPLE_RULE_NAME_LEN];
+    char                 name[sizeof("slow ") + SAMPLE_RULE_NAME_LEN];
+    uint64_t             tail_span;
+
+    if (EXPECTED(!g_slow_threshold_ns) || span_ptr || !g_otel_config) {
+        return;
+    }
+    elapsed_ns = (uint64_t) (zend_hrtime() - started);
+    if (elapsed_ns < g_slow_threshold_ns) {
+        return;
+    }
+
+    method = valkey_glide_calling_method();
+    if (method) {
+        valkey_glide_method_label(method, label, sizeof(label));
+    } else {
+        snprintf(label, sizeof(label), "request_%d", (int) request_type);
+    }
+    snprintf(name, sizeof(name), "slow %s", label);
+    VALKEY_LOG_DEBUG_FMT("otel_tail_sample", "%s took %" PRIu64 "us", label, elapsed_ns / 1000);
+
+    tail_span = create_named_otel_span(name);
+    valkey_glide_drop_span(tail_span);
+}
+
+/**
+ * Create a span covering a whole MULTI/EXEC or pipeline
+ */
+uint64_t valkey_glide_create_batch_span(void) {
+    if (!valkey_glide_otel_trace_next(0, true)) {
         return 0;
     }
-    return create_otel_span(request_type);
+    return create_batch_otel_span();
+}
+
+/**
+ * Create one child span per batched command so traces show what the batch contained.
+ * Returns NULL when the batch itself is not traced.
+ */
+uint64_t* valkey_glide_create_batch_child_spans(uint64_t                     batch_span,
+                                                const struct CmdInfo* const* cmds,
+                                                size_t                       count) {
+    uint64_t* children;
+    size_t    i;
+
+    if (!batch_span || count == 0) {
+        return NULL;
+    }
+
+    children = safe_emalloc(count, sizeof(uint64_t), 0);
+    for (i = 0; i < count; i++) {
+        children[i] = create_otel_span_with_parent(cmds[i]->request_type, batch_span);
+    }
+    return children;
+}
+
+/**
+ * End a batch span and its children
+ */
+void valkey_glide_drop_batch_spans(uint64_t batch_span, uint64_t* children, size_t count) {
+    size_t i;
+
+    if (children) {
+        for (i = 0; i < count; i++) {
+            valkey_glide_drop_span(children[i]);
+        }
+        efree(children);
+    }
+    valkey_glide_drop_span(batch_span);
+}
+
+/**
+ * Set (or clear with NULL) the W3C traceparent of the active PHP trace.
+ * Returns false if the header is malformed.
+ */
+bool valkey_glide_otel_set_trace_parent(const char* traceparent, size_t len) {
+    size_t i;
+
+    if (traceparent) {
+        /* version "-" trace-id "-" parent-id "-" flags, all lowercase hex */
+        if (len < TRACE_PARENT_LEN || traceparent[2] != '-' || traceparent[35] != '-' ||
+            traceparent[52] != '-' || (len > TRACE_PARENT_LEN && traceparent[55] != '-')) {
+            return false;
+        }
+        for (i = 0; i < TRACE_PARENT_LEN; i++) {
+            char c = traceparent[i];
+            if (i == 2 || i == 35 || i == 52) {
+                continue;
+            }
+            if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+                return false;
+            }
+        }
+        /* Version ff is forbidden, all-zero ids are invalid, and 00 has no extra fields */
+        if (strncmp(traceparent, "ff", 2) == 0 ||
+            strspn(traceparent + 3, "0") >= 32 || strspn(traceparent + 36, "0") >= 16 ||
+            (strncmp(traceparent, "00", 2) == 0 && len != TRACE_PARENT_LEN)) {
+            return false;
+        }
+    }
+
+    g_trace_parent_set = traceparent != NULL;
+    if (traceparent) {
+        int flags;
+        memcpy(g_trace_parent, traceparent, TRACE_PARENT_LEN);
+        g_trace_parent[TRACE_PARENT_LEN] = '\0';
+        sscanf(traceparent + 53, "%2x", &flags);
+        g_trace_parent_sampled = (flags & 0x01) != 0;
+    }
+    return true;
+}
+
+/**
+ * Get the traceparent set with valkey_glide_otel_set_trace_parent(), or NULL
+ */
+const char* valkey_glide_otel_get_trace_parent(void) {
+    return g_trace_parent_set ? g_trace_parent : NULL;
+}
+
+/**
+ * Forget the trace context at the end of a request so it never leaks into the next one
+ */
+void valkey_glide_otel_request_shutdown(void) {
+    valkey_glide_otel_set_trace_parent(NULL, 0);
 }
 
 /**
@@ -229,6 +415,33 @@ static struct OpenTelemetryConfig* parse_otel_config(zval* config_obj) {
     return main_config;
 }
 
+/**
+ * Parse the command name => percentage map of TracesConfig into sampling rules
+ */
+static void parse_command_sample_rules(HashTable* rules) {
+    zend_string* name;
+    zval*        percentage;
+
+    if (zend_hash_num_elements(rules) == 0) {
+        return;
+    }
+
+    g_sample_rules = pecalloc(zend_hash_num_elements(rules), sizeof(otel_sample_rule_t), 1);
+    ZEND_HASH_FOREACH_STR_KEY_VAL(rules, name, percentage) {
+        otel_sample_rule_t* rule = &g_sample_rules[g_sample_rule_count];
+        double              pct  = zval_get_double(percentage);
+
+        if (!name || ZSTR_LEN(name) >= SAMPLE_RULE_NAME_LEN || pct < 0.0 || pct > 100.0) {
+            VALKEY_LOG_WARN("otel_config", "Ignoring invalid command sample percentage");
+            continue;
+        }
+        memcpy(rule->name, ZSTR_VAL(name), ZSTR_LEN(name));
+        rule->rate = (uint64_t) (pct / 100.0 * (double) SAMPLE_SCALE);
+        g_sample_rule_count++;
+    }
+    ZEND_HASH_FOREACH_END();
+}
+
 /**
  * Parse traces configuration from TracesConfig object
  */
@@ -260,6 +473,22 @@ static struct OpenTelemetryTracesConfig* parse_traces_config_object(zval* traces
         return NULL;
     }
 
+    // Get per-command sample percentages
+    if (call_method(traces_obj, "getCommandSamplePercentages", &retval)) {
+        if (Z_TYPE(retval) == IS_ARRAY) {
+            parse_command_sample_rules(Z_ARRVAL(retval));
+        }
+        zval_dtor(&retval);
+    }
+
+    // Get tail sampling threshold
+    if (call_method(traces_obj, "getSlowCommandThresholdUs", &retval)) {
+        if (Z_TYPE(retval) == IS_LONG && Z_LVAL(retval) > 0) {
+            g_slow_threshold_ns = (uint64_t) Z_LVAL(retval) * 1000;
+        }
+        zval_dtor(&retval);
+    }
+
     // Allocate and populate FFI traces config struct
     struct OpenTelemetryTracesConfig* traces_config =
         emalloc(sizeof(struct OpenTelemetryTracesConfig));
@@ -322,12 +551,76 @@ static void cleanup_otel_config(void) {
 
     efree(g_otel_config);
     g_otel_config = NULL;
+
+    if (g_sample_rules) {
+        pefree(g_sample_rules, 1);
+        g_sample_rules = NULL;
+    }
+    g_sample_rule_count = 0;
+    g_slow_threshold_ns = 0;
+    memset(g_rule_by_type, 0, sizeof(g_rule_by_type));
+}
+
+/* Thread-local xorshift64*: no locking and no libc call per decision, unlike rand() */
+static inline uint32_t otel_sample_random(void) {
+    uint64_t x = g_sample_prng;
+
+    if (UNEXPECTED(x == 0)) {
+        /* splitmix64 of the clock and a per-thread address */
+        x = (uint64_t) zend_hrtime() ^ (uint64_t) (uintptr_t) &g_sample_prng;
+        x += UINT64_C(0x9E3779B97F4A7C15);
+        x = (x ^ (x >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+        x = (x ^ (x >> 27)) * UINT64_C(0x94D049BB133111EB);
+        x ^= x >> 31;
+        x |= 1;
+    }
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    g_sample_prng = x;
+    return (uint32_t) ((x * UINT64_C(0x2545F4914F6CDD1D)) >> 32);
+}
+
+/* Find the rule for the calling PHP method; request types carry no names of their own */
+static uint16_t otel_resolve_rule(const zend_function* method) {
+    char   label[SAMPLE_RULE_NAME_LEN];
+    size_t i;
+
+    if (!method) {
+        return 1;
+    }
+    valkey_glide_method_label(method, label, sizeof(label));
+    for (i = 0; i < g_sample_rule_count; i++) {
+        if (strcasecmp(label, g_sample_rules[i].name) == 0) {
+            return (uint16_t) (i + 2);
+        }
+    }
+    return 1;
 }
 
-static bool valkey_glide_otel_should_sample(void) {
+static bool valkey_glide_otel_should_sample(enum RequestType request_type, bool batch) {
+    uint64_t rate;
+
     if (!g_otel_config || !g_otel_config->traces) {
         return false;
     }
-    uint32_t percentage = g_otel_config->traces->sample_percentage;
-    return percentage > 0 && (percentage == 100 || (rand() % 100) < percentage);
+    rate = ((uint64_t) g_otel_config->traces->sample_percentage * SAMPLE_SCALE) / 100;
+
+    if (g_sample_rule_count && !batch && (unsigned) request_type < SAMPLE_MAX_TYPES) {
+        otel_rule_cache_t*   cached = &g_rule_by_type[request_type];
+        const zend_function* method = valkey_glide_calling_method();
+
+        if (UNEXPECTED(cached->rule == 0 || cached->method != method)) {
+            cached->method = method;
+            cached->rule   = otel_resolve_rule(method);
+        }
+        if (cached->rule > 1) {
+            rate = g_sample_rules[cached->rule - 2].rate;
+        }
+    }
+
+    if (rate == 0) {
+        return false;
+    }
+    return rate >= SAMPLE_SCALE || otel_sample_random() < rate;
 }
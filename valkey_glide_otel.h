@@ -17,6 +17,7 @@
 
 #include "include/glide_bindings.h"
 #include "php.h"
+#include "valkey_glide_hrtime.h"
 
 /* Global OTEL configuration */
 extern struct OpenTelemetryConfig* g_otel_config;
@@ -27,5 +28,20 @@ void     valkey_glide_otel_set_sample_percentage(uint32_t percentage);
 int      valkey_glide_otel_get_sample_percentage(uint32_t* percentage);
 uint64_t valkey_glide_create_span(enum RequestType request_type);
 void     valkey_glide_drop_span(uint64_t span_ptr);
+void     valkey_glide_otel_tail_sample(enum RequestType request_type,
+                                       uint64_t         span_ptr,
+                                       zend_hrtime_t    started);
+
+/* Batch tracing: one span for the batch, one child per command */
+uint64_t  valkey_glide_create_batch_span(void);
+uint64_t* valkey_glide_create_batch_child_spans(uint64_t                     batch_span,
+                                                const struct CmdInfo* const* cmds,
+                                                size_t                       count);
+void      valkey_glide_drop_batch_spans(uint64_t batch_span, uint64_t* children, size_t count);
+
+/* Parent context propagation from the application's trace */
+bool        valkey_glide_otel_set_trace_parent(const char* traceparent, size_t len);
+const char* valkey_glide_otel_get_trace_parent(void);
+void        valkey_glide_otel_request_shutdown(void);
 
 #endif /* VALKEY_GLIDE_OTEL_H */
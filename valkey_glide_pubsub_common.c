@@ -2,6 +2,7 @@
 
 #include "valkey_glide_pubsub_common.h"
 
+#include <time.h>
 #include <unistd.h>
 #include <zend_exceptions.h>
 
@@ -62,6 +63,22 @@ void cond_wait(cond_t* c, mutex_t* m) {
 #endif
 }
 
+bool cond_timed_wait(cond_t* c, mutex_t* m, long timeout_ms) {
+#ifdef _WIN32
+    return SleepConditionVariableCS(c, m, (DWORD) timeout_ms) != 0;
+#else
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return pthread_cond_timedwait(c, m, &deadline) == 0;
+#endif
+}
+
 void cond_signal(cond_t* c) {
 #ifdef _WIN32
     WakeConditionVariable(c);
@@ -379,7 +396,7 @@ static void subscribe_blocking_loop(uintptr_t connection, enum RequestType unsub
     struct CommandResult* unsub_result =
         command((const void*) connection, 0, unsub_type, 0, NULL, NULL, NULL, 0, 0);
     if (unsub_result) {
-        free_command_result(unsub_result);
+        valkey_glide_free_command_result(unsub_result);
     }
 
     info->in_subscribe_mode = false;
@@ -430,13 +447,13 @@ static int execute_subscribe_command(const void*      connection,
                 : error_prefix;
         VALKEY_LOG_ERROR(command_name, error_msg);
         if (result)
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
         php_unregister_pubsub_callback((uintptr_t) connection);
         zend_throw_exception(get_valkey_glide_exception_ce(), error_msg, 0);
         ZVAL_FALSE(return_value);
         return 0;
     }
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 
     char client_key[32];
     snprintf(client_key, sizeof(client_key), "%lu", (unsigned long) connection);
@@ -501,7 +518,7 @@ static void execute_unsubscribe_command(const void*      connection,
             if (result->command_error && result->command_error->command_error_message) {
                 VALKEY_LOG_ERROR(command_name, result->command_error->command_error_message);
             }
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
         }
 
         // Update subscription set
@@ -535,7 +552,7 @@ static void execute_unsubscribe_command(const void*      connection,
             if (result->command_error && result->command_error->command_error_message) {
                 VALKEY_LOG_ERROR(command_name, result->command_error->command_error_message);
             }
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
         }
 
         // Update subscription set
@@ -692,7 +709,7 @@ void valkey_glide_publish_impl(INTERNAL_FUNCTION_PARAMETERS, const void* connect
             zend_throw_exception(get_valkey_glide_exception_ce(), error_msg, 0);
             RETVAL_FALSE;
         }
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
     } else {
         VALKEY_LOG_ERROR("publish", "Publish command failed");
         zend_throw_exception(get_valkey_glide_exception_ce(), "Publish command failed", 0);
@@ -52,7 +52,7 @@ void valkey_glide_pubsub_impl(INTERNAL_FUNCTION_PARAMETERS, const void* connecti
 
         if (result && result->response && !result->command_error) {
             command_response_to_zval(result->response, return_value, 0, false);
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
         } else {
             const char* error_msg =
                 result && result->command_error && result->command_error->command_error_message
@@ -60,7 +60,7 @@ void valkey_glide_pubsub_impl(INTERNAL_FUNCTION_PARAMETERS, const void* connecti
                     : "PUBSUB CHANNELS command failed";
             VALKEY_LOG_ERROR("pubsub_channels", error_msg);
             if (result)
-                free_command_result(result);
+                valkey_glide_free_command_result(result);
             zend_throw_exception(get_valkey_glide_exception_ce(), error_msg, 0);
             RETURN_FALSE;
         }
@@ -104,7 +104,7 @@ void valkey_glide_pubsub_impl(INTERNAL_FUNCTION_PARAMETERS, const void* connecti
 
         if (result && result->response && !result->command_error) {
             command_response_to_zval(result->response, return_value, 0, false);
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
         } else {
             const char* error_msg =
                 result && result->command_error && result->command_error->command_error_message
@@ -112,7 +112,7 @@ void valkey_glide_pubsub_impl(INTERNAL_FUNCTION_PARAMETERS, const void* connecti
                     : "PUBSUB NUMSUB command failed";
             VALKEY_LOG_ERROR("pubsub_numsub", error_msg);
             if (result)
-                free_command_result(result);
+                valkey_glide_free_command_result(result);
             zend_throw_exception(get_valkey_glide_exception_ce(), error_msg, 0);
             RETURN_FALSE;
         }
@@ -131,7 +131,7 @@ void valkey_glide_pubsub_impl(INTERNAL_FUNCTION_PARAMETERS, const void* connecti
 
         if (result && result->response && !result->command_error) {
             command_response_to_zval(result->response, return_value, 0, false);
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
         } else {
             const char* error_msg =
                 result && result->command_error && result->command_error->command_error_message
@@ -139,7 +139,7 @@ void valkey_glide_pubsub_impl(INTERNAL_FUNCTION_PARAMETERS, const void* connecti
                     : "PUBSUB NUMPAT command failed";
             VALKEY_LOG_ERROR("pubsub_numpat", error_msg);
             if (result)
-                free_command_result(result);
+                valkey_glide_free_command_result(result);
             zend_throw_exception(get_valkey_glide_exception_ce(), error_msg, 0);
             RETURN_FALSE;
         }
@@ -557,15 +557,28 @@ int process_s_mixed_result_async(CommandResponse* response, void* output, zval*
         response, return_value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
 }
 
-/**
- * Batch-compatible async result processor for scan responses
- */
-
 typedef struct {
     enum RequestType cmd_type;
     char*            cursor;
     zval*            scan_iter;
 } scan_data_t;
+
+/**
+ * Batch cleanup for a scan_data_t whose processor never ran; releases what the processor
+ * would, without touching the caller's iterator
+ */
+static void free_s_scan_data(void* output) {
+    scan_data_t* args = (scan_data_t*) output;
+
+    if (args->scan_iter) {
+        efree(args->cursor);
+    }
+    efree(args);
+}
+
+/**
+ * Batch-compatible async result processor for scan responses
+ */
 int process_s_scan_result_async(CommandResponse* response, void* output, zval* return_value) {
     scan_data_t* args   = (scan_data_t*) output;
     int          status = 0;
@@ -824,8 +837,14 @@ int execute_s_generic_command(valkey_glide_object* valkey_glide,
     /* Check for batch mode */
     if (valkey_glide && valkey_glide->is_in_batch_mode) {
         /* Buffer command for batch execution */
-        status = buffer_command_for_batch(
-            valkey_glide, cmd_type, cmd_args, args_len, arg_count, scan_data, process_result);
+        status = buffer_command_for_batch(valkey_glide,
+                                          cmd_type,
+                                          cmd_args,
+                                          args_len,
+                                          arg_count,
+                                          scan_data,
+                                          process_result,
+                                          scan_data ? free_s_scan_data : NULL);
 
 
         goto cleanup;
@@ -834,9 +853,9 @@ int execute_s_generic_command(valkey_glide_object* valkey_glide,
     /* Execute the command synchronously */
     result = execute_command(valkey_glide->glide_client, cmd_type, arg_count, cmd_args, args_len);
     if (result) {
-        status = process_result(result->response, scan_data, return_value);
+        status = valkey_glide_async_decode(result, process_result, scan_data, return_value);
     }
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 
 
 cleanup:
@@ -1867,7 +1886,7 @@ int execute_cluster_scan_command(const void* glide_client,
             *cursor = estrdup("0");
         }
 
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
     }
 
     /* Cleanup */
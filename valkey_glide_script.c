@@ -0,0 +1,401 @@
+/*
+  +----------------------------------------------------------------------+
+  | ValkeyGlide Script                                                   |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_script.h"
+
+#include <ext/standard/sha1.h>
+#include <zend_exceptions.h>
+
+#include "command_response.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_script_arginfo.h"
+#include "valkey_glide_z_common.h"
+
+/* Global variables */
+static zend_class_entry*    script_ce;
+static zend_object_handlers script_object_handlers;
+
+#define SCRIPT_FROM_OBJ(o) VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_script_object, o)
+#define Z_SCRIPT_P(zv) SCRIPT_FROM_OBJ(Z_OBJ_P(zv))
+
+/* ====================================================================
+ * OBJECT LIFECYCLE
+ * ==================================================================== */
+
+static void script_release(valkey_glide_script_object* script) {
+    if (script->code) {
+        zend_string_release(script->code);
+        script->code = NULL;
+    }
+    if (script->sha1) {
+        zend_string_release(script->sha1);
+        script->sha1 = NULL;
+    }
+}
+
+static zend_object* create_script_object(zend_class_entry* ce) {
+    valkey_glide_script_object* script = zend_object_alloc(sizeof(valkey_glide_script_object), ce);
+
+    zend_object_std_init(&script->std, ce);
+    object_properties_init(&script->std, ce);
+    script->std.handlers = &script_object_handlers;
+
+    return &script->std;
+}
+
+static void free_script_object(zend_object* object) {
+    valkey_glide_script_object* script = SCRIPT_FROM_OBJ(object);
+
+    script_release(script);
+    zend_object_std_dtor(object);
+}
+
+/* ====================================================================
+ * LOADED CONNECTIONS
+ * ==================================================================== */
+
+/* A client's loaded_scripts maps each sha1 it has seen run to true for a standalone client, or
+ * a bitmap of hash slots for a cluster client. It lives on the client object and is freed with
+ * it, so nothing carries over to another connection */
+
+/* Slot a call is tracked under: 0 for standalone clients, the hash slot of the first key for
+ * cluster clients, -1 for a keyless cluster call that may land on any node */
+static int script_slot(bool is_cluster, HashTable* keys) {
+    zval* key;
+
+    if (!is_cluster) {
+        return 0;
+    }
+    ZEND_HASH_FOREACH_VAL(keys, key) {
+        zend_string* name = zval_get_string(key);
+        int          slot = valkey_glide_key_slot(ZSTR_VAL(name), ZSTR_LEN(name));
+        zend_string_release(name);
+        return slot;
+    }
+    ZEND_HASH_FOREACH_END();
+    return -1;
+}
+
+static bool script_is_loaded(valkey_glide_object* valkey_glide, zend_string* sha1, int slot) {
+    zval* loaded;
+
+    if (!valkey_glide->loaded_scripts || slot < 0) {
+        return false;
+    }
+    loaded = zend_hash_find(valkey_glide->loaded_scripts, sha1);
+    if (!loaded) {
+        return false;
+    }
+    if (Z_TYPE_P(loaded) == IS_STRING) {
+        return (Z_STRVAL_P(loaded)[slot >> 3] >> (slot & 7)) & 1;
+    }
+    return Z_TYPE_P(loaded) == IS_TRUE;
+}
+
+/* Record a reply: a script that ran is loaded where slot routes, a NOSCRIPT means it is not */
+static void script_set_loaded(valkey_glide_object* valkey_glide,
+                              const char*          sha1,
+                              size_t               sha1_len,
+                              bool                 is_cluster,
+                              int                  slot,
+                              bool                 loaded) {
+    HashTable* scripts = valkey_glide->loaded_scripts;
+    zval*      entry;
+
+    if (slot < 0 || (!scripts && !loaded)) {
+        return;
+    }
+    if (!scripts) {
+        ALLOC_HASHTABLE(scripts);
+        zend_hash_init(scripts, 8, NULL, ZVAL_PTR_DTOR, 0);
+        valkey_glide->loaded_scripts = scripts;
+    }
+
+    if (!is_cluster) {
+        if (loaded) {
+            zval value;
+            ZVAL_TRUE(&value);
+            zend_hash_str_update(scripts, sha1, sha1_len, &value);
+        } else {
+            zend_hash_str_del(scripts, sha1, sha1_len);
+        }
+        return;
+    }
+
+    entry = zend_hash_str_find(scripts, sha1, sha1_len);
+    if (!entry || Z_TYPE_P(entry) != IS_STRING) {
+        zval bitmap;
+        if (!loaded) {
+            return;
+        }
+        ZVAL_STR(&bitmap, zend_string_alloc(VALKEY_GLIDE_CLUSTER_SLOTS / 8, 0));
+        memset(Z_STRVAL(bitmap), 0, VALKEY_GLIDE_CLUSTER_SLOTS / 8 + 1);
+        entry = zend_hash_str_update(scripts, sha1, sha1_len, &bitmap);
+    }
+    if (loaded) {
+        Z_STRVAL_P(entry)[slot >> 3] |= (char) (1 << (slot & 7));
+    } else {
+        Z_STRVAL_P(entry)[slot >> 3] &= (char) ~(1 << (slot & 7));
+    }
+}
+
+static bool script_is_noscript(const char* message, size_t len) {
+    return message && len >= sizeof("NOSCRIPT") - 1 &&
+           strncmp(message, "NOSCRIPT", sizeof("NOSCRIPT") - 1) == 0;
+}
+
+/* ====================================================================
+ * EXECUTION
+ * ==================================================================== */
+
+/* State a queued run() needs once its reply is in. A single emalloc'ed block, since
+ * clear_batch_state() releases one that never reached its processor with efree() */
+typedef struct {
+    valkey_glide_object* valkey_glide; /* Client whose batch holds the call */
+    zend_long            decode;       /* VALKEY_GLIDE_SCRIPT_DECODE_* flags */
+    int                  slot;
+    bool                 is_cluster;
+    char                 sha1[41];
+} script_batch_call_t;
+
+static int process_script_run_result(CommandResponse* response, void* output, zval* return_value) {
+    script_batch_call_t* call = output;
+
+    /* Only the reply tells whether the script is loaded: queueing EVAL proves nothing if the
+     * batch is discarded, and a queued EVALSHA may meet a flushed cache */
+    if (response && response->response_type == Error) {
+        if (script_is_noscript(response->string_value, response->string_value_len)) {
+            script_set_loaded(
+                call->valkey_glide, call->sha1, 40, call->is_cluster, call->slot, false);
+        }
+    } else if (response) {
+        script_set_loaded(call->valkey_glide, call->sha1, 40, call->is_cluster, call->slot, true);
+    }
+
+    /* A nil reply is a valid result, not a failure */
+    command_response_to_script_zval(response, return_value, (int) call->decode);
+    efree(call);
+    return 1;
+}
+
+/* Fill in the command and script arguments: EVALSHA sha1, or EVAL with the body */
+static void script_set_command(valkey_glide_script_object* script,
+                               uintptr_t*                  argv,
+                               unsigned long*              argv_len,
+                               bool                        evalsha) {
+    const char*  name = evalsha ? (script->read_only ? "EVALSHA_RO" : "EVALSHA")
+                                : (script->read_only ? "EVAL_RO" : "EVAL");
+    zend_string* body = evalsha ? script->sha1 : script->code;
+
+    argv[0]     = (uintptr_t) name;
+    argv_len[0] = strlen(name);
+    argv[1]     = (uintptr_t) ZSTR_VAL(body);
+    argv_len[1] = ZSTR_LEN(body);
+}
+
+/* {{{ proto ValkeyGlideScript::__construct(string code [, bool read_only]) */
+PHP_METHOD(ValkeyGlideScript, __construct) {
+    zend_string*  code;
+    bool          read_only = false;
+    PHP_SHA1_CTX  context;
+    unsigned char digest[20];
+    char          sha1[41];
+
+    ZEND_PARSE_PARAMETERS_START(1, 2)
+    Z_PARAM_STR(code)
+    Z_PARAM_OPTIONAL
+    Z_PARAM_BOOL(read_only)
+    ZEND_PARSE_PARAMETERS_END();
+
+    PHP_SHA1Init(&context);
+    PHP_SHA1Update(&context, (const unsigned char*) ZSTR_VAL(code), ZSTR_LEN(code));
+    PHP_SHA1Final(digest, &context);
+    make_sha1_digest(sha1, digest);
+
+    valkey_glide_script_object* script = Z_SCRIPT_P(ZEND_THIS);
+    script_release(script);
+
+    script->code      = zend_string_copy(code);
+    script->sha1      = zend_string_init(sha1, 40, 0);
+    script->read_only = read_only;
+}
+/* }}} */
+
+/* {{{ proto string ValkeyGlideScript::sha1() */
+PHP_METHOD(ValkeyGlideScript, sha1) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    valkey_glide_script_object* script = Z_SCRIPT_P(ZEND_THIS);
+    if (!script->sha1) {
+        zend_throw_exception(
+            get_valkey_glide_exception_ce(), "ValkeyGlideScript is not initialized", 0);
+        RETURN_THROWS();
+    }
+    RETURN_STR_COPY(script->sha1);
+}
+/* }}} */
+
+/* {{{ proto mixed ValkeyGlideScript::run(object client [, array keys, array args, int decode]) */
+PHP_METHOD(ValkeyGlideScript, run) {
+    zval*      client;
+    HashTable* keys   = NULL;
+    HashTable* args   = NULL;
+    zend_long  decode = 0;
+
+    ZEND_PARSE_PARAMETERS_START(1, 4)
+    Z_PARAM_OBJECT(client)
+    Z_PARAM_OPTIONAL
+    Z_PARAM_ARRAY_HT(keys)
+    Z_PARAM_ARRAY_HT(args)
+    Z_PARAM_LONG(decode)
+    ZEND_PARSE_PARAMETERS_END();
+
+    bool is_cluster = instanceof_function(Z_OBJCE_P(client), get_valkey_glide_cluster_ce());
+    if (!is_cluster && !instanceof_function(Z_OBJCE_P(client), get_valkey_glide_ce())) {
+        zend_argument_type_error(1, "must be of type ValkeyGlide|ValkeyGlideCluster");
+        RETURN_THROWS();
+    }
+
+    valkey_glide_script_object* script = Z_SCRIPT_P(ZEND_THIS);
+    if (!script->sha1) {
+        zend_throw_exception(
+            get_valkey_glide_exception_ce(), "ValkeyGlideScript is not initialized", 0);
+        RETURN_THROWS();
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, client);
+    if (!valkey_glide->glide_client) {
+        zend_throw_exception(get_valkey_glide_exception_ce(), "Client is not connected", 0);
+        RETURN_THROWS();
+    }
+
+    uint32_t key_count = keys ? zend_hash_num_elements(keys) : 0;
+    uint32_t arg_count = args ? zend_hash_num_elements(args) : 0;
+    uint32_t argc      = 3 + key_count + arg_count;
+    int      slot      = keys ? script_slot(is_cluster, keys) : (is_cluster ? -1 : 0);
+
+    /* EVALSHA sha1 numkeys key... arg..., with the script body swapped in for EVAL */
+    uintptr_t*     argv     = safe_emalloc(argc, sizeof(uintptr_t), 0);
+    unsigned long* argv_len = safe_emalloc(argc, sizeof(unsigned long), 0);
+    zend_string**  strings  = safe_emalloc(key_count + arg_count + 1, sizeof(zend_string*), 0);
+    uint32_t       idx      = 3;
+    char           numkeys[24];
+    zval*          value;
+
+    argv_len[2] = snprintf(numkeys, sizeof(numkeys), "%u", key_count);
+    argv[2]     = (uintptr_t) numkeys;
+
+    HashTable* lists[] = {keys, args};
+    for (size_t i = 0; i < 2; i++) {
+        if (!lists[i]) {
+            continue;
+        }
+        ZEND_HASH_FOREACH_VAL(lists[i], value) {
+            zend_string* str = zval_get_string(value);
+            strings[idx - 3] = str;
+            argv[idx]        = (uintptr_t) ZSTR_VAL(str);
+            argv_len[idx++]  = ZSTR_LEN(str);
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+
+    if (valkey_glide->is_in_batch_mode) {
+        script_batch_call_t* call = emalloc(sizeof(script_batch_call_t));
+
+        call->valkey_glide = valkey_glide;
+        call->decode       = decode;
+        call->slot         = slot;
+        call->is_cluster   = is_cluster;
+        memcpy(call->sha1, ZSTR_VAL(script->sha1), sizeof(call->sha1));
+
+        /* A queued call cannot be retried, so send the body until a reply has shown the script
+         * is loaded where this call goes */
+        script_set_command(
+            script, argv, argv_len, script_is_loaded(valkey_glide, script->sha1, slot));
+        if (buffer_command_for_batch(valkey_glide,
+                                     CustomCommand,
+                                     argv,
+                                     argv_len,
+                                     argc,
+                                     call,
+                                     process_script_run_result,
+                                     batch_result_efree)) {
+            ZVAL_COPY(return_value, client);
+        } else {
+            efree(call);
+            zend_throw_exception(get_valkey_glide_exception_ce(), "Failed to queue the script", 0);
+        }
+    } else {
+        script_set_command(script, argv, argv_len, true);
+        CommandResult* result =
+            execute_command(valkey_glide->glide_client, CustomCommand, argc, argv, argv_len);
+
+        const char* error =
+            result && result->command_error ? result->command_error->command_error_message : NULL;
+        if (error && script_is_noscript(error, strlen(error))) {
+            valkey_glide_free_command_result(result);
+            script_set_loaded(valkey_glide,
+                              ZSTR_VAL(script->sha1),
+                              ZSTR_LEN(script->sha1),
+                              is_cluster,
+                              slot,
+                              false);
+            script_set_command(script, argv, argv_len, false);
+            result =
+                execute_command(valkey_glide->glide_client, CustomCommand, argc, argv, argv_len);
+        }
+
+        if (!result) {
+            zend_throw_exception(
+                get_valkey_glide_exception_ce(), "Script: Failed to execute command", 0);
+        } else if (result->command_error) {
+            zend_throw_exception(get_valkey_glide_exception_ce(),
+                                 result->command_error->command_error_message,
+                                 0);
+        } else {
+            script_set_loaded(valkey_glide,
+                              ZSTR_VAL(script->sha1),
+                              ZSTR_LEN(script->sha1),
+                              is_cluster,
+                              slot,
+                              true);
+            command_response_to_script_zval(result->response, return_value, (int) decode);
+        }
+        if (result) {
+            valkey_glide_free_command_result(result);
+        }
+    }
+
+    for (uint32_t i = 0; i < idx - 3; i++) {
+        zend_string_release(strings[i]);
+    }
+    efree(strings);
+    efree(argv);
+    efree(argv_len);
+}
+/* }}} */
+
+/* ====================================================================
+ * REGISTRATION
+ * ==================================================================== */
+
+void register_script_class(void) {
+    script_ce                = register_class_ValkeyGlideScript();
+    script_ce->create_object = create_script_object;
+
+    memcpy(&script_object_handlers, zend_get_std_object_handlers(), sizeof(script_object_handlers));
+    script_object_handlers.offset    = XtOffsetOf(valkey_glide_script_object, std);
+    script_object_handlers.free_obj  = free_script_object;
+    script_object_handlers.clone_obj = NULL;
+}
@@ -0,0 +1,32 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_SCRIPT_H
+#define VALKEY_GLIDE_SCRIPT_H
+
+#include "common.h"
+#include "php.h"
+
+/* ValkeyGlideScript object structure */
+typedef struct {
+    zend_string* code;      /* Lua source */
+    zend_string* sha1;      /* Lowercase hex SHA1 of code */
+    bool         read_only; /* Run with EVALSHA_RO / EVAL_RO */
+    zend_object  std;       /* MUST be last */
+} valkey_glide_script_object;
+
+/* Register ValkeyGlideScript */
+void register_script_class(void);
+
+#endif /* VALKEY_GLIDE_SCRIPT_H */
@@ -0,0 +1,57 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * A Lua script run with EVALSHA.
+ *
+ * The SHA1 is computed once, when the script is created, so a call only sends the 40 byte hash
+ * instead of the script body. When a server answers NOSCRIPT the script is sent once with EVAL,
+ * which loads it, and the call goes through without the caller noticing.
+ *
+ * Inside multi() or pipeline() a NOSCRIPT reply cannot be retried, so each client remembers
+ * where (for ValkeyGlideCluster, on which hash slots) a reply has shown the script loaded, and
+ * queued calls send EVAL anywhere else. Calls queued before exec() returns still send EVAL, so
+ * run the script once outside the pipeline to queue EVALSHA only. After SCRIPT FLUSH, a queued
+ * EVALSHA can still fail with NOSCRIPT once; that reply makes the next queued call send EVAL.
+ */
+final class ValkeyGlideScript
+{
+    /**
+     * @param string $code      The Lua script.
+     * @param bool   $read_only Run with EVALSHA_RO, which cluster clients may route to replicas.
+     */
+    public function __construct(string $code, bool $read_only = false)
+    {
+    }
+
+    /**
+     * @return string The lowercase hex SHA1 of the script, as SCRIPT LOAD returns it.
+     */
+    public function sha1(): string
+    {
+    }
+
+    /**
+     * Run the script.
+     *
+     * @param ValkeyGlide|ValkeyGlideCluster $client Connected client to run the script on.
+     * @param array $keys   Key names, KEYS in the script.
+     * @param array $args   Other arguments, ARGV in the script.
+     * @param int   $decode ValkeyGlide::SCRIPT_DECODE_* flags, see ValkeyGlide::eval().
+     *
+     * @return mixed The script's reply, or $client when it is in multi() or pipeline().
+     * @throws ValkeyGlideException If the script fails.
+     */
+    public function run(
+        ValkeyGlide|ValkeyGlideCluster $client,
+        array $keys = [],
+        array $args = [],
+        int $decode = 0
+    ): mixed {
+    }
+}
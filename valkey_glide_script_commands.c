@@ -9,7 +9,7 @@
     do {                                                                   \
         if (!(result) || (result)->command_error || !(result)->response) { \
             if (result) {                                                  \
-                free_command_result(result);                               \
+                valkey_glide_free_command_result(result);                               \
             }                                                              \
             RETURN_FALSE;                                                  \
         }                                                                  \
@@ -19,7 +19,7 @@
     do {                                                                   \
         if (!(result) || (result)->command_error || !(result)->response) { \
             if (result) {                                                  \
-                free_command_result(result);                               \
+                valkey_glide_free_command_result(result);                               \
             }                                                              \
             RETURN_NULL();                                                 \
         }                                                                  \
@@ -29,7 +29,7 @@
     do {                                                                         \
         if (!(result) || (result)->command_error) {                              \
             if (result) {                                                        \
-                free_command_result(result);                                     \
+                valkey_glide_free_command_result(result);                                     \
             }                                                                    \
             RETURN_FALSE;                                                        \
         }                                                                        \
@@ -42,13 +42,13 @@ static void handle_script_bool_result(CommandResult* result, zval* return_value)
     if (!result || result->command_error || !result->response) {
         ZVAL_FALSE(return_value);
         if (result) {
-            free_command_result(result);
+            valkey_glide_free_command_result(result);
         }
         return;
     }
 
     process_core_bool_result(result->response, NULL, return_value);
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 }
 #include "zend_exceptions.h"
 
@@ -124,6 +124,7 @@ static void execute_eval_style_command(const char* cmd_name,
                                        zval*       args_array,
                                        zend_long   num_keys,
                                        bool        num_keys_set,
+                                       zend_long   decode,
                                        zval*       object,
                                        zval*       return_value) {
     valkey_glide_object* valkey_glide =
@@ -184,8 +185,12 @@ static void execute_eval_style_command(const char* cmd_name,
 
     VALIDATE_SCRIPT_RESULT_NO_RESPONSE_OR_RETURN_FALSE(result, return_value);
 
-    command_response_to_zval(result->response, return_value, 0, false);
-    free_command_result(result);
+    if (decode) {
+        command_response_to_script_zval(result->response, return_value, (int) decode);
+    } else {
+        command_response_to_zval(result->response, return_value, 0, false);
+    }
+    valkey_glide_free_command_result(result);
 }
 
 // Helper to split PHPRedis-style combined args array into keys and args
@@ -230,8 +235,9 @@ static void execute_eval_generic(const char* command_name,
     size_t    first_param_len;
     zval*     args_array = NULL;
     zend_long num_keys   = 0;
+    zend_long decode     = 0;
 
-    if (argc < 1 || argc > 3) {
+    if (argc < 1 || argc > 4) {
         RETURN_FALSE;
     }
 
@@ -254,6 +260,9 @@ static void execute_eval_generic(const char* command_name,
     if (argc >= 3 && Z_TYPE(params[2]) == IS_LONG) {
         num_keys = Z_LVAL(params[2]);
     }
+    if (argc >= 4 && Z_TYPE(params[3]) == IS_LONG) {
+        decode = Z_LVAL(params[3]);
+    }
 
     // Split args_array into keys and args based on num_keys (PHPRedis compatibility)
     zval  keys_zval, args_zval;
@@ -280,6 +289,7 @@ static void execute_eval_generic(const char* command_name,
                                argv_array,
                                num_keys,
                                true,
+                               decode,
                                object,
                                return_value);
 
@@ -344,7 +354,7 @@ void execute_script_exists_command(zval* object, zval* sha1s, zval* return_value
     VALIDATE_SCRIPT_RESULT_OR_RETURN_FALSE(result, return_value);
 
     command_response_to_zval(result->response, return_value, 0, false);
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 }
 
 // Helper function for script show command
@@ -366,7 +376,7 @@ void execute_script_show_command(
     VALIDATE_SCRIPT_RESULT_OR_RETURN_NULL(result, return_value);
 
     command_response_to_zval(result->response, return_value, 0, false);
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 }
 
 // Helper function for script kill command
@@ -383,5 +393,5 @@ void execute_script_kill_command(zval* object, zval* return_value, bool is_clust
     VALIDATE_SCRIPT_RESULT_NO_RESPONSE_OR_RETURN_FALSE(result, return_value);
 
     command_response_to_zval(result->response, return_value, 0, false);
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 }
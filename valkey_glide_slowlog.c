@@ -0,0 +1,434 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_slowlog.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "common.h"
+#include "logger.h"
+
+#define SLOWLOG_DEFAULT_MAX_LEN 128
+#define SLOWLOG_MAX_LEN 65536
+#define SLOWLOG_NAME_LEN 64
+#define SLOWLOG_KEY_LEN 64
+#define SLOWLOG_ROUTE_LEN 64
+
+typedef struct {
+    zend_long        id;
+    double           timestamp; /* Unix time the command completed */
+    uint64_t         duration_ns;
+    enum RequestType command_type;
+    char             command[SLOWLOG_NAME_LEN]; /* PHP method, as in getLatencyStats() */
+    char             key[SLOWLOG_KEY_LEN];      /* First key, truncated or hashed */
+    size_t           key_shown;                 /* Bytes of key filled in */
+    size_t           key_len;                   /* Length of the untruncated key */
+    int              slot;                      /* Hash slot of the key, -1 without one */
+    unsigned long    argc;
+    uint64_t         payload_bytes;
+    uint64_t         reply_size; /* Bytes of a string reply, elements of an aggregate */
+    char             route[SLOWLOG_ROUTE_LEN];
+} slowlog_entry_t;
+
+ZEND_TLS uint64_t valkey_glide_slowlog_threshold_ns = 0;
+
+ZEND_TLS slowlog_entry_t* slowlog_entries = NULL;
+ZEND_TLS size_t           slowlog_max_len = 0;
+ZEND_TLS size_t           slowlog_count   = 0; /* Entries currently held */
+ZEND_TLS size_t           slowlog_next    = 0; /* Slot the next entry goes to */
+ZEND_TLS zend_long        slowlog_next_id = 0;
+ZEND_TLS bool             slowlog_hash_keys;
+ZEND_TLS bool             slowlog_log;
+
+/* Whether the first argument of command_type is a key. Commands led by something else, such
+ * as a key count (ZUnion, LMPop), an operation (BitOp), a script (Eval, FCall), a pattern
+ * (Keys) or a command name (CustomCommand), are left out */
+static bool slowlog_first_arg_is_key(enum RequestType command_type) {
+    switch (command_type) {
+        /* Strings and bitmaps */
+        case Append:
+        case BitCount:
+        case BitPos:
+        case Decr:
+        case DecrBy:
+        case Get:
+        case GetBit:
+        case GetDel:
+        case GetEx:
+        case GetRange:
+        case GetSet:
+        case Incr:
+        case IncrBy:
+        case IncrByFloat:
+        case MGet:
+        case MSet:
+        case MSetNX:
+        case PSetEx:
+        case Set:
+        case SetBit:
+        case SetEx:
+        case SetNX:
+        case SetRange:
+        case Strlen:
+        /* Generic keyspace */
+        case Copy:
+        case Del:
+        case Dump:
+        case Exists:
+        case Expire:
+        case ExpireAt:
+        case ExpireTime:
+        case Move:
+        case ObjectEncoding:
+        case ObjectFreq:
+        case ObjectIdleTime:
+        case ObjectRefCount:
+        case PExpire:
+        case PExpireAt:
+        case PExpireTime:
+        case PTTL:
+        case Persist:
+        case Rename:
+        case RenameNX:
+        case Restore:
+        case Sort:
+        case SortReadOnly:
+        case TTL:
+        case Touch:
+        case Type:
+        case Unlink:
+        case Watch:
+        /* Hashes */
+        case HDel:
+        case HExists:
+        case HExpire:
+        case HExpireAt:
+        case HExpireTime:
+        case HGet:
+        case HGetAll:
+        case HGetEx:
+        case HIncrBy:
+        case HIncrByFloat:
+        case HKeys:
+        case HLen:
+        case HMGet:
+        case HMSet:
+        case HPExpire:
+        case HPExpireAt:
+        case HPExpireTime:
+        case HPTtl:
+        case HPersist:
+        case HRandField:
+        case HScan:
+        case HSet:
+        case HSetEx:
+        case HSetNX:
+        case HStrlen:
+        case HTtl:
+        case HVals:
+        /* Lists */
+        case BLMove:
+        case BLPop:
+        case BRPop:
+        case BRPopLPush:
+        case LIndex:
+        case LInsert:
+        case LLen:
+        case LMove:
+        case LPop:
+        case LPos:
+        case LPush:
+        case LPushX:
+        case LRange:
+        case LRem:
+        case LSet:
+        case LTrim:
+        case RPop:
+        case RPopLPush:
+        case RPush:
+        case RPushX:
+        /* Sets */
+        case SAdd:
+        case SCard:
+        case SDiff:
+        case SDiffStore:
+        case SInter:
+        case SInterStore:
+        case SIsMember:
+        case SMIsMember:
+        case SMembers:
+        case SMove:
+        case SPop:
+        case SRandMember:
+        case SRem:
+        case SScan:
+        case SUnion:
+        case SUnionStore:
+        /* Sorted sets */
+        case BZPopMax:
+        case BZPopMin:
+        case ZAdd:
+        case ZCard:
+        case ZCount:
+        case ZDiffStore:
+        case ZIncrBy:
+        case ZInterStore:
+        case ZLexCount:
+        case ZMScore:
+        case ZPopMax:
+        case ZPopMin:
+        case ZRandMember:
+        case ZRange:
+        case ZRangeByLex:
+        case ZRangeByScore:
+        case ZRangeStore:
+        case ZRank:
+        case ZRem:
+        case ZRemRangeByLex:
+        case ZRemRangeByRank:
+        case ZRemRangeByScore:
+        case ZRevRange:
+        case ZRevRangeByLex:
+        case ZRevRangeByScore:
+        case ZRevRank:
+        case ZScan:
+        case ZScore:
+        case ZUnionStore:
+        /* Geo and HyperLogLog */
+        case GeoAdd:
+        case GeoDist:
+        case GeoHash:
+        case GeoPos:
+        case GeoSearch:
+        case GeoSearchStore:
+        case PfAdd:
+        case PfCount:
+        case PfMerge:
+        /* Streams */
+        case XAck:
+        case XAdd:
+        case XAutoClaim:
+        case XClaim:
+        case XDel:
+        case XGroupCreate:
+        case XGroupCreateConsumer:
+        case XGroupDelConsumer:
+        case XGroupDestroy:
+        case XGroupSetId:
+        case XInfoConsumers:
+        case XInfoGroups:
+        case XInfoStream:
+        case XLen:
+        case XPending:
+        case XRange:
+        case XRevRange:
+        case XTrim:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void valkey_glide_slowlog_configure(HashTable* config) {
+    zval*     val;
+    zend_long threshold_us = 0;
+    zend_long max_len      = SLOWLOG_DEFAULT_MAX_LEN;
+
+    if ((val = zend_hash_str_find(config, "threshold_us", sizeof("threshold_us") - 1))) {
+        threshold_us = zval_get_long(val);
+    }
+    if ((val = zend_hash_str_find(config, "max_len", sizeof("max_len") - 1))) {
+        max_len = zval_get_long(val);
+    }
+    if (max_len < 1 || max_len > SLOWLOG_MAX_LEN) {
+        VALKEY_LOG_WARN_FMT("slow_log",
+                            "max_len must be between 1 and %d, using %d",
+                            SLOWLOG_MAX_LEN,
+                            SLOWLOG_DEFAULT_MAX_LEN);
+        max_len = SLOWLOG_DEFAULT_MAX_LEN;
+    }
+    val               = zend_hash_str_find(config, "hash_keys", sizeof("hash_keys") - 1);
+    slowlog_hash_keys = val && zend_is_true(val);
+    val               = zend_hash_str_find(config, "log", sizeof("log") - 1);
+    slowlog_log       = val && zend_is_true(val);
+
+    /* Resizing starts over; entries recorded under the old settings would be misleading */
+    if ((size_t) max_len != slowlog_max_len) {
+        slowlog_entry_t* entries = realloc(slowlog_entries, max_len * sizeof(slowlog_entry_t));
+        if (!entries) {
+            VALKEY_LOG_ERROR("slow_log", "Failed to allocate the slow log");
+            return;
+        }
+        slowlog_entries = entries;
+        slowlog_max_len = (size_t) max_len;
+        valkey_glide_slowlog_reset();
+    }
+
+    valkey_glide_slowlog_threshold_ns = threshold_us > 0 ? (uint64_t) threshold_us * 1000 : 0;
+}
+
+void valkey_glide_slowlog_record(enum RequestType     command_type,
+                                 uint64_t             elapsed_ns,
+                                 unsigned long        arg_count,
+                                 const uintptr_t*     args,
+                                 const unsigned long* args_len,
+                                 const CommandResult* result,
+                                 const char*          route) {
+    slowlog_entry_t*     entry;
+    const zend_function* method = valkey_glide_calling_method();
+    struct timeval       tv;
+    unsigned long        i;
+
+    if (!slowlog_entries) {
+        return;
+    }
+
+    entry = &slowlog_entries[slowlog_next];
+    memset(entry, 0, sizeof(*entry));
+    slowlog_next = (slowlog_next + 1) % slowlog_max_len;
+    if (slowlog_count < slowlog_max_len) {
+        slowlog_count++;
+    }
+
+    gettimeofday(&tv, NULL);
+    entry->id           = slowlog_next_id++;
+    entry->timestamp    = (double) tv.tv_sec + (double) tv.tv_usec / 1e6;
+    entry->duration_ns  = elapsed_ns;
+    entry->command_type = command_type;
+    entry->argc         = arg_count;
+    entry->slot         = -1;
+
+    if (method) {
+        valkey_glide_method_label(method, entry->command, SLOWLOG_NAME_LEN);
+    } else {
+        snprintf(entry->command, SLOWLOG_NAME_LEN, "request_%d", (int) command_type);
+    }
+
+    for (i = 0; i < arg_count; i++) {
+        entry->payload_bytes += args_len[i];
+    }
+
+    /* Hash the key when keys are sensitive */
+    if (arg_count > 0 && slowlog_first_arg_is_key(command_type)) {
+        const char* key = (const char*) args[0];
+
+        entry->key_len = args_len[0];
+        entry->slot    = valkey_glide_key_slot(key, args_len[0]);
+        if (slowlog_hash_keys) {
+            entry->key_shown = (size_t) snprintf(entry->key,
+                                                 SLOWLOG_KEY_LEN,
+                                                 "hash:%016" PRIx64,
+                                                 (uint64_t) zend_hash_func(key, args_len[0]));
+        } else {
+            entry->key_shown = MIN(args_len[0], SLOWLOG_KEY_LEN - 1);
+            memcpy(entry->key, key, entry->key_shown);
+        }
+    }
+
+    if (result && result->response) {
+        const CommandResponse* response = result->response;
+        switch (response->response_type) {
+            case String:
+                entry->reply_size = (uint64_t) response->string_value_len;
+                break;
+            case Array:
+            case Map:
+                entry->reply_size = (uint64_t) response->array_value_len;
+                break;
+            case Sets:
+                entry->reply_size = (uint64_t) response->sets_value_len;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (route) {
+        strncpy(entry->route, route, SLOWLOG_ROUTE_LEN - 1);
+    }
+
+    if (slowlog_log) {
+        VALKEY_LOG_WARN_FMT("slow_log",
+                            "%s took %" PRIu64 "us (argc=%lu, payload=%" PRIu64
+                            "B, reply=%" PRIu64 ", slot=%d%s%s)",
+                            entry->command,
+                            elapsed_ns / 1000,
+                            arg_count,
+                            entry->payload_bytes,
+                            entry->reply_size,
+                            entry->slot,
+                            route ? ", route=" : "",
+                            route ? entry->route : "");
+    }
+}
+
+static void slowlog_entry_to_zval(const slowlog_entry_t* entry, zval* out) {
+    array_init_size(out, 12);
+    add_assoc_long(out, "id", entry->id);
+    add_assoc_double(out, "timestamp", entry->timestamp);
+    add_assoc_double(out, "duration_us", (double) entry->duration_ns / 1000.0);
+    add_assoc_string(out, "command", (char*) entry->command);
+    add_assoc_long(out, "request_type", (zend_long) entry->command_type);
+    if (entry->slot >= 0) {
+        add_assoc_stringl(out, "key", (char*) entry->key, entry->key_shown);
+        add_assoc_long(out, "key_len", (zend_long) entry->key_len);
+        add_assoc_long(out, "slot", entry->slot);
+    } else {
+        add_assoc_null(out, "key");
+        add_assoc_long(out, "key_len", 0);
+        add_assoc_null(out, "slot");
+    }
+    add_assoc_long(out, "argc", (zend_long) entry->argc);
+    add_assoc_long(out, "payload_bytes", (zend_long) entry->payload_bytes);
+    add_assoc_long(out, "reply_size", (zend_long) entry->reply_size);
+    if (entry->route[0]) {
+        add_assoc_string(out, "route", (char*) entry->route);
+    } else {
+        add_assoc_null(out, "route");
+    }
+}
+
+void valkey_glide_slowlog_get(zend_long count, zval* return_value) {
+    size_t n = slowlog_count;
+    size_t i;
+
+    if (count >= 0 && (size_t) count < n) {
+        n = (size_t) count;
+    }
+
+    array_init_size(return_value, (uint32_t) n);
+    for (i = 0; i < n; i++) {
+        size_t idx = (slowlog_next + slowlog_max_len - 1 - i) % slowlog_max_len;
+        zval   entry;
+
+        slowlog_entry_to_zval(&slowlog_entries[idx], &entry);
+        add_next_index_zval(return_value, &entry);
+    }
+}
+
+void valkey_glide_slowlog_reset(void) {
+    slowlog_count = 0;
+    slowlog_next  = 0;
+}
+
+void valkey_glide_slowlog_shutdown(void) {
+    free(slowlog_entries);
+    slowlog_entries                   = NULL;
+    slowlog_max_len                   = 0;
+    valkey_glide_slowlog_threshold_ns = 0;
+    valkey_glide_slowlog_reset();
+}
@@ -0,0 +1,67 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_SLOWLOG_H
+#define VALKEY_GLIDE_SLOWLOG_H
+
+#include "include/glide_bindings.h"
+#include "php.h"
+#include "valkey_glide_hrtime.h"
+
+/*
+ * Client-side slow log.
+ *
+ * Commands whose round trip through the core exceeds the threshold configured with
+ * advanced_config ['slow_log' => [...]] are kept in a bounded ring buffer, newest entry
+ * overwriting the oldest, and optionally reported through the glide logger. Like the latency
+ * histograms, the log is process (thread, under ZTS) wide and never locked.
+ */
+
+/* Threshold in nanoseconds, 0 while the slow log is disabled */
+extern ZEND_TLS uint64_t valkey_glide_slowlog_threshold_ns;
+
+/* Apply advanced_config ['slow_log'] (threshold_us, max_len, hash_keys, log) */
+void valkey_glide_slowlog_configure(HashTable* config);
+
+/* Return the time since start if it makes the command slow, 0 otherwise */
+static inline uint64_t valkey_glide_slowlog_check(zend_hrtime_t start) {
+    uint64_t elapsed_ns;
+
+    if (EXPECTED(!valkey_glide_slowlog_threshold_ns)) {
+        return 0;
+    }
+    elapsed_ns = (uint64_t) (zend_hrtime() - start);
+    return elapsed_ns >= valkey_glide_slowlog_threshold_ns ? elapsed_ns : 0;
+}
+
+/* Add a command that took elapsed_ns to the log. route describes an explicit cluster route
+ * (e.g. "allPrimaries" or "host:port") and may be NULL */
+void valkey_glide_slowlog_record(enum RequestType     command_type,
+                                 uint64_t             elapsed_ns,
+                                 unsigned long        arg_count,
+                                 const uintptr_t*     args,
+                                 const unsigned long* args_len,
+                                 const CommandResult* result,
+                                 const char*          route);
+
+/* Fill return_value with up to count entries (all if count < 0), newest first */
+void valkey_glide_slowlog_get(zend_long count, zval* return_value);
+
+/* Drop every entry */
+void valkey_glide_slowlog_reset(void);
+
+/* Release the ring buffer at module shutdown */
+void valkey_glide_slowlog_shutdown(void);
+
+#endif /* VALKEY_GLIDE_SLOWLOG_H */
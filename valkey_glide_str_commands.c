@@ -440,7 +440,7 @@ int execute_sort_command(zval* object, int argc, zval* return_value, zend_class_
         if (valkey_glide->is_in_batch_mode) {
             /* Create batch-compatible processor wrapper */
             int res = buffer_command_for_batch(
-                valkey_glide, Sort, args, args_len, arg_count, NULL, process_sort_result);
+                valkey_glide, Sort, args, args_len, arg_count, NULL, process_sort_result, NULL);
         } else {
             /* Execute the command */
             cmd_result = execute_command(valkey_glide->glide_client,
@@ -468,14 +468,14 @@ int execute_sort_command(zval* object, int argc, zval* return_value, zend_class_
             /* Check if we have a valid result */
             if (!cmd_result || !cmd_result->response) {
                 if (cmd_result)
-                    free_command_result(cmd_result);
+                    valkey_glide_free_command_result(cmd_result);
                 return 0;
             }
 
             /* Check for STORE option */
             ret_val = process_sort_result(cmd_result->response, NULL, return_value);
         }
-        free_command_result(cmd_result);
+        valkey_glide_free_command_result(cmd_result);
         return ret_val;
     }
 
@@ -532,7 +532,7 @@ int execute_sort_ro_command(zval* object, int argc, zval* return_value, zend_cla
         if (valkey_glide->is_in_batch_mode) {
             /* Create batch-compatible processor wrapper */
             int res = buffer_command_for_batch(
-                valkey_glide, Sort, args, args_len, arg_count, NULL, process_sort_result);
+                valkey_glide, Sort, args, args_len, arg_count, NULL, process_sort_result, NULL);
         } else {
             /* Execute the command */
             cmd_result = execute_command(valkey_glide->glide_client,
@@ -558,7 +558,7 @@ int execute_sort_ro_command(zval* object, int argc, zval* return_value, zend_cla
             /* Check if we have a valid result */
             if (!cmd_result || !cmd_result->response) {
                 if (cmd_result)
-                    free_command_result(cmd_result);
+                    valkey_glide_free_command_result(cmd_result);
                 return 0;
             }
 
@@ -566,7 +566,7 @@ int execute_sort_ro_command(zval* object, int argc, zval* return_value, zend_cla
         }
         /* Process the result */
 
-        free_command_result(cmd_result);
+        valkey_glide_free_command_result(cmd_result);
         return ret_val;
     }
 
@@ -0,0 +1,525 @@
+/*
+  +----------------------------------------------------------------------+
+  | ValkeyGlide Stream Consumer                                          |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_stream_consumer.h"
+
+#include <zend_exceptions.h>
+
+#include "command_response.h"
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_stream_consumer_arginfo.h"
+#include "valkey_glide_x_common.h"
+#include "valkey_glide_z_common.h"
+
+/* Global variables */
+static zend_class_entry*    stream_entry_ce;
+static zend_class_entry*    stream_consumer_ce;
+static zend_object_handlers stream_consumer_object_handlers;
+
+/* Declared property slots of ValkeyGlideStreamEntry, in stub order */
+#define STREAM_ENTRY_PROP_ID 0
+#define STREAM_ENTRY_PROP_FIELDS 1
+#define STREAM_ENTRY_PROP_CLAIMED 2
+
+#define STREAM_CONSUMER_DEFAULT_COUNT 10
+
+#define STREAM_CONSUMER_FROM_OBJ(o) \
+    VALKEY_GLIDE_PHP_GET_OBJECT(valkey_glide_stream_consumer_object, o)
+#define Z_STREAM_CONSUMER_P(zv) STREAM_CONSUMER_FROM_OBJ(Z_OBJ_P(zv))
+
+/* ====================================================================
+ * OBJECT LIFECYCLE
+ * ==================================================================== */
+
+static void stream_consumer_release(valkey_glide_stream_consumer_object* consumer) {
+    zval_ptr_dtor(&consumer->client);
+    zval_ptr_dtor(&consumer->pending_acks);
+    ZVAL_UNDEF(&consumer->client);
+    ZVAL_UNDEF(&consumer->pending_acks);
+
+    zend_string** strings[] = {
+        &consumer->stream, &consumer->group, &consumer->consumer, &consumer->claim_cursor};
+    for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++) {
+        if (*strings[i]) {
+            zend_string_release(*strings[i]);
+            *strings[i] = NULL;
+        }
+    }
+}
+
+static zend_object* create_stream_consumer_object(zend_class_entry* ce) {
+    valkey_glide_stream_consumer_object* consumer =
+        zend_object_alloc(sizeof(valkey_glide_stream_consumer_object), ce);
+
+    zend_object_std_init(&consumer->std, ce);
+    object_properties_init(&consumer->std, ce);
+    consumer->std.handlers = &stream_consumer_object_handlers;
+
+    return &consumer->std;
+}
+
+static void free_stream_consumer_object(zend_object* object) {
+    stream_consumer_release(STREAM_CONSUMER_FROM_OBJ(object));
+    zend_object_std_dtor(object);
+}
+
+/* Expose the client so a cycle through it can still be collected */
+static HashTable* stream_consumer_get_gc(zend_object* object, zval** table, int* n) {
+    valkey_glide_stream_consumer_object* consumer = STREAM_CONSUMER_FROM_OBJ(object);
+
+    *table = &consumer->client;
+    *n     = Z_TYPE(consumer->client) == IS_OBJECT ? 1 : 0;
+    return zend_std_get_properties(object);
+}
+
+/* Fetch the client of a constructed consumer, throwing if there is none to use */
+static valkey_glide_object* stream_consumer_client(valkey_glide_stream_consumer_object* consumer) {
+    if (Z_TYPE(consumer->client) != IS_OBJECT) {
+        zend_throw_exception(
+            get_valkey_glide_exception_ce(), "ValkeyGlideStreamConsumer is not initialized", 0);
+        return NULL;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &consumer->client);
+    if (!valkey_glide->glide_client) {
+        zend_throw_exception(get_valkey_glide_exception_ce(), "Client is not connected", 0);
+        return NULL;
+    }
+    return valkey_glide;
+}
+
+/* ====================================================================
+ * REPLY DECODING
+ * ==================================================================== */
+
+/* Build a ValkeyGlideStreamEntry by filling its declared property slots directly */
+static void stream_entry_init(zval*                 out,
+                              CommandResponse*      id,
+                              CommandResponse*      fields,
+                              bool                  claimed,
+                              stream_field_names_t* names) {
+    object_init_ex(out, stream_entry_ce);
+    zend_object* entry = Z_OBJ_P(out);
+
+    ZVAL_STRINGL(OBJ_PROP_NUM(entry, STREAM_ENTRY_PROP_ID), id->string_value, id->string_value_len);
+    command_response_to_stream_fields(
+        fields, OBJ_PROP_NUM(entry, STREAM_ENTRY_PROP_FIELDS), names);
+    ZVAL_BOOL(OBJ_PROP_NUM(entry, STREAM_ENTRY_PROP_CLAIMED), claimed);
+}
+
+/*
+ * Append the entries of one stream to list. The core sends them as an id => fields map;
+ * an [[id, fields], ...] array is accepted as well. Entries deleted while pending have no
+ * fields and are skipped.
+ */
+static void stream_entries_append(CommandResponse* entries, zval* list, bool claimed) {
+    if (!entries) {
+        return;
+    }
+
+    stream_field_names_t names = {{NULL}};
+    for (long i = 0; i < entries->array_value_len; i++) {
+        CommandResponse *id = NULL, *fields = NULL;
+
+        if (entries->response_type == Map) {
+            id     = entries->array_value[i].map_key;
+            fields = entries->array_value[i].map_value;
+        } else if (entries->response_type == Array &&
+                   entries->array_value[i].response_type == Array &&
+                   entries->array_value[i].array_value_len == 2) {
+            id     = &entries->array_value[i].array_value[0];
+            fields = &entries->array_value[i].array_value[1];
+        }
+        if (!id || id->response_type != String || !fields || fields->response_type != Array) {
+            continue;
+        }
+
+        zval entry;
+        stream_entry_init(&entry, id, fields, claimed, &names);
+        add_next_index_zval(list, &entry);
+    }
+    stream_field_names_release(&names);
+}
+
+/* XREADGROUP reply: stream => entries map, or null when BLOCK timed out */
+static int process_stream_consumer_read_result(CommandResponse* response,
+                                               void*            output,
+                                               zval*            return_value) {
+    if (!response) {
+        return 0;
+    }
+
+    array_init(return_value);
+    if (response->response_type == Null) {
+        return 1;
+    }
+    if (response->response_type != Map && response->response_type != Array) {
+        zval_ptr_dtor(return_value);
+        return 0;
+    }
+
+    for (long i = 0; i < response->array_value_len; i++) {
+        CommandResponse* element = &response->array_value[i];
+        if (response->response_type == Map) {
+            stream_entries_append(element->map_value, return_value, false);
+        } else if (element->response_type == Array && element->array_value_len == 2) {
+            stream_entries_append(&element->array_value[1], return_value, false);
+        }
+    }
+    return 1;
+}
+
+/* XAUTOCLAIM reply: [next cursor, entries, deleted ids] decoded to [cursor, entry list] */
+static int process_stream_consumer_claim_result(CommandResponse* response,
+                                                void*            output,
+                                                zval*            return_value) {
+    if (!response || response->response_type != Array || response->array_value_len < 2 ||
+        response->array_value[0].response_type != String) {
+        return 0;
+    }
+
+    zval entries;
+    array_init(&entries);
+    stream_entries_append(&response->array_value[1], &entries, true);
+
+    array_init_size(return_value, 2);
+    add_next_index_stringl(return_value,
+                           response->array_value[0].string_value,
+                           response->array_value[0].string_value_len);
+    add_next_index_zval(return_value, &entries);
+    return 1;
+}
+
+/* ====================================================================
+ * ValkeyGlideStreamConsumer METHODS
+ * ==================================================================== */
+
+/* Read a positive (or, with allow_zero, non-negative) integer option */
+static bool stream_consumer_long_option(HashTable*  options,
+                                        const char* name,
+                                        zend_long*  value,
+                                        bool        allow_zero) {
+    zval* z_value = zend_hash_str_find(options, name, strlen(name));
+    if (!z_value) {
+        return true;
+    }
+
+    *value = zval_get_long(z_value);
+    if (*value < 0 || (*value == 0 && !allow_zero)) {
+        zend_throw_exception_ex(get_valkey_glide_exception_ce(),
+                                0,
+                                "Option '%s' must be %s",
+                                name,
+                                allow_zero ? "zero or greater" : "greater than zero");
+        return false;
+    }
+    return true;
+}
+
+PHP_METHOD(ValkeyGlideStreamConsumer, __construct) {
+    zval*        client;
+    zend_string *stream, *group, *name;
+    HashTable*   options = NULL;
+
+    ZEND_PARSE_PARAMETERS_START(4, 5)
+    Z_PARAM_OBJECT(client)
+    Z_PARAM_STR(stream)
+    Z_PARAM_STR(group)
+    Z_PARAM_STR(name)
+    Z_PARAM_OPTIONAL
+    Z_PARAM_ARRAY_HT(options)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (!instanceof_function(Z_OBJCE_P(client), get_valkey_glide_ce()) &&
+        !instanceof_function(Z_OBJCE_P(client), get_valkey_glide_cluster_ce())) {
+        zend_argument_type_error(1, "must be of type ValkeyGlide|ValkeyGlideCluster");
+        RETURN_THROWS();
+    }
+    if (!ZSTR_LEN(stream) || !ZSTR_LEN(group) || !ZSTR_LEN(name)) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "Stream, group and consumer names must not be empty",
+                             0);
+        RETURN_THROWS();
+    }
+
+    zend_long count = STREAM_CONSUMER_DEFAULT_COUNT, block = -1, claim_idle = 0, claim_count = 0;
+    bool      auto_ack = true;
+    if (options) {
+        if (!stream_consumer_long_option(options, "count", &count, false) ||
+            !stream_consumer_long_option(options, "block", &block, true) ||
+            !stream_consumer_long_option(options, "claim_idle", &claim_idle, true) ||
+            !stream_consumer_long_option(options, "claim_count", &claim_count, false)) {
+            RETURN_THROWS();
+        }
+        zval* z_auto_ack = zend_hash_str_find(options, "auto_ack", sizeof("auto_ack") - 1);
+        if (z_auto_ack) {
+            auto_ack = zend_is_true(z_auto_ack);
+        }
+    }
+
+    valkey_glide_stream_consumer_object* consumer = Z_STREAM_CONSUMER_P(ZEND_THIS);
+    stream_consumer_release(consumer);
+
+    ZVAL_COPY(&consumer->client, client);
+    array_init(&consumer->pending_acks);
+    consumer->stream       = zend_string_copy(stream);
+    consumer->group        = zend_string_copy(group);
+    consumer->consumer     = zend_string_copy(name);
+    consumer->claim_cursor = zend_string_init("0-0", sizeof("0-0") - 1, 0);
+    consumer->count        = count;
+    consumer->block        = block;
+    consumer->claim_idle   = claim_idle;
+    consumer->claim_count  = claim_count ? claim_count : count;
+    consumer->auto_ack     = auto_ack;
+}
+
+PHP_METHOD(ValkeyGlideStreamConsumer, read) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    valkey_glide_stream_consumer_object* consumer     = Z_STREAM_CONSUMER_P(ZEND_THIS);
+    valkey_glide_object*                 valkey_glide = stream_consumer_client(consumer);
+    if (!valkey_glide) {
+        RETURN_THROWS();
+    }
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "Cannot read while the client is in multi() or pipeline()",
+                             0);
+        RETURN_THROWS();
+    }
+
+    /* Queue XACK, XAUTOCLAIM and XREADGROUP on the client's own pipeline */
+    zval ignored;
+    ZVAL_UNDEF(&ignored);
+    int started =
+        execute_pipeline_command(&consumer->client, 0, &ignored, Z_OBJCE(consumer->client));
+    zval_ptr_dtor(&ignored);
+    if (!started) {
+        zend_throw_exception(get_valkey_glide_exception_ce(), "Failed to start the pipeline", 0);
+        RETURN_THROWS();
+    }
+
+    x_command_args_t args = {0};
+    args.glide_client     = valkey_glide->glide_client;
+    args.key              = ZSTR_VAL(consumer->stream);
+    args.key_len          = ZSTR_LEN(consumer->stream);
+    args.group            = ZSTR_VAL(consumer->group);
+    args.group_len        = ZSTR_LEN(consumer->group);
+    args.consumer         = ZSTR_VAL(consumer->consumer);
+    args.consumer_len     = ZSTR_LEN(consumer->consumer);
+
+    int  queued = 1, slot = 0, ack_slot = -1, claim_slot = -1;
+    bool acking = zend_hash_num_elements(Z_ARRVAL(consumer->pending_acks)) > 0;
+
+    if (acking) {
+        args.ids      = &consumer->pending_acks;
+        args.id_count = zend_hash_num_elements(Z_ARRVAL(consumer->pending_acks));
+        queued &= execute_x_generic_command(
+            valkey_glide, XAck, &args, NULL, process_x_int_result, &ignored);
+        ack_slot = slot++;
+        args.ids = NULL;
+    }
+
+    if (consumer->claim_idle > 0) {
+        args.min_idle_time        = consumer->claim_idle;
+        args.start                = ZSTR_VAL(consumer->claim_cursor);
+        args.start_len            = ZSTR_LEN(consumer->claim_cursor);
+        args.claim_opts.has_count = 1;
+        args.claim_opts.count     = consumer->claim_count;
+        queued &= execute_x_generic_command(
+            valkey_glide, XAutoClaim, &args, NULL, process_stream_consumer_claim_result, &ignored);
+        claim_slot = slot++;
+    }
+
+    zval streams, ids;
+    array_init_size(&streams, 1);
+    array_init_size(&ids, 1);
+    add_next_index_str(&streams, zend_string_copy(consumer->stream));
+    add_next_index_stringl(&ids, ">", 1);
+    args.streams             = &streams;
+    args.ids                 = &ids;
+    args.read_opts.has_count = 1;
+    args.read_opts.count     = consumer->count;
+    args.read_opts.has_block = consumer->block >= 0;
+    args.read_opts.block     = consumer->block;
+    queued &= execute_x_generic_command(
+        valkey_glide, XReadGroup, &args, NULL, process_stream_consumer_read_result, &ignored);
+    int read_slot = slot;
+    zval_ptr_dtor(&streams);
+    zval_ptr_dtor(&ids);
+
+    if (!queued) {
+        clear_batch_state(valkey_glide);
+        zend_throw_exception(
+            get_valkey_glide_exception_ce(), "Failed to queue stream consumer commands", 0);
+        RETURN_THROWS();
+    }
+
+    zval replies;
+    ZVAL_UNDEF(&replies);
+    if (!execute_exec_command(&consumer->client, 0, &replies, Z_OBJCE(consumer->client)) ||
+        Z_TYPE(replies) != IS_ARRAY) {
+        zval_ptr_dtor(&replies);
+        if (!EG(exception)) {
+            zend_throw_exception(
+                get_valkey_glide_exception_ce(), "Stream consumer pipeline failed", 0);
+        }
+        RETURN_THROWS();
+    }
+
+    zval* read_reply = zend_hash_index_find(Z_ARRVAL(replies), read_slot);
+    if (!read_reply || Z_TYPE_P(read_reply) != IS_ARRAY) {
+        zval_ptr_dtor(&replies);
+        zend_throw_exception(get_valkey_glide_exception_ce(), "XREADGROUP failed", 0);
+        RETURN_THROWS();
+    }
+
+    /* Claimed entries first, then new ones */
+    zval* claim_reply = claim_slot >= 0 ? zend_hash_index_find(Z_ARRVAL(replies), claim_slot)
+                                        : NULL;
+    zval* claimed     = NULL;
+    if (claim_reply && Z_TYPE_P(claim_reply) == IS_ARRAY) {
+        zval* cursor = zend_hash_index_find(Z_ARRVAL_P(claim_reply), 0);
+        claimed      = zend_hash_index_find(Z_ARRVAL_P(claim_reply), 1);
+        if (cursor && Z_TYPE_P(cursor) == IS_STRING) {
+            zend_string_release(consumer->claim_cursor);
+            consumer->claim_cursor = zend_string_copy(Z_STR_P(cursor));
+        }
+    }
+
+    uint32_t total = zend_hash_num_elements(Z_ARRVAL_P(read_reply)) +
+                     (claimed ? zend_hash_num_elements(Z_ARRVAL_P(claimed)) : 0);
+    array_init_size(return_value, total);
+    zval* entry;
+    if (claimed) {
+        ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(claimed), entry) {
+            Z_ADDREF_P(entry);
+            add_next_index_zval(return_value, entry);
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(read_reply), entry) {
+        Z_ADDREF_P(entry);
+        add_next_index_zval(return_value, entry);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    /* Keep the queued IDs if XACK did not go through, so the next read retries them */
+    zval* ack_reply = ack_slot >= 0 ? zend_hash_index_find(Z_ARRVAL(replies), ack_slot) : NULL;
+    if (acking && ack_reply && Z_TYPE_P(ack_reply) == IS_LONG) {
+        zend_hash_clean(Z_ARRVAL(consumer->pending_acks));
+    }
+    if (consumer->auto_ack) {
+        ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(return_value), entry) {
+            zval* id = OBJ_PROP_NUM(Z_OBJ_P(entry), STREAM_ENTRY_PROP_ID);
+            Z_ADDREF_P(id);
+            add_next_index_zval(&consumer->pending_acks, id);
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+
+    zval_ptr_dtor(&replies);
+}
+
+PHP_METHOD(ValkeyGlideStreamConsumer, ack) {
+    zval*    ids   = NULL;
+    uint32_t count = 0;
+
+    ZEND_PARSE_PARAMETERS_START(0, -1)
+    Z_PARAM_VARIADIC('*', ids, count)
+    ZEND_PARSE_PARAMETERS_END();
+
+    valkey_glide_stream_consumer_object* consumer = Z_STREAM_CONSUMER_P(ZEND_THIS);
+    if (!stream_consumer_client(consumer)) {
+        RETURN_THROWS();
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        add_next_index_str(&consumer->pending_acks, zval_get_string(&ids[i]));
+    }
+    RETURN_LONG(zend_hash_num_elements(Z_ARRVAL(consumer->pending_acks)));
+}
+
+PHP_METHOD(ValkeyGlideStreamConsumer, flush) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    valkey_glide_stream_consumer_object* consumer     = Z_STREAM_CONSUMER_P(ZEND_THIS);
+    valkey_glide_object*                 valkey_glide = stream_consumer_client(consumer);
+    if (!valkey_glide) {
+        RETURN_THROWS();
+    }
+
+    uint32_t pending = zend_hash_num_elements(Z_ARRVAL(consumer->pending_acks));
+    if (pending == 0) {
+        RETURN_LONG(0);
+    }
+    if (valkey_glide->is_in_batch_mode) {
+        zend_throw_exception(get_valkey_glide_exception_ce(),
+                             "Cannot flush while the client is in multi() or pipeline()",
+                             0);
+        RETURN_THROWS();
+    }
+
+    x_command_args_t args = {0};
+    args.glide_client     = valkey_glide->glide_client;
+    args.key              = ZSTR_VAL(consumer->stream);
+    args.key_len          = ZSTR_LEN(consumer->stream);
+    args.group            = ZSTR_VAL(consumer->group);
+    args.group_len        = ZSTR_LEN(consumer->group);
+    args.ids              = &consumer->pending_acks;
+    args.id_count         = pending;
+
+    if (!execute_x_generic_command(
+            valkey_glide, XAck, &args, NULL, process_x_int_result, return_value)) {
+        if (!EG(exception)) {
+            zend_throw_exception(get_valkey_glide_exception_ce(), "XACK failed", 0);
+        }
+        RETURN_THROWS();
+    }
+    zend_hash_clean(Z_ARRVAL(consumer->pending_acks));
+}
+
+PHP_METHOD(ValkeyGlideStreamConsumer, getPendingAcks) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    valkey_glide_stream_consumer_object* consumer = Z_STREAM_CONSUMER_P(ZEND_THIS);
+    if (Z_TYPE(consumer->pending_acks) != IS_ARRAY) {
+        RETURN_EMPTY_ARRAY();
+    }
+    RETURN_COPY(&consumer->pending_acks);
+}
+
+/* ====================================================================
+ * REGISTRATION
+ * ==================================================================== */
+
+void register_stream_consumer_classes(void) {
+    stream_entry_ce = register_class_ValkeyGlideStreamEntry();
+
+    stream_consumer_ce                = register_class_ValkeyGlideStreamConsumer();
+    stream_consumer_ce->create_object = create_stream_consumer_object;
+
+    memcpy(&stream_consumer_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(stream_consumer_object_handlers));
+    stream_consumer_object_handlers.offset =
+        XtOffsetOf(valkey_glide_stream_consumer_object, std);
+    stream_consumer_object_handlers.free_obj  = free_stream_consumer_object;
+    stream_consumer_object_handlers.get_gc    = stream_consumer_get_gc;
+    stream_consumer_object_handlers.clone_obj = NULL;
+}
+
+zend_class_entry* get_stream_entry_ce(void) {
+    return stream_entry_ce;
+}
@@ -0,0 +1,43 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_STREAM_CONSUMER_H
+#define VALKEY_GLIDE_STREAM_CONSUMER_H
+
+#include "common.h"
+#include "php.h"
+
+/* ValkeyGlideStreamConsumer object structure */
+typedef struct {
+    zval         client;       /* ValkeyGlide or ValkeyGlideCluster the consumer reads through */
+    zend_string* stream;       /* Stream key */
+    zend_string* group;        /* Consumer group */
+    zend_string* consumer;     /* Consumer name */
+    zend_string* claim_cursor; /* Where the next XAUTOCLAIM resumes, "0-0" to start over */
+    zval         pending_acks; /* IDs acknowledged by the next read() or flush() */
+    zend_long    count;        /* XREADGROUP COUNT */
+    zend_long    block;        /* XREADGROUP BLOCK in milliseconds, -1 for none */
+    zend_long    claim_idle;   /* XAUTOCLAIM min-idle-time, 0 when claiming is disabled */
+    zend_long    claim_count;  /* XAUTOCLAIM COUNT */
+    bool         auto_ack;     /* Queue each read's IDs for acknowledgement */
+    zend_object  std;          /* MUST be last */
+} valkey_glide_stream_consumer_object;
+
+/* Register ValkeyGlideStreamEntry and ValkeyGlideStreamConsumer */
+void register_stream_consumer_classes(void);
+
+/* Getter function for the entry class */
+zend_class_entry* get_stream_entry_ce(void);
+
+#endif /* VALKEY_GLIDE_STREAM_CONSUMER_H */
@@ -0,0 +1,104 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * One stream entry delivered by ValkeyGlideStreamConsumer::read().
+ *
+ * @strict-properties
+ */
+final class ValkeyGlideStreamEntry
+{
+    /**
+     * The entry ID, e.g. "1700000000000-0".
+     */
+    public readonly string $id;
+
+    /**
+     * The entry's field => value pairs.
+     */
+    public readonly array $fields;
+
+    /**
+     * True if the entry was taken over from another consumer with XAUTOCLAIM.
+     */
+    public readonly bool $claimed;
+}
+
+/**
+ * Consumer group reader for a single stream.
+ *
+ * Each read() sends one pipeline: XACK for the IDs queued since the previous read,
+ * optionally XAUTOCLAIM for entries other consumers left idle in the pending entries list,
+ * and XREADGROUP for new entries. A consume loop therefore costs one round-trip per batch
+ * instead of two, and entries come back as ValkeyGlideStreamEntry objects.
+ */
+final class ValkeyGlideStreamConsumer
+{
+    /**
+     * @param ValkeyGlide|ValkeyGlideCluster $client Connected client to read through.
+     * @param string $stream Stream key.
+     * @param string $group Consumer group, which must already exist.
+     * @param string $consumer Consumer name within the group.
+     * @param array $options Supported options:
+     *   - 'count' => int: Maximum entries per XREADGROUP (default 10).
+     *   - 'block' => int: Milliseconds XREADGROUP waits for new entries (default: no BLOCK).
+     *   - 'claim_idle' => int: Claim entries pending for at least this many milliseconds
+     *     with XAUTOCLAIM (default 0, disabled).
+     *   - 'claim_count' => int: Maximum entries claimed per read (default: 'count').
+     *   - 'auto_ack' => bool: Acknowledge the entries of each read with the next one
+     *     (default true). When false, queue IDs with ack().
+     */
+    public function __construct(
+        ValkeyGlide|ValkeyGlideCluster $client,
+        string $stream,
+        string $group,
+        string $consumer,
+        array $options = []
+    ) {
+    }
+
+    /**
+     * Acknowledge queued IDs, claim idle entries and read new ones in one round-trip.
+     *
+     * Claimed entries come first. With 'auto_ack' the returned IDs are queued for the next
+     * read() or flush().
+     *
+     * @return ValkeyGlideStreamEntry[]
+     * @throws ValkeyGlideException If the pipeline fails or XREADGROUP returns an error.
+     */
+    public function read(): array
+    {
+    }
+
+    /**
+     * Queue entry IDs to be acknowledged with the next read() or flush().
+     *
+     * @param string ...$ids Entry IDs.
+     * @return int Number of IDs now queued.
+     */
+    public function ack(string ...$ids): int
+    {
+    }
+
+    /**
+     * Acknowledge the queued IDs now, e.g. before stopping the consumer.
+     *
+     * @return int Number of entries the server acknowledged.
+     * @throws ValkeyGlideException If XACK fails.
+     */
+    public function flush(): int
+    {
+    }
+
+    /**
+     * @return string[] IDs queued for acknowledgement.
+     */
+    public function getPendingAcks(): array
+    {
+    }
+}
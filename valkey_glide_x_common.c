@@ -443,8 +443,14 @@ int execute_x_generic_command(valkey_glide_object* valkey_glide,
     }
 
     if (valkey_glide->is_in_batch_mode) {
-        int result = buffer_command_for_batch(
-            valkey_glide, cmd_type, cmd_args, args_len, arg_count, result_ptr, process_result);
+        int result = buffer_command_for_batch(valkey_glide,
+                                              cmd_type,
+                                              cmd_args,
+                                              args_len,
+                                              arg_count,
+                                              result_ptr,
+                                              process_result,
+                                              NULL);
 
         if (cmd_args)
             efree(cmd_args);
@@ -487,15 +493,15 @@ int execute_x_generic_command(valkey_glide_object* valkey_glide,
 
     /* Check if there was an error */
     if (result->command_error) {
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
         return 0;
     }
 
     /* Process the result */
-    int success = process_result(result->response, result_ptr, return_value);
+    int success = valkey_glide_async_decode(result, process_result, result_ptr, return_value);
 
     /* Free the result */
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 
     return success;
 }
@@ -593,18 +599,15 @@ int process_x_readgroup_result(CommandResponse* response, void* output, zval* re
 
             if (element->map_key && element->map_key->response_type == String &&
                 element->map_value) {
-                /* Extract stream name */
-                zval stream_name;
-                command_response_to_zval(
-                    element->map_key, &stream_name, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
-
                 /* Process stream entries */
                 zval stream_entries;
                 command_response_to_stream_zval(element->map_value, &stream_entries);
 
-                /* Add stream entries to output as an associative array */
-                add_assoc_zval(return_value, Z_STRVAL(stream_name), &stream_entries);
-                zval_dtor(&stream_name);  // Clean up stream name after adding
+                /* Key them by stream name, which may contain any bytes */
+                zend_symtable_str_update(Z_ARRVAL_P(return_value),
+                                         element->map_key->string_value,
+                                         element->map_key->string_value_len,
+                                         &stream_entries);
                 status = 1;
             }
         }
@@ -213,8 +213,12 @@ int execute_zmscore_command(zval* object, int argc, zval* return_value, zend_cla
     args.member_count     = member_count;
 
 
-    int result = execute_z_generic_command(
-        valkey_glide, ZMScore, &args, NULL, process_z_array_result, return_value);
+    z_result_processor_t processor = valkey_glide->opt_packed_numerics
+                                         ? process_z_float64_column_result
+                                         : process_z_array_result;
+
+    int result =
+        execute_z_generic_command(valkey_glide, ZMScore, &args, NULL, processor, return_value);
 
     if (valkey_glide->is_in_batch_mode) {
         /* In batch mode, return $this for method chaining */
@@ -1684,7 +1688,7 @@ int execute_zmpop_command_internal(valkey_glide_object* valkey_glide,
     if (valkey_glide->is_in_batch_mode) {
         /* Create batch-compatible processor wrapper */
         int res = buffer_command_for_batch(
-            valkey_glide, cmd_type, args, args_len, arg_count, NULL, process_zmpop_result);
+            valkey_glide, cmd_type, args, args_len, arg_count, NULL, process_zmpop_result, NULL);
     } else {
         /* Execute the command */
         cmd_result = command(valkey_glide->glide_client,
@@ -1721,14 +1725,14 @@ int execute_zmpop_command_internal(valkey_glide_object* valkey_glide,
 
         /* Check if there was an error */
         if (cmd_result->command_error) {
-            free_command_result(cmd_result);
+            valkey_glide_free_command_result(cmd_result);
             return 0;
         }
 
         ret_val = process_zmpop_result(cmd_result->response, NULL, return_value);
 
         /* Free the result */
-        free_command_result(cmd_result);
+        valkey_glide_free_command_result(cmd_result);
     }
 
     return ret_val;
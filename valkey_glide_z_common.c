@@ -305,43 +305,66 @@ int create_limit_args(range_options_t* opts,
 
 
 /**
- * Flatten withscores array from [[member, score]] to [member => score]
- * Returns 1 on success, 0 on failure
+ * Add one member => score pair. Members are inserted with their length so binary members
+ * survive; zend_symtable_str_update keeps PHP's numeric-string key semantics.
  */
-int flatten_withscores_array(zval* return_value) {
-    if (!return_value || Z_TYPE_P(return_value) != IS_ARRAY) {
-        return 0;
+static void z_add_member_score(HashTable*             ht,
+                               const CommandResponse* member,
+                               const CommandResponse* score) {
+    zval z_score;
+    if (!member || !score || !command_response_to_double(score, &Z_DVAL(z_score))) {
+        return;
     }
+    Z_TYPE_INFO(z_score) = IS_DOUBLE;
 
-    HashTable* ht = Z_ARRVAL_P(return_value);
-    zval       tmp_arr;
-    array_init(&tmp_arr);
+    if (member->response_type == String) {
+        zend_symtable_str_update(ht, member->string_value, member->string_value_len, &z_score);
+    } else if (member->response_type == Int) {
+        zend_hash_index_update(ht, member->int_value, &z_score);
+    }
+}
 
-    zval* entry;
-    ZEND_HASH_FOREACH_VAL(ht, entry) {
-        if (Z_TYPE_P(entry) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_P(entry)) == 2) {
-            zval* z_member = zend_hash_index_find(Z_ARRVAL_P(entry), 0);
-            zval* z_score  = zend_hash_index_find(Z_ARRVAL_P(entry), 1);
+/**
+ * Decode a WITHSCORES reply straight into a [member => (float)score] array in one pass.
+ * Accepts the map the core returns for ZRANGE/ZPOP/ZUNION-style replies, an array of
+ * [member, score] pairs (ZRANDMEMBER) and a flat member, score, ... array (RESP2).
+ * Returns 1 on success, 0 if the reply has none of these shapes.
+ */
+int z_withscores_response_to_zval(CommandResponse* response, zval* output) {
+    if (!response || !output) {
+        return 0;
+    }
 
-            if (z_member && z_score) {
-                /* Convert member to string if needed for use as key */
-                if (Z_TYPE_P(z_member) != IS_STRING) {
-                    convert_to_string_ex(z_member);
-                }
+    if (response->response_type == Map) {
+        array_init_size(output, (uint32_t) response->array_value_len);
+        for (long i = 0; i < response->array_value_len; i++) {
+            CommandResponse* element = &response->array_value[i];
+            z_add_member_score(Z_ARRVAL_P(output), element->map_key, element->map_value);
+        }
+        return 1;
+    }
 
-                /* Add to associative array: member => score */
-                Z_TRY_ADDREF_P(z_score);
+    if (response->response_type != Array) {
+        return 0;
+    }
 
-                add_assoc_zval(&tmp_arr, Z_STRVAL_P(z_member), z_score);
+    if (response->array_value_len > 0 && response->array_value[0].response_type == Array) {
+        array_init_size(output, (uint32_t) response->array_value_len);
+        for (long i = 0; i < response->array_value_len; i++) {
+            CommandResponse* pair = &response->array_value[i];
+            if (pair->response_type == Array && pair->array_value_len == 2) {
+                z_add_member_score(
+                    Z_ARRVAL_P(output), &pair->array_value[0], &pair->array_value[1]);
             }
         }
+        return 1;
     }
-    ZEND_HASH_FOREACH_END();
-
-    /* Replace the original array with our flattened array */
-    zval_ptr_dtor(return_value);
-    ZVAL_COPY_VALUE(return_value, &tmp_arr);
 
+    array_init_size(output, (uint32_t) (response->array_value_len / 2));
+    for (long i = 0; i + 1 < response->array_value_len; i += 2) {
+        z_add_member_score(
+            Z_ARRVAL_P(output), &response->array_value[i], &response->array_value[i + 1]);
+    }
     return 1;
 }
 
@@ -569,7 +592,8 @@ int execute_z_generic_command(valkey_glide_object* valkey_glide,
                                               arg_count,
 
                                               result_ptr,
-                                              process_result);
+                                              process_result,
+                                              NULL);
 
         if (arg_values)
             efree(arg_values);
@@ -611,15 +635,15 @@ int execute_z_generic_command(valkey_glide_object* valkey_glide,
 
     /* Check if there was an error */
     if (result->command_error) {
-        free_command_result(result);
+        valkey_glide_free_command_result(result);
         return 0;
     }
 
     /* Process the result */
-    int success = process_result(result->response, result_ptr, return_value);
+    int success = valkey_glide_async_decode(result, process_result, result_ptr, return_value);
 
     /* Free the result */
-    free_command_result(result);
+    valkey_glide_free_command_result(result);
 
     return success;
 }
@@ -1802,9 +1826,15 @@ int process_z_array_zrand_result(CommandResponse* response, void* output, zval*
         return 0;
     }
 
-    /* Process the result */
+    int success;
+    if (array_data->withscores &&
+        (response->response_type == Array || response->response_type == Map)) {
+        success = z_withscores_response_to_zval(response, return_value);
+        efree(output);
+        return success;
+    }
 
-    int success =
+    success =
         command_response_to_zval(response, return_value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
 
     if (Z_TYPE_P(return_value) == IS_STRING) {
@@ -1818,10 +1848,6 @@ int process_z_array_zrand_result(CommandResponse* response, void* output, zval*
         add_next_index_str(return_value, str);
     }
 
-    if (array_data->withscores && success && Z_TYPE_P(return_value) == IS_ARRAY) {
-        /* Use common helper to flatten withscores array */
-        flatten_withscores_array(return_value);
-    }
     efree(output);
     return success;
 }
@@ -1834,11 +1860,23 @@ int process_z_array_result(CommandResponse* response, void* output, zval* return
         return 0;
     }
 
-    /* Process the result */
-    int success = command_response_to_zval(
+    /* The core answers WITHSCORES requests with a member => score map */
+    if (response->response_type == Map) {
+        return z_withscores_response_to_zval(response, return_value);
+    }
+
+    return command_response_to_zval(
         response, return_value, COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP, true);
+}
 
-    return success;
+/**
+ * Process a score array as a packed float64 column (OPT_PACKED_NUMERICS)
+ */
+int process_z_float64_column_result(CommandResponse* response, void* output, zval* return_value) {
+    if (!response || !return_value) {
+        return 0;
+    }
+    return command_response_to_float64_column(response, return_value, 1);
 }
 
 /**
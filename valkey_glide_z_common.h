@@ -145,6 +145,11 @@ int process_z_array_result(CommandResponse* response, void* output, zval* return
 
 int process_z_array_zrand_result(CommandResponse* response, void* output, zval* return_value);
 
+/**
+ * Process score array result as a packed float64 string (OPT_PACKED_NUMERICS)
+ */
+int process_z_float64_column_result(CommandResponse* response, void* output, zval* return_value);
+
 int process_z_long_to_zval_result(CommandResponse* response, void* output, zval* return_value);
 
 /**
@@ -322,10 +327,10 @@ int create_limit_args(range_options_t* opts,
  * ==================================================================== */
 
 /**
- * Flatten withscores array from [[member, score]] to [member => score]
- * Returns 1 on success, 0 on failure
+ * Decode a WITHSCORES reply (map, [member, score] pairs or flat RESP2 array) directly into
+ * a binary-safe [member => (float)score] array. Returns 1 on success, 0 on failure
  */
-int flatten_withscores_array(zval* return_value);
+int z_withscores_response_to_zval(CommandResponse* response, zval* output);
 
 int prepare_mpop_arguments(const void*     glide_client,
                            int             is_blocking,
@@ -411,7 +416,10 @@ int buffer_command_for_batch(valkey_glide_object* valkey_glide,
                              const unsigned long* args_len,
                              uintptr_t            arg_count,
                              void*                result_ptr,
-                             z_result_processor_t process_result);
+                             z_result_processor_t process_result,
+                             z_result_cleanup_t   free_result);
+void batch_result_efree(void* result_ptr);
+void clear_batch_state(valkey_glide_object* valkey_glide);
 /**
  * Initialize array return value and check for allocation success
  */
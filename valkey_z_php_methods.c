@@ -212,6 +212,10 @@ GEOSEARCH_METHOD_IMPL(ValkeyGlide)
 GEOSEARCHSTORE_METHOD_IMPL(ValkeyGlide)
 /* }}} */
 
+/* {{{ proto array ValkeyGlide::geosearchMerge(array results [, int count, bool desc]) */
+GEOSEARCHMERGE_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
 /* {{{ proto long ValkeyGlide::xack(string key, string group, array ids) */
 XACK_METHOD_IMPL(ValkeyGlide)
 /* }}} */
@@ -687,6 +691,22 @@ DISCARD_METHOD_IMPL(ValkeyGlide)
 EXEC_METHOD_IMPL(ValkeyGlide)
 /* }}} */
 
+/* {{{ proto array ValkeyGlide::bulkLoad(iterable rows [, array spec]) */
+BULK_LOAD_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto array ValkeyGlide::migrateKeys(object dst, iterable keys [, array opts]) */
+MIGRATE_KEYS_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto ValkeyGlideHashChunks ValkeyGlide::hGetAllChunked(string key [, int chunk]) */
+HGETALL_CHUNKED_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto ValkeyGlideFunction ValkeyGlide::prepareFunction(string lib, string name) */
+PREPARE_FUNCTION_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
 /* {{{ proto string ValkeyGlide::dump(string key) */
 DUMP_METHOD_IMPL(ValkeyGlide)
 /* }}} */